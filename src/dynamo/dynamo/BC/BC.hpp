@@ -29,6 +29,8 @@ namespace dynamo
   class IntEvent;
   class Simulation;
   class Particle;
+  class CheckpointWriter;
+  class CheckpointReader;
 
   /*! \brief The base class for the Boundary Conditions of the simulation.
    
@@ -93,6 +95,19 @@ namespace dynamo
     /*! \brief Stream the boundary conditions forward in time.*/
     virtual void update(const double&) {};
 
+    //! \brief Writes any run-time state of the boundary condition to a checkpoint (see Simulation::writeCheckpoint).
+    virtual void saveCheckpoint(CheckpointWriter&) const {}
+
+    //! \brief Restores the state written by saveCheckpoint.
+    virtual void loadCheckpoint(CheckpointReader&) {}
+
+    /*! \brief False if the boundary conditions move independently
+      of the particles, so that rescaling the particle velocities does
+      not simply rescale the event times (see
+      Dynamics::timeScaleInvariant).
+     */
+    virtual bool timeScaleInvariant() const { return true; }
+
     /*! \brief Load the Boundary condition from an XML file. */
     virtual void operator<<(const magnet::xml::Node&) = 0;
 
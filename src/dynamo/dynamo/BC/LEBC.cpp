@@ -114,6 +114,18 @@ namespace dynamo {
     _dxd -= floor(_dxd/Sim->primaryCellSize[0])*Sim->primaryCellSize[0];
   }
 
+  void
+  BCLeesEdwards::saveCheckpoint(CheckpointWriter& out) const
+  {
+    out.write(_dxd);
+  }
+
+  void
+  BCLeesEdwards::loadCheckpoint(CheckpointReader& in)
+  {
+    in.read(_dxd);
+  }
+
   Vector
   BCLeesEdwards::getStreamVelocity(const Particle& part) const
   { return Vector(part.getPosition()[1] * _shearRate, 0, 0); }
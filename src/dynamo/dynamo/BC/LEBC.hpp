@@ -50,6 +50,11 @@ namespace dynamo {
 
     virtual void update(const double&);
 
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+    virtual void loadCheckpoint(CheckpointReader&);
+
+    virtual bool timeScaleInvariant() const { return false; }
+
     /*! \brief Returns the shear rate of the boundaries. */
     inline double getShearRate() const { return _shearRate; }
 
@@ -0,0 +1,196 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/exception.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+namespace dynamo {
+  /*! \brief The header at the start of a binary configuration file.
+
+    A binary configuration (a file ending in ".dynbin") holds the same
+    data as an XML configuration file, but is laid out so that it can
+    be memory mapped and loaded without parsing the particle data:
+
+    - This 64 byte header.
+    - The XML configuration, with an empty ParticleData tag (marked
+      with Format="Binary"), padded to a multiple of 64 bytes.
+    - The particle data as raw little-endian arrays, each padded to a
+      multiple of 64 bytes and in the order of the particle IDs. These
+      are the positions and velocities (3 doubles per particle), the
+      particle states (a uint32_t per particle), the orientations (4
+      doubles, real part first) and angular velocities (3 doubles) if
+      the OrientationData flag is set, and finally one column of
+      doubles for each ParticleProperty, in the order of the
+      Properties tag.
+  */
+  struct BinaryConfigHeader
+  {
+    enum { ORIENTATION_DATA = 0x1 };
+
+    //! \brief Identifies the file type, always "DYNAMOB" followed by a null.
+    char magic[8];
+    //! \brief The version of the binary layout (see binaryConfigVersion).
+    uint32_t version;
+    //! \brief The value 0x01020304, used to detect the byte order.
+    uint32_t byteOrder;
+    //! \brief The length of the XML data (excluding padding).
+    uint64_t xmlSize;
+    //! \brief The number of particles.
+    uint64_t N;
+    //! \brief The number of ParticleProperty columns.
+    uint32_t columns;
+    //! \brief A combination of the flags in the enum above.
+    uint32_t flags;
+    uint64_t reserved[3];
+  };
+
+  static_assert(sizeof(BinaryConfigHeader) == 64, "The binary configuration header must be exactly 64 bytes");
+
+  //! \brief The current version of the binary configuration layout.
+  static const uint32_t binaryConfigVersion = 1;
+
+  //! \brief Test if a file name is for a binary configuration file.
+  inline bool isBinaryConfigFile(const std::string& fileName)
+  {
+    static const std::string extension(".dynbin");
+    return (fileName.size() >= extension.size())
+      && (fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0);
+  }
+
+  namespace detail {
+    inline bool littleEndianHost()
+    {
+      const uint32_t test = 1;
+      return *reinterpret_cast<const unsigned char*>(&test) == 1;
+    }
+
+    //! \brief The number of bytes needed to pad a block to a multiple of 64 bytes.
+    inline size_t binaryConfigPadding(size_t bytes) { return (64 - bytes % 64) % 64; }
+  }
+
+  /*! \brief Writes a binary configuration file, block by block.
+
+    The header and XML are written on construction, the particle
+    arrays must then be written using writeArray in the order given in
+    \ref BinaryConfigHeader.
+  */
+  class BinaryConfigWriter
+  {
+  public:
+    BinaryConfigWriter(std::ostream& out, const std::string& xml, size_t N, size_t columns, bool orientationData):
+      _out(out)
+    {
+      if (!detail::littleEndianHost())
+	M_throw() << "Binary configuration files can only be written on little-endian machines";
+
+      BinaryConfigHeader header;
+      std::memset(&header, 0, sizeof(header));
+      std::memcpy(header.magic, "DYNAMOB", 8);
+      header.version = binaryConfigVersion;
+      header.byteOrder = 0x01020304;
+      header.xmlSize = xml.size();
+      header.N = N;
+      header.columns = columns;
+      header.flags = orientationData ? BinaryConfigHeader::ORIENTATION_DATA : 0;
+
+      _out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      writeBlock(xml.data(), xml.size());
+    }
+
+    //! \brief Write an array of values as the next block of the file.
+    template<class T>
+    void writeArray(const std::vector<T>& data)
+    { writeBlock(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T)); }
+
+  private:
+    void writeBlock(const char* data, size_t bytes)
+    {
+      static const char zeros[64] = {0};
+      _out.write(data, bytes);
+      _out.write(zeros, detail::binaryConfigPadding(bytes));
+      if (!_out)
+	M_throw() << "Failed while writing the binary configuration file";
+    }
+
+    std::ostream& _out;
+  };
+
+  /*! \brief Memory maps a binary configuration file for reading.
+
+    The arrays must be read using nextArray in the order they were
+    written (see \ref BinaryConfigHeader). The returned pointers are
+    into the mapped file and only valid for the lifetime of the
+    reader.
+  */
+  class BinaryConfigReader
+  {
+  public:
+    BinaryConfigReader(const std::string& fileName):
+      _file(fileName)
+    {
+      if (_file.size() < sizeof(BinaryConfigHeader))
+	M_throw() << fileName << " is too small to be a binary configuration file";
+
+      std::memcpy(&_header, _file.data(), sizeof(_header));
+
+      if (std::memcmp(_header.magic, "DYNAMOB", 8))
+	M_throw() << fileName << " is not a binary configuration file";
+
+      if (_header.byteOrder != 0x01020304)
+	M_throw() << fileName << " was written with a different byte order to this machine";
+
+      if (_header.version != binaryConfigVersion)
+	M_throw() << fileName << " is version " << _header.version
+		  << " of the binary configuration format, only version " << binaryConfigVersion << " is supported";
+
+      _offset = sizeof(BinaryConfigHeader);
+      _xml = block(_header.xmlSize);
+    }
+
+    const BinaryConfigHeader& getHeader() const { return _header; }
+
+    //! \brief The XML part of the configuration.
+    std::string getXML() const { return std::string(_xml, _header.xmlSize); }
+
+    //! \brief Returns the next array of the file, which must contain count elements.
+    template<class T>
+    const T* nextArray(size_t count)
+    { return reinterpret_cast<const T*>(block(count * sizeof(T))); }
+
+  private:
+    const char* block(size_t bytes)
+    {
+      if (_offset + bytes > _file.size())
+	M_throw() << "The binary configuration file is truncated";
+
+      const char* retval = _file.data() + _offset;
+      _offset += bytes + detail::binaryConfigPadding(bytes);
+      return retval;
+    }
+
+    boost::iostreams::mapped_file_source _file;
+    BinaryConfigHeader _header;
+    const char* _xml;
+    size_t _offset;
+  };
+}
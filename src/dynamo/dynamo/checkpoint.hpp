@@ -0,0 +1,250 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/exception.hpp>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+
+namespace dynamo {
+  /*! \brief The header at the start of a checkpoint file.
+
+    A checkpoint holds the complete run-time state of a Simulation
+    (see Simulation::writeCheckpoint), so that a run can be continued
+    exactly where it stopped. Unlike a configuration file, it also
+    holds the event lists of the Scheduler, the neighbour lists and
+    the random number generator state, and the particle data is
+    written without first bringing the particles up to date.
+
+    After the header, the file is a sequence of sections. Each
+    section starts with its name, so that a checkpoint which does not
+    match the loaded Simulation is detected. The contents of each
+    section are written by the saveCheckpoint function of the
+    class which owns that state, as raw little-endian values.
+  */
+  struct CheckpointHeader
+  {
+    //! \brief Identifies the file type, always "DYNAMOK" followed by a null.
+    char magic[8];
+    //! \brief The version of the checkpoint layout (see checkpointVersion).
+    uint32_t version;
+    //! \brief The value 0x01020304, used to detect the byte order.
+    uint32_t byteOrder;
+    //! \brief The number of particles.
+    uint64_t N;
+    uint64_t reserved;
+  };
+
+  static_assert(sizeof(CheckpointHeader) == 32, "The checkpoint header must be exactly 32 bytes");
+
+  //! \brief The current version of the checkpoint layout.
+  static const uint32_t checkpointVersion = 1;
+
+  /*! \brief Writes a checkpoint file.
+
+    The data is written to a temporary file which only replaces the
+    named file once commit is called. A run killed while writing a
+    checkpoint therefore leaves the previous checkpoint intact.
+  */
+  class CheckpointWriter
+  {
+  public:
+    CheckpointWriter(const std::string& fileName, size_t N):
+      _fileName(fileName),
+      _tmpName(fileName + ".tmp"),
+      _out(_tmpName.c_str(), std::ios::binary | std::ios::out | std::ios::trunc)
+    {
+      if (!_out)
+	M_throw() << "Could not open " << _tmpName << " for writing";
+
+      const uint32_t test = 1;
+      if (*reinterpret_cast<const unsigned char*>(&test) != 1)
+	M_throw() << "Checkpoint files can only be written on little-endian machines";
+
+      CheckpointHeader header;
+      std::memset(&header, 0, sizeof(header));
+      std::memcpy(header.magic, "DYNAMOK", 8);
+      header.version = checkpointVersion;
+      header.byteOrder = 0x01020304;
+      header.N = N;
+      write(header);
+    }
+
+    //! \brief Marks the start of the state of a named object.
+    void section(const std::string& name) { write(name); }
+
+    template<class T>
+    void write(const T& value)
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly to a checkpoint");
+      writeBytes(&value, sizeof(T));
+    }
+
+    template<class T>
+    void write(const std::vector<T>& data)
+    {
+      write(uint64_t(data.size()));
+      writeArray(data.data(), data.size());
+    }
+
+    void write(const std::string& data)
+    {
+      write(uint64_t(data.size()));
+      writeBytes(data.data(), data.size());
+    }
+
+    template<class T>
+    void writeArray(const T* data, size_t count)
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly to a checkpoint");
+      writeBytes(data, count * sizeof(T));
+    }
+
+    //! \brief Completes the checkpoint, replacing any existing file.
+    void commit()
+    {
+      _out.close();
+      if (!_out)
+	M_throw() << "Failed while writing the checkpoint file " << _tmpName;
+
+      if (std::rename(_tmpName.c_str(), _fileName.c_str()))
+	M_throw() << "Could not move the checkpoint " << _tmpName << " to " << _fileName;
+    }
+
+  private:
+    void writeBytes(const void* data, size_t bytes)
+    {
+      _out.write(static_cast<const char*>(data), bytes);
+      if (!_out)
+	M_throw() << "Failed while writing the checkpoint file " << _tmpName;
+    }
+
+    std::string _fileName;
+    std::string _tmpName;
+    std::ofstream _out;
+  };
+
+  /*! \brief Reads a checkpoint file written by CheckpointWriter.
+
+    The file is read into memory. The values must be read in the
+    order they were written, but the read position may be saved and
+    restored using tell and seek, so that a section can be read more
+    than once.
+  */
+  class CheckpointReader
+  {
+  public:
+    CheckpointReader(const std::string& fileName):
+      _fileName(fileName),
+      _offset(0)
+    {
+      std::ifstream in(fileName.c_str(), std::ios::binary);
+      if (!in)
+	M_throw() << "Could not open the checkpoint file " << fileName;
+
+      _data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+      if (_data.size() < sizeof(CheckpointHeader))
+	M_throw() << fileName << " is too small to be a checkpoint file";
+
+      read(_header);
+
+      if (std::memcmp(_header.magic, "DYNAMOK", 8))
+	M_throw() << fileName << " is not a checkpoint file";
+
+      if (_header.byteOrder != 0x01020304)
+	M_throw() << fileName << " was written with a different byte order to this machine";
+
+      if (_header.version != checkpointVersion)
+	M_throw() << fileName << " is version " << _header.version
+		  << " of the checkpoint format, only version " << checkpointVersion << " is supported";
+    }
+
+    const CheckpointHeader& getHeader() const { return _header; }
+
+    const std::string& getFileName() const { return _fileName; }
+
+    //! \brief Checks that the next section is the state of the named object.
+    void section(const std::string& name)
+    {
+      std::string stored;
+      read(stored);
+      if (stored != name)
+	M_throw() << "The checkpoint " << _fileName << " does not match the simulation, expected the state of "
+		  << name << " but found " << stored;
+    }
+
+    template<class T>
+    void read(T& value)
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly from a checkpoint");
+      readBytes(&value, sizeof(T));
+    }
+
+    template<class T>
+    void read(std::vector<T>& data)
+    {
+      uint64_t size;
+      read(size);
+      data.resize(size);
+      readArray(data.data(), size);
+    }
+
+    void read(std::string& data)
+    {
+      uint64_t size;
+      read(size);
+      data.assign(block(size), size);
+    }
+
+    template<class T>
+    void readArray(T* data, size_t count)
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly from a checkpoint");
+      readBytes(data, count * sizeof(T));
+    }
+
+    size_t tell() const { return _offset; }
+
+    void seek(size_t offset) { _offset = offset; }
+
+  private:
+    const char* block(size_t bytes)
+    {
+      if (_offset + bytes > _data.size())
+	M_throw() << "The checkpoint file " << _fileName << " is truncated";
+
+      const char* retval = _data.data() + _offset;
+      _offset += bytes;
+      return retval;
+    }
+
+    void readBytes(void* data, size_t bytes)
+    { if (bytes) std::memcpy(data, block(bytes), bytes); }
+
+    std::string _fileName;
+    std::vector<char> _data;
+    size_t _offset;
+    CheckpointHeader _header;
+  };
+}
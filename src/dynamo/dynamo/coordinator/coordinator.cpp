@@ -63,9 +63,10 @@ namespace dynamo {
     systemopts.add_options()
       ("help", "Produces this message")
       ("n-threads,N", po::value<unsigned int>(),
-       "Number of threads to spawn for concurrent processing. (Only utilised by certain engine/sim configurations)")
+       "Number of threads to spawn for concurrent processing. These are used to validate the configuration and build the event lists at start up, and by certain engine/sim configurations.")
+      ("pin-threads", "Pin each of the threads spawned by --n-threads to its own CPU core (Linux only).")
       ("out-config-file,o", po::value<std::string>(),
-       "Default config output file,(config.%ID.end.xml.bz2)")
+       "Default config output file,(config.%ID.end.xml.bz2). Use a .dynbin extension for a binary configuration.")
       ("out-data-file", po::value<std::string>(),
        "Default result output file (output.%ID.xml.bz2)")
       ("config-file", po::value<std::vector<std::string> >(),
@@ -137,7 +138,10 @@ namespace dynamo {
     }
 
     if (vm.count("n-threads"))
-      _threads.setThreadCount(vm["n-threads"].as<unsigned int>());
+      _threads.setThreadCount(vm["n-threads"].as<unsigned int>(), vm.count("pin-threads"));
+
+    if ((vm.count("checkpoint") || vm.count("restart")) && (vm["engine"].as<size_t>() != 1))
+      M_throw() << "Checkpoints are only supported by the standard engine (--engine 1)";
 
     switch (vm["engine"].as<size_t>())
       {
@@ -46,8 +46,26 @@ namespace dynamo {
        "Simulation end time (Note, In replica exchange, each systems end time is scaled by"
        "(T_cold/T_i)^{1/2}, see replex-interval)")
       ("unwrapped", "Don't apply the boundary conditions of the system when writing out the particle positions.")
+      ("renumber", "Renumber the particles along a Morton curve after loading, so that particles close in space are close in memory. "
+       "The output configuration keeps the original particle order.")
+      ("parallel-prediction", "Predict the new events of the particles in an interaction event using the thread pool (see --n-threads). "
+       "Only worthwhile for interactions with expensive event tests (e.g., lines, dumbbells).")
+      ("sorter-trace", boost::program_options::value<std::string>(),
+       "Record every operation on the event sorter to this file, for replaying with dynasortbench.")
+      ("output-buffer", boost::program_options::value<size_t>()->default_value(4096),
+       "No. of events buffered for the output plugins which process events in batches (e.g., CollisionMatrix). "
+       "Set to 0 to update every plugin as each event occurs.")
+      ("output-thread", "Run the batched output plugins on their own thread, overlapping them with the simulation.")
       ("snapshot", boost::program_options::value<double>(),
        "Sets the system time inbetween saving snapshots of the system.")
+      ("checkpoint", boost::program_options::value<std::string>(),
+       "Write a checkpoint to this file when the run ends or is stopped (e.g., by SIGTERM), which --restart continues exactly. "
+       "Only supported by the standard engine.")
+      ("checkpoint-interval", boost::program_options::value<size_t>()->default_value(0),
+       "No. of events between writing the checkpoint (0 to only write it at the end of the run).")
+      ("restart", boost::program_options::value<std::string>(),
+       "Continue the run from a checkpoint file. The configuration file must be of the same system, as only the run-time state is "
+       "in the checkpoint. The event count is restored too, so --events remains the total for the run.")
       ;
   
     opts.add(simopts);
@@ -89,6 +107,9 @@ namespace dynamo {
     
     Sim.status = CONFIG_LOADED;
     Sim.endEventCount = vm["events"].as<size_t>();
+
+    if (vm.count("renumber"))
+      Sim.renumberParticles();
   
     if (vm["events"].as<size_t>() 
 	> vm["print-events"].as<size_t>())
@@ -96,6 +117,10 @@ namespace dynamo {
     else
       Sim.eventPrintInterval = vm["events"].as<size_t>();
     
+    Sim.outputBufferSize = vm["output-buffer"].as<size_t>();
+    Sim.threadedOutput = vm.count("output-thread");
+    Sim.threads = &threads;
+
     if (vm.count("sim-end-time") && (dynamic_cast<const EReplicaExchangeSimulation*>(this) == NULL))
       Sim.systems.push_back(shared_ptr<System>(new SystHalt(&Sim, vm["sim-end-time"].as<double>(), "SystemStopEvent")));
 
@@ -50,6 +50,9 @@ namespace dynamo {
        "  2: \tRandom pair per swap\n"
        "  3: \t5 * Nsim random pairs per swap\n"
        "  4: \tRandom selection of the above methods")
+      ("replex-async", "Run the replicas asynchronously. Instead of halting every replica for each exchange, "
+       "each replica only waits for the neighbouring temperature it is paired with (only swap modes 0 and 1 are "
+       "supported). Interrupts stop the replicas at their next exchange.")
       ;
   
     opts.add(ropts);
@@ -63,7 +66,13 @@ namespace dynamo {
     replexSwapCalls(0),
     round_trips(0),
     SeqSelect(false),
-    nSims(0)
+    nSims(0),
+    _async(nVm.count("replex-async")),
+    _asyncRounds(0),
+    _runners(0),
+    _running(0),
+    _maxRunners(0),
+    _asyncStop(false)
   {
     if (vm["events"].as<size_t>() != std::numeric_limits<size_t>::max())
       M_throw() << "You cannot use collisions to control a replica exchange simulation\n"
@@ -86,6 +95,9 @@ namespace dynamo {
 
 	Simulations[i].initialise();
 
+	if (vm.count("parallel-prediction"))
+	  Simulations[i].ptrScheduler->setThreadPool(&threads);
+
 	postSimInit(Simulations[i]);
       }
 
@@ -175,6 +187,9 @@ namespace dynamo {
 	std::cout << "\nTurning off replica exchange as you have Nsystems < 2";
 	ReplexMode = NoSwapping;
       }
+
+    if (_async && (ReplexMode != NoSwapping) && (ReplexMode != AlternatingSequence))
+      M_throw() << "The asynchronous replica exchange (--replex-async) only supports --replex-swap-mode 0 or 1";
   
     if (configFormat.find("%ID") == configFormat.npos)
       M_throw() << "Replex mode, but format string for config file output"
@@ -306,6 +321,95 @@ namespace dynamo {
     SimDirection[temperatureList.back().second.simID] = -1; //Going down
   }
 
+  void
+  EReplicaExchangeSimulation::ReplexSlotTicker(const size_t slot)
+  {
+    simData& dat = temperatureList[slot].second;
+    ++(Simulations[dat.simID].replexExchangeNumber);
+
+    if (SimDirection[dat.simID] > 0)
+      ++dat.upSims;
+    else if (SimDirection[dat.simID] < 0)
+      ++dat.downSims;
+
+    if (slot == 0)
+      {
+	//The coldest temperature counts the exchange cycles
+	++replexSwapCalls;
+	if (SimDirection[dat.simID] == -1)
+	  {
+	    if (roundtrip[dat.simID])
+	      ++round_trips;
+	    roundtrip[dat.simID] = true;
+	  }
+	SimDirection[dat.simID] = 1; //Going up
+      }
+
+    if (slot == temperatureList.size() - 1)
+      {
+	if (SimDirection[dat.simID] == 1)
+	  {
+	    if (roundtrip[dat.simID])
+	      ++round_trips;
+	    roundtrip[dat.simID] = true;
+	  }
+	SimDirection[dat.simID] = -1; //Going down
+      }
+  }
+
+  void
+  EReplicaExchangeSimulation::resetReplexHalt(const size_t simID)
+  {
+    shared_ptr<SystHalt> tmpRef = std::dynamic_pointer_cast<SystHalt>
+      (Simulations[simID].systems["ReplexHalt"]);
+
+#ifdef DYNAMO_DEBUG
+    if (!tmpRef)
+      M_throw() << "Could not find the time halt event error";
+#endif
+    //Each simulations exchange time is inversly proportional to its temperature
+    double tFactor
+      = std::sqrt(temperatureList.begin()->second.realTemperature
+		  / Simulations[simID].ensemble->getReducedEnsembleVals()[2]);
+
+    tmpRef->increasedt(vm["replex-interval"].as<double>() * tFactor);
+
+    Simulations[simID].ptrScheduler->rebuildSystemEvents();
+
+    //Reset the max collisions
+    Simulations[simID].endEventCount = vm["events"].as<size_t>();
+  }
+
+  void
+  EReplicaExchangeSimulation::printETA(const double fractionComplete)
+  {
+    timespec endTime;
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    double duration = double(endTime.tv_sec) - double(_startTime.tv_sec)
+      + 1e-9 * (double(endTime.tv_nsec) - double(_startTime.tv_nsec));
+
+    double seconds_remaining_double = duration * (1/ fractionComplete - 1);
+    size_t seconds_remaining = seconds_remaining_double;
+
+    if (seconds_remaining_double < std::numeric_limits<size_t>::max())
+      {
+	size_t ETA_hours = seconds_remaining / 3600;
+	size_t ETA_mins = (seconds_remaining / 60) % 60;
+	size_t ETA_secs = seconds_remaining % 60;
+
+	std::cout << "\rReplica Exchange No." << replexSwapCalls << ", ETA ";
+	if (ETA_hours)
+	  std::cout << ETA_hours << "hr ";
+
+	if (ETA_mins)
+	  std::cout << ETA_mins << "min ";
+
+	std::cout << ETA_secs << "s        ";
+	std::cout.flush();
+      }
+  }
+
   void 
   EReplicaExchangeSimulation::AttemptSwap(const unsigned int sim1ID, const unsigned int sim2ID)
   {
@@ -371,6 +475,13 @@ namespace dynamo {
     clock_gettime(CLOCK_MONOTONIC, &_startTime);
     start_Time = boost::posix_time::second_clock::local_time();
 
+    if (_async)
+      {
+	runAsynchronous();
+	end_Time = boost::posix_time::second_clock::local_time();
+	return;
+      }
+
     while (((Simulations[0].systemTime / Simulations[0].units.unitTime()) < replicaEndTime)
 	   && (Simulations[0].eventCount < vm["events"].as<size_t>()))
       {
@@ -507,57 +618,145 @@ namespace dynamo {
 		  
 	    //Reset the stop events
 	    for (size_t i = nSims; i != 0;)
-	      {
-		//Reset the stop event
-		shared_ptr<SystHalt> tmpRef = std::dynamic_pointer_cast<SystHalt>
-		  (Simulations[--i].systems["ReplexHalt"]);
-		
-#ifdef DYNAMO_DEBUG
-		if (!tmpRef)
-		  M_throw() << "Could not find the time halt event error";
-#endif			
-		//Each simulations exchange time is inversly proportional to its temperature
-		double tFactor 
-		  = std::sqrt(temperatureList.begin()->second.realTemperature
-			      / Simulations[i].ensemble->getReducedEnsembleVals()[2]); 
+	      resetReplexHalt(--i);
 
-		tmpRef->increasedt(vm["replex-interval"].as<double>() * tFactor);
+	    printETA((Simulations[0].systemTime / Simulations[0].units.unitTime()) / replicaEndTime);
+	  }
+      }
+    end_Time = boost::posix_time::second_clock::local_time();
+  }
 
-		Simulations[i].ptrScheduler->rebuildSystemEvents();
+  void
+  EReplicaExchangeSimulation::runAsynchronous()
+  {
+    //The first interval ends at time zero, then one exchange is
+    //attempted every interval until the end time
+    const double intervals = std::ceil(replicaEndTime / vm["replex-interval"].as<double>());
+    _asyncRounds = (intervals < double(std::numeric_limits<size_t>::max() / 2)) 
+      ? size_t(intervals) + 1 : std::numeric_limits<size_t>::max();
+
+    _slotRounds.assign(nSims, 0);
+    _slotWaiting.assign(nSims, false);
+    _readySlots.clear();
+    for (size_t slot(0); slot < nSims; ++slot)
+      _readySlots.push_back(slot);
+
+    _asyncStop = false;
+    _running = 0;
+    _maxRunners = std::min(size_t(nSims), std::max(threads.getThreadCount(), size_t(1)));
+    _runners = _maxRunners;
+
+    for (size_t i(0); i < _maxRunners; ++i)
+      threads.queueTask(std::bind(&EReplicaExchangeSimulation::asyncRunner, this));
+    threads.wait();
+
+    std::cout << std::endl;
+  }
 
-		//Reset the max collisions
-		Simulations[i].endEventCount = vm["events"].as<size_t>();
-	      }
+  void
+  EReplicaExchangeSimulation::asyncRunner()
+  {
+    std::unique_lock<std::mutex> lock(_asyncMutex);
+    while (!_readySlots.empty())
+      {
+	//Give the thread to the replica which is furthest behind
+	std::vector<size_t>::iterator next = _readySlots.begin();
+	for (std::vector<size_t>::iterator it = _readySlots.begin(); it != _readySlots.end(); ++it)
+	  if (_slotRounds[*it] < _slotRounds[*next])
+	    next = it;
+
+	const size_t slot = *next;
+	_readySlots.erase(next);
+	++_running;
+	Simulation& sim = Simulations[temperatureList[slot].second.simID];
+
+	lock.unlock();
+	try {
+	  sim.runSimulation(true);
+	} catch (...) {
+	  lock.lock();
+	  _asyncStop = true;
+	  --_running;
+	  --_runners;
+	  throw;
+	}
+	lock.lock();
 
-	    timespec endTime;
-	    clock_gettime(CLOCK_MONOTONIC, &endTime);
-	    
-	    double duration = double(endTime.tv_sec) - double(_startTime.tv_sec)
-	      + 1e-9 * (double(endTime.tv_nsec) - double(_startTime.tv_nsec));
-	    
-	    double fractionComplete = (Simulations[0].systemTime / Simulations[0].units.unitTime()) / replicaEndTime;
-	    double seconds_remaining_double = duration * (1/ fractionComplete - 1);
-	    size_t seconds_remaining = seconds_remaining_double;
-	    
-	    if (seconds_remaining_double < std::numeric_limits<size_t>::max())
-	      {
-		size_t ETA_hours = seconds_remaining / 3600;
-		size_t ETA_mins = (seconds_remaining / 60) % 60;
-		size_t ETA_secs = seconds_remaining % 60;
-		
-		std::cout << "\rReplica Exchange No." << replexSwapCalls << ", ETA ";
-		if (ETA_hours)
-		  std::cout << ETA_hours << "hr ";
-		
-		if (ETA_mins)
-		  std::cout << ETA_mins << "min ";
-		
-		std::cout << ETA_secs << "s        ";
-		std::cout.flush();
-	      }
+	asyncIntervalComplete(slot);
+
+	//Start more runners if there are replicas waiting for a thread
+	size_t newRunners(0);
+	while ((_readySlots.size() > _runners - _running) && (_runners < _maxRunners))
+	  {
+	    ++_runners;
+	    ++newRunners;
+	  }
+
+	if (newRunners)
+	  {
+	    lock.unlock();
+	    for (size_t i(0); i < newRunners; ++i)
+	      threads.queueTask(std::bind(&EReplicaExchangeSimulation::asyncRunner, this));
+	    lock.lock();
 	  }
       }
-    end_Time = boost::posix_time::second_clock::local_time();
+
+    --_runners;
+  }
+
+  void
+  EReplicaExchangeSimulation::asyncIntervalComplete(const size_t slot)
+  {
+    --_running;
+    const size_t rounds = ++_slotRounds[slot];
+
+    if (_SIGTERM || _SIGINT)
+      _asyncStop = true;
+
+    //Stopped replicas are left waiting at their exchange
+    if (_asyncStop) return;
+
+    //Neighbouring temperatures are paired alternately, as in the
+    //AlternatingSequence mode
+    size_t partner = nSims;
+    if (ReplexMode != NoSwapping)
+      {
+	if ((slot % 2) == (rounds % 2))
+	  partner = slot + 1;
+	else if (slot)
+	  partner = slot - 1;
+      }
+
+    if (partner >= nSims)
+      {
+	asyncRelease(slot);
+	return;
+      }
+
+    if (!_slotWaiting[partner] || (_slotRounds[partner] != rounds))
+      {
+	_slotWaiting[slot] = true;
+	return;
+      }
+
+    _slotWaiting[partner] = false;
+    AttemptSwap(std::min(slot, partner), std::max(slot, partner));
+    asyncRelease(slot);
+    asyncRelease(partner);
+  }
+
+  void
+  EReplicaExchangeSimulation::asyncRelease(const size_t slot)
+  {
+    ReplexSlotTicker(slot);
+
+    if (slot == 0)
+      printETA(double(_slotRounds[0]) / _asyncRounds);
+
+    if (_slotRounds[slot] >= _asyncRounds) return;
+
+    resetReplexHalt(temperatureList[slot].second.simID);
+    _readySlots.push_back(slot);
   }
 
   void 
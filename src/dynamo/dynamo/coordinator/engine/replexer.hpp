@@ -23,6 +23,7 @@
 #include <dynamo/coordinator/engine/engine.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <memory>
+#include <mutex>
 #include <ctime>
 
 namespace dynamo {
@@ -36,6 +37,14 @@ namespace dynamo {
    
     This class uses the ThreadPool to parallelise the running of the
     simulations.
+
+    In the asynchronous mode (--replex-async) there is no global
+    halt. Each replica runs its interval independently, and only
+    waits for the neighbouring temperature it is paired with in that
+    round (the pairs alternate, as in the AlternatingSequence
+    mode). Replicas waiting for a thread are run in order of the
+    number of intervals they have completed, so that the slowest
+    replicas are run first.
    */
   class EReplicaExchangeSimulation: public Engine
   {
@@ -193,6 +202,45 @@ namespace dynamo {
 
     timespec _startTime;
 
+    /*! \brief If the replicas are run asynchronously.
+     */
+    bool _async;
+
+    /*! \brief Protects the replica exchange data while the replicas
+      run asynchronously.
+     */
+    std::mutex _asyncMutex;
+
+    /*! \brief The number of intervals completed by the replica at
+      each temperature (in the order of temperatureList).
+     */
+    std::vector<size_t> _slotRounds;
+
+    /*! \brief Set if the replica at a temperature is waiting for its
+      exchange partner.
+     */
+    std::vector<char> _slotWaiting;
+
+    /*! \brief The temperatures whose replicas are ready to run their
+      next interval.
+     */
+    std::vector<size_t> _readySlots;
+
+    /*! \brief The number of intervals each replica runs in the
+      asynchronous mode.
+     */
+    size_t _asyncRounds;
+
+    /*! \brief The number of runner tasks, and the number of replicas
+      they are currently running.
+     */
+    size_t _runners, _running, _maxRunners;
+
+    /*! \brief Set to stop the replicas at the end of their current
+      interval.
+     */
+    bool _asyncStop;
+
     /*! \brief Initialises this class ready for the replica exchange.
      */
     virtual void preSimInit();
@@ -235,5 +283,40 @@ namespace dynamo {
       \param id2 Second Simulation to attempt to exchange.
      */
     void AttemptSwap(const unsigned int id1, const unsigned int id2);
+
+    /*! \brief Updates the replica exchange data of a single
+      temperature, once its replica has finished an interval and any
+      exchange has been attempted.
+     */
+    void ReplexSlotTicker(const size_t slot);
+
+    /*! \brief Sets the time of the next replica exchange of a
+      Simulation.
+     */
+    void resetReplexHalt(const size_t simID);
+
+    /*! \brief Prints the estimated time remaining.
+     */
+    void printETA(const double fractionComplete);
+
+    /*! \brief Runs the replicas without a global halt.
+     */
+    void runAsynchronous();
+
+    /*! \brief The task which runs replicas while there are any ready
+      to run.
+     */
+    void asyncRunner();
+
+    /*! \brief Pairs a replica which has finished its interval with
+      its neighbour, if it is waiting. Must be called with the
+      _asyncMutex held.
+     */
+    void asyncIntervalComplete(const size_t slot);
+
+    /*! \brief Marks the replica at a temperature as ready to run its
+      next interval. Must be called with the _asyncMutex held.
+     */
+    void asyncRelease(const size_t slot);
   };
 }
@@ -18,6 +18,8 @@
 #include <dynamo/coordinator/coordinator.hpp>
 #include <dynamo/coordinator/engine/single.hpp>
 #include <dynamo/systems/snapshot.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/schedulers/sorters/trace.hpp>
 #include <signal.h>
 #include <stdio.h>
 
@@ -30,10 +32,20 @@ namespace dynamo {
   void
   ESingleSimulation::runSimulation()
   {
+    const size_t checkpointInterval = vm["checkpoint-interval"].as<size_t>();
+    size_t nextCheckpoint = simulation.eventCount + checkpointInterval;
+
     try {
       while (true)
 	{
 	  if (!simulation.runSimulationStep()) break;
+
+	  if (checkpointInterval && (simulation.eventCount >= nextCheckpoint) && vm.count("checkpoint"))
+	    {
+	      simulation.writeCheckpoint(vm["checkpoint"].as<std::string>());
+	      nextCheckpoint = simulation.eventCount + checkpointInterval;
+	    }
+
 	  if (_SIGINT)
 	    {
 	      //Clear the writes to screen
@@ -73,6 +85,11 @@ namespace dynamo {
 	      simulation.simShutdown();
 	    }
 	}
+
+      //Written before the configuration, as writing that brings the
+      //particles up to date
+      if (vm.count("checkpoint"))
+	simulation.writeCheckpoint(vm["checkpoint"].as<std::string>());
     }
     catch (std::exception& cep)
       {
@@ -98,14 +115,24 @@ namespace dynamo {
 
     setupSim(simulation, vm["config-file"].as<std::vector<std::string> >()[0]);
 
+    if (vm.count("restart"))
+      simulation.loadCheckpoint(vm["restart"].as<std::string>());
+
     if (vm.count("snapshot"))
       simulation.systems.push_back(shared_ptr<System>(new SSnapshot(&simulation, vm["snapshot"].as<double>(), "SnapshotEvent", "%COUNT", !vm.count("unwrapped"))));
 
+    if (vm.count("sorter-trace"))
+      simulation.ptrScheduler->setSorter(shared_ptr<FEL>(new FELTrace(simulation.ptrScheduler->getSorter(), vm["sorter-trace"].as<std::string>())));
+
     simulation.initialise();
 
+    if (vm.count("parallel-prediction"))
+      simulation.ptrScheduler->setThreadPool(&threads);
+
     postSimInit(simulation);
 
-    if (vm.count("ticker-period"))
+    //The ticker period of a restarted run is restored from the checkpoint
+    if (vm.count("ticker-period") && !vm.count("restart"))
       simulation.setTickerPeriod(vm["ticker-period"].as<double>());
 
   }
@@ -33,6 +33,8 @@ namespace dynamo {
   public:
     DynCompression(dynamo::Simulation*, double);
     virtual double SphereSphereInRoot(const Particle& p1, const Particle& p2, double d) const;
+    virtual void SphereSphereInRoot(const Particle& p1, const size_t* ids, const double* d, double* dt, size_t N) const
+    { Dynamics::SphereSphereInRoot(p1, ids, d, dt, N); }
     virtual double SphereSphereOutRoot(const Particle& p1, const Particle& p2, double d) const;  
     virtual double sphereOverlap(const Particle& p1, const Particle& p2, const double& d) const;
     virtual PairEventData SmoothSpheresColl(const IntEvent&, const double&, const double&, const EEventType&) const;
@@ -45,6 +47,7 @@ namespace dynamo {
     virtual bool cubeOverlap(const Particle& p1, const Particle& p2, const double d) const { M_throw() << "Not Implemented"; }
     virtual PairEventData parallelCubeColl(const IntEvent& event, const double& e, const double& d, const EEventType& eType = CORE) const;
     virtual ParticleEventData runAndersenWallCollision(Particle&, const Vector &, const double& T, const double d) const;
+    virtual bool timeScaleInvariant() const { return false; }
   protected:
     virtual void outputXML(magnet::xml::XmlStream&) const;
     double growthRate;
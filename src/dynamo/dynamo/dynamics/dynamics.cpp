@@ -105,6 +105,13 @@ namespace dynamo {
   Dynamics::getPBCSentinelTime(const Particle&, const double&) const
   { M_throw() << "Not implemented for this Dynamics."; }
 
+  void
+  Dynamics::SphereSphereInRoot(const Particle& p1, const size_t* ids, const double* d, double* dt, size_t N) const
+  {
+    for (size_t i(0); i < N; ++i)
+      dt[i] = SphereSphereInRoot(p1, Sim->particles[ids[i]], d[i]);
+  }
+
   void 
   Dynamics::loadParticleXMLData(const magnet::xml::Node& XML)
   {
@@ -151,6 +158,126 @@ namespace dynamo {
       }
   }
 
+  void
+  Dynamics::loadParticleBinaryData(BinaryConfigReader& reader)
+  {
+    dout << "Loading Particle Data from the binary arrays" << std::endl;
+
+    const size_t N = reader.getHeader().N;
+    const double* pos = reader.nextArray<double>(3 * N);
+    const double* vel = reader.nextArray<double>(3 * N);
+    const uint32_t* states = reader.nextArray<uint32_t>(N);
+
+    Sim->particles.reserve(N);
+    for (size_t i(0); i < N; ++i)
+      {
+	Particle part(Vector(pos[3 * i], pos[3 * i + 1], pos[3 * i + 2]) * Sim->units.unitLength(),
+		      Vector(vel[3 * i], vel[3 * i + 1], vel[3 * i + 2]) * Sim->units.unitVelocity(),
+		      i);
+	if (!(states[i] & Particle::DYNAMIC))
+	  part.clearState(Particle::DYNAMIC);
+	Sim->particles.push_back(part);
+      }
+
+    Sim->N = Sim->particles.size();
+
+    dout << "Particle count " << Sim->N << std::endl;
+
+    if (reader.getHeader().flags & BinaryConfigHeader::ORIENTATION_DATA)
+      {
+	const double* orientation = reader.nextArray<double>(4 * N);
+	const double* angularVelocity = reader.nextArray<double>(3 * N);
+	orientationData.resize(N);
+	for (size_t i(0); i < N; ++i)
+	  {
+	    orientationData[i].orientation = Quaternion(orientation[4 * i], orientation[4 * i + 1], orientation[4 * i + 2], orientation[4 * i + 3]);
+	    orientationData[i].angularVelocity = Vector(angularVelocity[3 * i], angularVelocity[3 * i + 1], angularVelocity[3 * i + 2]);
+
+	    orientationData[i].orientation.normalise();
+	    if (orientationData[i].orientation.nrm() == 0)
+	      M_throw() << "Particle " << i << " has an invalid zero orientation quaternion";
+	  }
+      }
+  }
+
+  void
+  Dynamics::saveCheckpoint(CheckpointWriter& out) const
+  {
+    out.section("Dynamics");
+    out.write(partPecTime);
+    out.write(streamCount);
+    out.write(orientationData);
+  }
+
+  void
+  Dynamics::loadCheckpoint(CheckpointReader& in)
+  {
+    in.section("Dynamics");
+    in.read(partPecTime);
+    in.read(streamCount);
+    in.read(orientationData);
+    if (!orientationData.empty() && (orientationData.size() != Sim->N))
+      M_throw() << "The checkpoint holds the orientations of " << orientationData.size() << " particles, but the simulation has " << Sim->N;
+  }
+
+  void
+  Dynamics::outputParticleBinaryData(BinaryConfigWriter& writer, bool applyBC) const
+  {
+    std::vector<double> pos(3 * Sim->N), vel(3 * Sim->N);
+    std::vector<uint32_t> states(Sim->N);
+
+    //As with the XML, the particles are written in their original order
+    for (size_t ID = 0; ID < Sim->N; ++ID)
+      {
+	const size_t i = Sim->getRenumberedID(ID);
+	Particle tmp(Sim->particles[i]);
+	if (applyBC) 
+	  Sim->BCs->applyBC(tmp.getPosition(), tmp.getVelocity());
+
+	tmp.getVelocity() *= (1.0 / Sim->units.unitVelocity());
+	tmp.getPosition() *= (1.0 / Sim->units.unitLength());
+
+	for (size_t n(0); n < NDIM; ++n)
+	  {
+	    pos[3 * ID + n] = tmp.getPosition()[n];
+	    vel[3 * ID + n] = tmp.getVelocity()[n];
+	  }
+	states[ID] = tmp.testState(Particle::DYNAMIC) ? Particle::DEFAULT : Particle::ALIVE;
+      }
+
+    writer.writeArray(pos);
+    writer.writeArray(vel);
+    writer.writeArray(states);
+
+    if (hasOrientationData())
+      {
+	std::vector<double> orientation(4 * Sim->N), angularVelocity(3 * Sim->N);
+	for (size_t ID = 0; ID < Sim->N; ++ID)
+	  {
+	    const rotData& data = orientationData[Sim->getRenumberedID(ID)];
+	    orientation[4 * ID] = data.orientation.real();
+	    for (size_t n(0); n < NDIM; ++n)
+	      {
+		orientation[4 * ID + 1 + n] = data.orientation.imaginary()[n];
+		angularVelocity[3 * ID + n] = data.angularVelocity[n];
+	      }
+	  }
+	writer.writeArray(orientation);
+	writer.writeArray(angularVelocity);
+      }
+  }
+
+  void
+  Dynamics::renumberParticles(const std::vector<size_t>& newIDs)
+  {
+    if (!hasOrientationData()) return;
+
+    std::vector<rotData> newData(orientationData.size());
+    for (size_t ID(0); ID < orientationData.size(); ++ID)
+      newData[newIDs[ID]] = orientationData[ID];
+    orientationData.swap(newData);
+  }
+
   void 
   Dynamics::outputParticleXMLData(magnet::xml::XmlStream& XML, bool applyBC) const
   {
@@ -159,9 +286,13 @@ namespace dynamo {
     if (hasOrientationData())
       XML << magnet::xml::attr("OrientationData") << "Y";
 
-    for (size_t i = 0; i < Sim->N; ++i)
+    //The particles are written in the order (and with the IDs) they
+    //were loaded with, in case they have been renumbered.
+    for (size_t ID = 0; ID < Sim->N; ++ID)
       {
+	const size_t i = Sim->getRenumberedID(ID);
 	Particle tmp(Sim->particles[i]);
+	tmp.setID(ID);
 	if (applyBC) 
 	  Sim->BCs->applyBC(tmp.getPosition(), tmp.getVelocity());
       
@@ -88,6 +88,19 @@ namespace dynamo {
       \param XML The root xml::Node of the xml::Document which has the ParticleData tag within.
      */
     virtual void loadParticleXMLData(const magnet::xml::Node& XML);
+
+    /*! \brief Loads the particle data from the arrays of a binary
+      configuration file (see \ref BinaryConfigHeader).
+     */
+    virtual void loadParticleBinaryData(BinaryConfigReader& reader);
+
+    /*! \brief Remaps the per-particle data held by the Dynamics after
+        the particles are renumbered (see
+        Simulation::renumberParticles).
+
+	\param newIDs The new ID of each particle, indexed by its old ID.
+     */
+    virtual void renumberParticles(const std::vector<size_t>& newIDs);
   
     /*! \brief Writes the XML particle data, either the base64 header or
       the entire XML form.
@@ -96,6 +109,21 @@ namespace dynamo {
      */
     void outputParticleXMLData(magnet::xml::XmlStream& XML, bool applyBC) const;
 
+    /*! \brief Writes the particle data arrays of a binary
+      configuration file (see \ref BinaryConfigHeader).
+      \param applyBC Wether to apply the boundary conditions to the final particle positions before writing them out.
+     */
+    void outputParticleBinaryData(BinaryConfigWriter& writer, bool applyBC) const;
+
+    /*! \brief Writes the streaming state of the Dynamics and the
+      orientation data to a checkpoint (see
+      Simulation::writeCheckpoint).
+     */
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+
+    //! \brief Restores the state written by saveCheckpoint, after initialise is called.
+    virtual void loadCheckpoint(CheckpointReader&);
+
     /*! \brief Returns the degrees of freedom per particle.
      */
     inline size_t getParticleDOF() const { return NDIM + 2 * hasOrientationData(); }
@@ -116,6 +144,17 @@ namespace dynamo {
      */
     virtual void rescaleSystemKineticEnergy(const double&);
 
+    /*! \brief True if multiplying the velocities of the particles by
+      a factor (see rescaleSystemKineticEnergy) divides the time
+      until every event by the same factor.
+
+      This lets the Scheduler rescale the times of the queued events
+      instead of predicting them again (see
+      Scheduler::velocitiesRescaled). It is false unless the
+      particles stream freely.
+     */
+    virtual bool timeScaleInvariant() const { return false; }
+
     /*! \brief Performs an elastic multibody collision between to ranges of particles.
       
       Also works for bounce (it will collide receeding structures).
@@ -158,6 +197,25 @@ namespace dynamo {
      */
     virtual double SphereSphereInRoot(const IDRange& p1, const IDRange& p2, double d) const = 0;
 
+    /*! \brief Determines if and when a sphere will intersect each of
+      a batch of other spheres.
+
+      This is the batched form of SphereSphereInRoot(const
+      Particle&, const Particle&, double), used by the Scheduler to
+      predict the events of a particle against all of its neighbours
+      at once. The default implementation simply loops over the
+      scalar test, but dynamics may override it with a vectorised
+      version.
+     
+      \param p1 The particle to test against the batch.
+      \param ids The IDs of the \p N particles to test against.
+      \param d The interaction diameter/distance of each pair.
+      \param dt Output array for the time of each pair's event, or
+      HUGE_VAL if no event.
+      \param N The size of the batch.
+     */
+    virtual void SphereSphereInRoot(const Particle& p1, const size_t* ids, const double* d, double* dt, size_t N) const;
+
     /*! \brief Determines if and when two spheres will stop intersecting.
      
       \param pd Some precomputed data about the event that is cached by
@@ -403,6 +461,24 @@ namespace dynamo {
 			   const double dist
 			   ) const;
 
+    /*! \brief Returns a lower bound on the time until the particle
+      centre enters an axis-aligned box.
+
+      This is used to cull the search of a bounding volume hierarchy
+      (e.g., in LTriangleMesh), so it may underestimate the time. The
+      default implementation returns zero, which culls nothing.
+
+      \param part The particle to test.
+      \param origin The position of the particle relative to the box center.
+      \param width The dimensions of the box.
+      \return The time until the particle enters the box, zero if it
+      is inside, or HUGE_VAL if it never enters.
+     */
+    virtual double getBoxEntryTime(const Particle& part,
+				   const Vector& origin,
+				   const Vector& width) const
+    { return 0; }
+
     /*! \brief Determines when the particle center will hit a cylindrical wall.
      
      
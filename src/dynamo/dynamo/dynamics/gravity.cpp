@@ -32,6 +32,7 @@
 #include <magnet/intersection/parabola_sphere.hpp>
 #include <magnet/intersection/parabola_plane.hpp>
 #include <magnet/intersection/parabola_triangle.hpp>
+#include <magnet/intersection/parabola_cube.hpp>
 #include <magnet/intersection/parabola_rod.hpp>
 #include <magnet/intersection/parabola_cylinder.hpp>
 #include <magnet/xmlwriter.hpp>
@@ -387,6 +388,20 @@ namespace dynamo {
     return retVal;
   }
 
+  void
+  DynGravity::saveCheckpoint(CheckpointWriter& out) const
+  {
+    DynNewtonian::saveCheckpoint(out);
+    out.write(_tcList);
+  }
+
+  void
+  DynGravity::loadCheckpoint(CheckpointReader& in)
+  {
+    DynNewtonian::loadCheckpoint(in);
+    in.read(_tcList);
+  }
+
   void 
   DynGravity::outputXML(magnet::xml::XmlStream& XML) const
   {
@@ -704,6 +719,16 @@ namespace dynamo {
     return retval;
   }
 
+  double
+  DynGravity::getBoxEntryTime(const Particle& part, const Vector& origin, const Vector& width) const
+  {
+    //If the particle doesn't feel gravity, fall back to the standard function
+    if (!part.testState(Particle::DYNAMIC)) 
+      return DynNewtonian::getBoxEntryTime(part, origin, width);
+
+    return magnet::intersection::parabola_AAcube_entry(origin, part.getVelocity(), g, width);
+  }
+
   ParticleEventData 
   DynGravity::runPlaneEvent(Particle &part, const Vector& vNorm, const double& e, double diameter) const
   {
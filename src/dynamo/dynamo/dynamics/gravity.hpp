@@ -31,6 +31,8 @@ namespace dynamo {
     void initialise();
     const Vector& getGravityVector() const { return g; }
     virtual double SphereSphereInRoot(const Particle& p1, const Particle& p2, double d) const;
+    virtual void SphereSphereInRoot(const Particle& p1, const size_t* ids, const double* d, double* dt, size_t N) const
+    { Dynamics::SphereSphereInRoot(p1, ids, d, dt, N); }
     virtual double SphereSphereInRoot(const IDRange& p1, const IDRange& p2, double d) const;
     virtual double SphereSphereOutRoot(const Particle& p1, const Particle& p2, double d) const;
     virtual double SphereSphereOutRoot(const IDRange& p1, const IDRange& p2, double d) const;
@@ -46,9 +48,16 @@ namespace dynamo {
     virtual PairEventData SmoothSpheresColl(const IntEvent&, const double&, const double&, const EEventType& eType) const;
     virtual PairEventData RoughSpheresColl(const IntEvent& event, const double& e, const double& et, const double& d1, const double& d2, const EEventType& eType) const;
     virtual std::pair<double, Dynamics::TriangleIntersectingPart>  getSphereTriangleEvent(const Particle& part, const Vector & A, const Vector & B, const Vector & C, const double dist) const;
+    virtual double getBoxEntryTime(const Particle&, const Vector&, const Vector&) const;
     virtual ParticleEventData runPlaneEvent(Particle&, const Vector &, const double&, double) const;
 
     void setGravityVector(Vector newg) {g = newg;}
+
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+    virtual void loadCheckpoint(CheckpointReader&);
+
+    virtual bool timeScaleInvariant() const { return false; }
+
   protected:
     double elasticV;
     Vector g;
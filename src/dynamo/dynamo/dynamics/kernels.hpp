@@ -0,0 +1,172 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/simulation.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/BC/PBC.hpp>
+#include <dynamo/BC/None.hpp>
+#include <magnet/intersection/ray_sphere.hpp>
+#include <typeinfo>
+#include <algorithm>
+#include <cmath>
+
+namespace dynamo {
+  /*! \brief Sphere-sphere event kernels for the Interaction-s, which
+    may be specialised to a Dynamics and BoundaryCondition.
+
+    The pair event tests of the sphere Interaction-s (IHardSphere,
+    ISquareWell and IStepped) are written as templates over one of
+    the kernels below. The GenericKernel calls the virtual functions
+    of the Dynamics (which in turn call the BoundaryCondition), and
+    works for any simulation. For the most common simulations
+    (DynNewtonian with periodic or no boundary conditions) the
+    NewtonianKernel is used instead, which lets the compiler inline
+    the minimum image and root calculations into the event loop.
+
+    The kernels must give results identical to the virtual functions
+    they replace.
+  */
+  namespace kernels {
+    //! \brief The available kernels, see selectKernel.
+    enum Type { GENERIC, NEWTONIAN_NOBC, NEWTONIAN_PERIODIC };
+
+    /*! \brief Selects the fastest kernel for the Dynamics and
+      BoundaryCondition of a Simulation.
+
+      The types must match exactly, as derived classes (e.g.,
+      DynCompression) change the behaviour of the functions.
+    */
+    inline Type selectKernel(const Simulation& sim)
+    {
+      if (!sim.dynamics || !sim.BCs || (typeid(*sim.dynamics) != typeid(DynNewtonian)))
+	return GENERIC;
+
+      if (typeid(*sim.BCs) == typeid(BCPeriodic))
+	return NEWTONIAN_PERIODIC;
+
+      if (typeid(*sim.BCs) == typeid(BCNone))
+	return NEWTONIAN_NOBC;
+
+      return GENERIC;
+    }
+
+    /*! \brief The batched DynNewtonian sphere-sphere in root.
+
+      The separation vectors of p1 and the particles \p ids are
+      gathered into structure-of-arrays blocks (the boundary
+      conditions must be applied pair by pair) and then handed to the
+      vectorised root finder. This is the implementation of both
+      DynNewtonian::SphereSphereInRoot(const Particle&, const size_t*,
+      const double*, double*, size_t) and
+      NewtonianKernel::sphereSphereInRoot.
+
+      \param applyBC A functor applying the boundary conditions to the
+      separation and relative velocity of a pair.
+    */
+    template<class ApplyBC>
+    inline void newtonianSphereSphereInRoot(const Simulation& sim, const Particle& p1, const size_t* ids, const double* d, double* dt, size_t N, const ApplyBC& applyBC)
+    {
+      const size_t blocksize = 64;
+      double Tx[blocksize], Ty[blocksize], Tz[blocksize], Dx[blocksize], Dy[blocksize], Dz[blocksize];
+
+      for (size_t start(0); start < N; start += blocksize)
+	{
+	  const size_t n = std::min(blocksize, N - start);
+	  for (size_t i(0); i < n; ++i)
+	    {
+	      const Particle& p2 = sim.particles[ids[start + i]];
+	      Vector r12 = p1.getPosition() - p2.getPosition();
+	      Vector v12 = p1.getVelocity() - p2.getVelocity();
+	      applyBC(r12, v12);
+	      Tx[i] = r12[0]; Ty[i] = r12[1]; Tz[i] = r12[2];
+	      Dx[i] = v12[0]; Dy[i] = v12[1]; Dz[i] = v12[2];
+	    }
+	  magnet::intersection::ray_sphere_bfc(Tx, Ty, Tz, Dx, Dy, Dz, d + start, dt + start, n);
+	}
+    }
+
+    //! \brief The minimum image convention of BCNone.
+    struct NoBC
+    {
+      NoBC(const Simulation&) {}
+      inline void operator()(Vector&) const {}
+    };
+
+    //! \brief The minimum image convention of BCPeriodic.
+    struct PeriodicBC
+    {
+      PeriodicBC(const Simulation& sim): _L(sim.primaryCellSize) {}
+
+      inline void operator()(Vector& pos) const
+      {
+	for (size_t n = 0; n < NDIM; ++n)
+	  pos[n] -= _L[n] * lrint(pos[n] / _L[n]);
+      }
+
+      const Vector _L;
+    };
+
+    //! \brief A kernel which uses the virtual functions of the Dynamics.
+    struct GenericKernel
+    {
+      GenericKernel(const Simulation& sim): _sim(sim) {}
+
+      inline void sphereSphereInRoot(const Particle& p1, const size_t* ids, const double* d, double* dt, size_t N) const
+      { _sim.dynamics->SphereSphereInRoot(p1, ids, d, dt, N); }
+
+      inline double sphereSphereOutRoot(const Particle& p1, const Particle& p2, double d) const
+      { return _sim.dynamics->SphereSphereOutRoot(p1, p2, d); }
+
+      inline double sphereOverlap(const Particle& p1, const Particle& p2, double d) const
+      { return _sim.dynamics->sphereOverlap(p1, p2, d); }
+
+      const Simulation& _sim;
+    };
+
+    //! \brief The DynNewtonian sphere functions for a particular boundary condition.
+    template<class BC>
+    struct NewtonianKernel
+    {
+      NewtonianKernel(const Simulation& sim): _sim(sim), _bc(sim) {}
+
+      //! \sa DynNewtonian::SphereSphereInRoot(const Particle&, const size_t*, const double*, double*, size_t)
+      inline void sphereSphereInRoot(const Particle& p1, const size_t* ids, const double* d, double* dt, size_t N) const
+      { newtonianSphereSphereInRoot(_sim, p1, ids, d, dt, N, [this](Vector& r12, Vector&) { _bc(r12); }); }
+
+      //! \sa DynNewtonian::SphereSphereOutRoot(const Particle&, const Particle&, double)
+      inline double sphereSphereOutRoot(const Particle& p1, const Particle& p2, double d) const
+      {
+	Vector r12 = p1.getPosition() - p2.getPosition();
+	const Vector v12 = p1.getVelocity() - p2.getVelocity();
+	_bc(r12);
+	return magnet::intersection::ray_inv_sphere_bfc(r12, v12, d);
+      }
+
+      //! \sa DynNewtonian::sphereOverlap
+      inline double sphereOverlap(const Particle& p1, const Particle& p2, double d) const
+      {
+	Vector r12 = p1.getPosition() - p2.getPosition();
+	_bc(r12);
+	return std::max(d - std::sqrt(r12 | r12), 0.0);
+      }
+
+      const Simulation& _sim;
+      const BC _bc;
+    };
+  }
+}
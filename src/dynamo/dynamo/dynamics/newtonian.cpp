@@ -17,6 +17,7 @@
 */
 
 #include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/dynamics/kernels.hpp>
 #include <dynamo/interactions/intEvent.hpp>
 #include <dynamo/2particleEventData.hpp>
 #include <dynamo/NparticleEventData.hpp>
@@ -81,6 +82,13 @@ namespace dynamo {
     return magnet::intersection::ray_sphere_bfc(r12, v12, d);
   }
   
+  void
+  DynNewtonian::SphereSphereInRoot(const Particle& p1, const size_t* ids, const double* d, double* dt, size_t N) const
+  {
+    kernels::newtonianSphereSphereInRoot(*Sim, p1, ids, d, dt, N,
+					 [this](Vector& r12, Vector& v12) { Sim->BCs->applyBC(r12, v12); });
+  }
+
   double
   DynNewtonian::SphereSphereOutRoot(const Particle& p1, const Particle& p2, double d) const
   {
@@ -230,6 +238,10 @@ namespace dynamo {
     return retval;
   }
 
+  double
+  DynNewtonian::getBoxEntryTime(const Particle& part, const Vector& origin, const Vector& width) const
+  { return magnet::intersection::ray_AAcube_entry(origin, part.getVelocity(), width); }
+
   ParticleEventData 
   DynNewtonian::runPlaneEvent(Particle& part, const Vector& vNorm, const double e, const double diameter) const
   {
@@ -722,6 +734,40 @@ namespace dynamo {
     return retVal;
   }
 
+  bool
+  DynNewtonian::timeScaleInvariant() const
+  {
+    for (const Particle& part : Sim->particles)
+      {
+	if (std::isinf(Sim->species[part]->getMass(part.getID())) && (part.getVelocity().nrm2() != 0))
+	  return false;
+
+	if (hasOrientationData() && std::isinf(Sim->species[part]->getScalarMomentOfInertia(part.getID()))
+	    && (getRotData(part).angularVelocity.nrm2() != 0))
+	  return false;
+      }
+
+    return true;
+  }
+
+  void
+  DynNewtonian::saveCheckpoint(CheckpointWriter& out) const
+  {
+    Dynamics::saveCheckpoint(out);
+    out.write(lastAbsoluteClock);
+    out.write(lastCollParticle1);
+    out.write(lastCollParticle2);
+  }
+
+  void
+  DynNewtonian::loadCheckpoint(CheckpointReader& in)
+  {
+    Dynamics::loadCheckpoint(in);
+    in.read(lastAbsoluteClock);
+    in.read(lastCollParticle1);
+    in.read(lastCollParticle2);
+  }
+
   void 
   DynNewtonian::outputXML(magnet::xml::XmlStream& XML) const
   {
@@ -36,6 +36,7 @@ namespace dynamo {
 
     virtual double SphereSphereInRoot(const Particle& p1, const Particle& p2, double d) const;
     virtual double SphereSphereInRoot(const IDRange& p1, const IDRange& p2, double d) const;
+    virtual void SphereSphereInRoot(const Particle& p1, const size_t* ids, const double* d, double* dt, size_t N) const;
     virtual double SphereSphereOutRoot(const Particle& p1, const Particle& p2, double d) const;
     virtual double SphereSphereOutRoot(const IDRange& p1, const IDRange& p2, double d) const;  
     virtual double sphereOverlap(const Particle& p1, const Particle& p2, const double& d) const;
@@ -53,6 +54,7 @@ namespace dynamo {
     virtual PairEventData SphereWellEvent(const IntEvent&, const double&, const double&, size_t) const;
     virtual double getPlaneEvent(const Particle&, const Vector &, const Vector &, double) const;
     virtual std::pair<double, Dynamics::TriangleIntersectingPart> getSphereTriangleEvent(const Particle& part, const Vector & A, const Vector & B, const Vector & C, const double dist) const;
+    virtual double getBoxEntryTime(const Particle&, const Vector&, const Vector&) const;
     virtual double getCylinderWallCollision(const Particle&, const Vector &, const Vector &, const double&) const;
     virtual ParticleEventData runCylinderWallCollision(Particle&, const Vector &, const Vector &, const double&) const;
     virtual ParticleEventData runPlaneEvent(Particle&, const Vector &, double, double) const;
@@ -68,6 +70,15 @@ namespace dynamo {
 
     virtual std::pair<bool, double> getOffcentreSpheresCollision(const double offset1, const double diameter1, const double offset2, const double diameter2, const Particle& p1, const Particle& p2, double t_max, double maxdist) const;
 
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+    virtual void loadCheckpoint(CheckpointReader&);
+
+    /*! \brief Free streaming is invariant to a rescaling of time,
+      unless a particle which is not rescaled (one with an infinite
+      mass or moment of inertia) is moving.
+     */
+    virtual bool timeScaleInvariant() const;
+
   protected:
     virtual void outputXML(magnet::xml::XmlStream&) const;
 
@@ -0,0 +1,344 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/exception.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+namespace dynamo {
+  /*! \brief The header at the start of an event log file.
+
+    An event log (a file ending in ".dyntraj", written by the
+    Trajectory output plugin) holds a record of every change a
+    simulation makes to the particles. It is laid out as:
+
+    - This 64 byte header.
+    - A sequence of chunks, each made of an EventLogChunkHeader
+      followed by the EventLogRecord-s of the chunk. If the log is
+      compressed, each chunk is compressed separately, so a log cut
+      short by a killed run is readable up to its last complete chunk.
+
+    All values are raw little-endian values, in the reduced units of
+    the simulation.
+  */
+  struct EventLogHeader
+  {
+    enum Compression { NONE = 0, ZLIB = 1, BZIP2 = 2 };
+
+    //! \brief Identifies the file type, always "DYNAMOT" followed by a null.
+    char magic[8];
+    //! \brief The version of the event log layout (see eventLogVersion).
+    uint32_t version;
+    //! \brief The value 0x01020304, used to detect the byte order.
+    uint32_t byteOrder;
+    //! \brief How the chunks are compressed, one of the Compression enum.
+    uint32_t compression;
+    //! \brief The size of an EventLogRecord, as a check on the layout.
+    uint32_t recordSize;
+    //! \brief The number of particles.
+    uint64_t N;
+    uint64_t reserved[4];
+  };
+
+  static_assert(sizeof(EventLogHeader) == 64, "The event log header must be exactly 64 bytes");
+
+  //! \brief The header of each chunk of records in an event log.
+  struct EventLogChunkHeader
+  {
+    //! \brief The number of records in the chunk.
+    uint64_t records;
+    //! \brief The number of bytes of (possibly compressed) data following this header.
+    uint64_t storedBytes;
+  };
+
+  static_assert(sizeof(EventLogChunkHeader) == 16, "The event log chunk header must be exactly 16 bytes");
+
+  /*! \brief The change made to one particle, or a pair of particles,
+      by an event.
+
+      Events which change several particles (e.g., a Global or System
+      event) are written as several records with the same eventCount.
+      Events which do not change any particles are written as a single
+      record with both particle IDs set to eventLogNoParticle.
+   */
+  struct EventLogRecord
+  {
+    //! \brief The Simulation::eventCount of the event.
+    uint64_t eventCount;
+    //! \brief The system time just after the event.
+    double time;
+    //! \brief The class of the event source, one of INTERACTION, GLOBAL, LOCAL or SYSTEM (see EEventType).
+    uint32_t sourceClass;
+    //! \brief The ID of the Interaction, Global, Local or System which caused the event.
+    uint32_t sourceID;
+    //! \brief The EEventType of the change.
+    uint32_t type;
+    uint32_t particle1;
+    //! \brief The second particle of a pair change, or eventLogNoParticle.
+    uint32_t particle2;
+    uint32_t padding;
+    //! \brief The momentum change of particle1 (particle2 receives the opposite).
+    double deltaP[3];
+    //! \brief The change in the kinetic energy of the particle(s).
+    double deltaKE;
+    //! \brief The change in the internal energy of the particle(s).
+    double deltaU;
+  };
+
+  static_assert(sizeof(EventLogRecord) == 80, "The event log records must be exactly 80 bytes");
+
+  //! \brief The current version of the event log layout.
+  static const uint32_t eventLogVersion = 1;
+
+  //! \brief The particle ID of a record which does not involve a particle.
+  static const uint32_t eventLogNoParticle = 0xFFFFFFFF;
+
+  //! \brief Converts the name of a compression type (None, Zlib or BZip2) to the enum.
+  inline EventLogHeader::Compression eventLogCompression(const std::string& name)
+  {
+    if (name == "None") return EventLogHeader::NONE;
+    if (name == "Zlib") return EventLogHeader::ZLIB;
+    if (name == "BZip2") return EventLogHeader::BZIP2;
+    M_throw() << "Unknown event log compression \"" << name << "\", the options are None, Zlib or BZip2";
+  }
+
+  /*! \brief Writes an event log file.
+
+    Records are collected into chunks, which are compressed and
+    written once full. The file is only complete once the destructor
+    has run, or flush has been called.
+  */
+  class EventLogWriter
+  {
+  public:
+    EventLogWriter(const std::string& fileName, size_t N, EventLogHeader::Compression compression, size_t chunkSize):
+      _fileName(fileName),
+      _out(fileName.c_str(), std::ios::binary | std::ios::out | std::ios::trunc),
+      _compression(compression)
+    {
+      if (!_out)
+	M_throw() << "Could not open " << fileName << " for writing";
+
+      const uint32_t test = 1;
+      if (*reinterpret_cast<const unsigned char*>(&test) != 1)
+	M_throw() << "Event logs can only be written on little-endian machines";
+
+      EventLogHeader header;
+      std::memset(&header, 0, sizeof(header));
+      std::memcpy(header.magic, "DYNAMOT", 8);
+      header.version = eventLogVersion;
+      header.byteOrder = 0x01020304;
+      header.compression = compression;
+      header.recordSize = sizeof(EventLogRecord);
+      header.N = N;
+      writeBytes(&header, sizeof(header));
+
+      _chunk.reserve(std::max(chunkSize, size_t(1)));
+    }
+
+    ~EventLogWriter()
+    {
+      try { flush(); }
+      catch (...) {}
+    }
+
+    void push(const EventLogRecord& record)
+    {
+      _chunk.push_back(record);
+      if (_chunk.size() == _chunk.capacity())
+	flush();
+    }
+
+    //! \brief Writes the current chunk, so the file holds every pushed record.
+    void flush()
+    {
+      if (_chunk.empty()) return;
+
+      const char* raw = reinterpret_cast<const char*>(_chunk.data());
+      const size_t rawBytes = _chunk.size() * sizeof(EventLogRecord);
+
+      EventLogChunkHeader header;
+      header.records = _chunk.size();
+
+      if (_compression == EventLogHeader::NONE)
+	{
+	  header.storedBytes = rawBytes;
+	  writeBytes(&header, sizeof(header));
+	  writeBytes(raw, rawBytes);
+	}
+      else
+	{
+	  namespace io = boost::iostreams;
+	  _compressed.clear();
+	  {
+	    io::filtering_ostream compressor;
+	    if (_compression == EventLogHeader::ZLIB)
+	      compressor.push(io::zlib_compressor());
+	    else
+	      compressor.push(io::bzip2_compressor());
+	    compressor.push(io::back_inserter(_compressed));
+	    compressor.write(raw, rawBytes);
+	  }
+	  header.storedBytes = _compressed.size();
+	  writeBytes(&header, sizeof(header));
+	  writeBytes(_compressed.data(), _compressed.size());
+	}
+
+      _out.flush();
+      _chunk.clear();
+    }
+
+  private:
+    void writeBytes(const void* data, size_t bytes)
+    {
+      _out.write(static_cast<const char*>(data), bytes);
+      if (!_out)
+	M_throw() << "Failed while writing the event log " << _fileName;
+    }
+
+    std::string _fileName;
+    std::ofstream _out;
+    EventLogHeader::Compression _compression;
+    std::vector<EventLogRecord> _chunk;
+    std::vector<char> _compressed;
+  };
+
+  /*! \brief Reads an event log file written by EventLogWriter, one
+      chunk at a time.
+   */
+  class EventLogReader
+  {
+  public:
+    EventLogReader(const std::string& fileName):
+      _fileName(fileName),
+      _in(fileName.c_str(), std::ios::binary),
+      _next(0)
+    {
+      if (!_in)
+	M_throw() << "Could not open the event log " << fileName;
+
+      if (!_in.read(reinterpret_cast<char*>(&_header), sizeof(_header)))
+	M_throw() << fileName << " is too small to be an event log";
+
+      if (std::memcmp(_header.magic, "DYNAMOT", 8))
+	M_throw() << fileName << " is not an event log";
+
+      if (_header.byteOrder != 0x01020304)
+	M_throw() << fileName << " was written with a different byte order to this machine";
+
+      if (_header.version != eventLogVersion)
+	M_throw() << fileName << " is version " << _header.version
+		  << " of the event log format, only version " << eventLogVersion << " is supported";
+
+      if (_header.recordSize != sizeof(EventLogRecord))
+	M_throw() << fileName << " has records of " << _header.recordSize << " bytes, expected " << sizeof(EventLogRecord);
+
+      if (_header.compression > EventLogHeader::BZIP2)
+	M_throw() << fileName << " uses an unknown compression type (" << _header.compression << ")";
+    }
+
+    const EventLogHeader& getHeader() const { return _header; }
+
+    /*! \brief Reads the next chunk of records.
+
+      \returns false once the end of the file is reached.
+     */
+    bool readChunk(std::vector<EventLogRecord>& records)
+    {
+      EventLogChunkHeader header;
+      if (!_in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+	{
+	  if (_in.gcount())
+	    M_throw() << "The event log " << _fileName << " is truncated";
+	  return false;
+	}
+
+      const size_t rawBytes = header.records * sizeof(EventLogRecord);
+      records.resize(header.records);
+      char* raw = reinterpret_cast<char*>(records.data());
+
+      if (_header.compression == EventLogHeader::NONE)
+	{
+	  if (header.storedBytes != rawBytes)
+	    M_throw() << "The event log " << _fileName << " is corrupt, a chunk has the wrong size";
+	  readBytes(raw, rawBytes);
+	  return true;
+	}
+
+      _compressed.resize(header.storedBytes);
+      readBytes(_compressed.data(), _compressed.size());
+
+      namespace io = boost::iostreams;
+      io::filtering_istream decompressor;
+      if (_header.compression == EventLogHeader::ZLIB)
+	decompressor.push(io::zlib_decompressor());
+      else
+	decompressor.push(io::bzip2_decompressor());
+      decompressor.push(io::array_source(_compressed.data(), _compressed.size()));
+
+      decompressor.read(raw, rawBytes);
+      if (size_t(decompressor.gcount()) != rawBytes)
+	M_throw() << "The event log " << _fileName << " is corrupt, a chunk could not be decompressed";
+
+      return true;
+    }
+
+    /*! \brief Reads the next record.
+
+      \returns false once the end of the file is reached.
+     */
+    bool next(EventLogRecord& record)
+    {
+      while (_next == _records.size())
+	{
+	  _next = 0;
+	  if (!readChunk(_records))
+	    {
+	      _records.clear();
+	      return false;
+	    }
+	}
+
+      record = _records[_next++];
+      return true;
+    }
+
+  private:
+    void readBytes(char* data, size_t bytes)
+    {
+      if (!_in.read(data, bytes))
+	M_throw() << "The event log " << _fileName << " is truncated";
+    }
+
+    std::string _fileName;
+    std::ifstream _in;
+    EventLogHeader _header;
+    std::vector<EventLogRecord> _records;
+    std::vector<char> _compressed;
+    size_t _next;
+  };
+}
@@ -86,8 +86,7 @@ namespace dynamo {
   
     (*Sim->_sigParticleUpdate)(EDat);
 
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    Sim->signalEvent(iEvent, EDat);
 
     Sim->ptrScheduler->fullUpdate(part);
   }
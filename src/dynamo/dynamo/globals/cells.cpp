@@ -23,6 +23,8 @@
 #include <dynamo/ranges/IDRangeAll.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/BC/LEBC.hpp>
+#include <dynamo/dynamics/compression.hpp>
+#include <dynamo/locals/local.hpp>
 #include <dynamo/ranges/IDRangeList.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
@@ -40,7 +42,12 @@ namespace dynamo {
     cellDimension(1,1,1),
     _oversizeCells(1.0),
     NCells(0),
-    overlink(overlink)
+    overlink(overlink),
+    _dense(true),
+    _sortLocals(true),
+    _localsInCells(false),
+    _cellCapacity(0),
+    _maxCellCapacity(0)
   {
     globName = name;
     dout << "Cells Loaded" << std::endl;
@@ -51,7 +58,12 @@ namespace dynamo {
     cellDimension(1,1,1),
     _oversizeCells(1.0),
     NCells(0),
-    overlink(1)
+    overlink(1),
+    _dense(true),
+    _sortLocals(true),
+    _localsInCells(false),
+    _cellCapacity(0),
+    _maxCellCapacity(0)
   {
     operator<<(XML);
 
@@ -73,6 +85,21 @@ namespace dynamo {
     
     if (_oversizeCells < 1.0)
       M_throw() << "You must specify an Oversize greater than 1.0, otherwise your cells are too small!";
+
+    if (XML.hasAttribute("Storage"))
+      {
+	_storage = XML.getAttribute("Storage").getValue();
+	if (!_storage.compare("Dense"))
+	  _dense = true;
+	else if (!_storage.compare("Sparse"))
+	  _dense = false;
+	else
+	  M_throw() << "Unknown cell Storage type \"" << _storage
+		    << "\", valid types are \"Dense\" and \"Sparse\"";
+      }
+
+    if (XML.hasAttribute("SortLocals"))
+      _sortLocals = XML.getAttribute("SortLocals").as<bool>();
     
     globName = XML.getAttribute("Name");
     
@@ -94,16 +121,16 @@ namespace dynamo {
 
     if (verbose)
       {
-	Vector cellPos = calcPosition(partCellData[part.getID()], part);
+	Vector cellPos = calcPosition(getCell(part.getID()), part);
 	Vector relpos = part.getPosition() - cellPos;
 	Sim->BCs->applyBC(relpos);
 	derr 
-	  << "Calculating event for particle " << part.getID() << " in Cell " << magnet::math::MortonNumber<3>(partCellData[part.getID()]).toString()
+	  << "Calculating event for particle " << part.getID() << " in Cell " << magnet::math::MortonNumber<3>(getCell(part.getID())).toString()
 	  << "\nParticle pos = " << part.getPosition().toString()
 	  << "\nCell pos = " << cellPos.toString()
 	  << "\nRelpos = " << relpos.toString()
 	  << "\nCell size = " << cellDimension.toString()
-	  << "\nTime = " << Sim->dynamics->getSquareCellCollision2(part, calcPosition(partCellData[part.getID()], part),
+	  << "\nTime = " << Sim->dynamics->getSquareCellCollision2(part, calcPosition(getCell(part.getID()), part),
 								   cellDimension) - Sim->dynamics->getParticleDelay(part)
 	  << "\nDelay = " << Sim->dynamics->getParticleDelay(part)
 	  << std::endl;
@@ -113,7 +140,7 @@ namespace dynamo {
 		       Sim->dynamics->
 		       getSquareCellCollision2
 		       (part, 
-			calcPosition(partCellData[part.getID()], part), 
+			calcPosition(getCell(part.getID()), part), 
 			cellDimension)
 		       -Sim->dynamics->getParticleDelay(part),
 		       CELL, *this);
@@ -128,9 +155,7 @@ namespace dynamo {
     //expect the particle to be up to date.
     Sim->dynamics->updateParticle(part);
 
-    std::unordered_map<size_t, size_t>::iterator it = partCellData.find(part.getID());
-
-    const size_t oldCell(it->second);
+    const size_t oldCell(getCell(part.getID()));
 
     size_t endCell;
 
@@ -167,7 +192,7 @@ namespace dynamo {
       endCell = dendCell.getMortonNum();
     }
 
-    removeFromCellwIt(part.getID(), it);
+    removeFromCell(part.getID());
     addToCell(part.getID(), endCell);
 
     //Get rid of the virtual event we're running, an updated event is
@@ -196,7 +221,7 @@ namespace dynamo {
 	  {
 	    newNBCell[dim1] %= cellCount[dim1];
 	    
-	    for (const size_t& next : list[newNBCell.getMortonNum()])
+	    for (const size_t& next : getCellContents(newNBCell.getMortonNum()))
 	      _sigNewNeighbour(part, next);
 	  
 	    ++newNBCell[dim1];
@@ -205,6 +230,8 @@ namespace dynamo {
 	newNBCell[dim1] = saved_coord; 
 	++newNBCell[dim2];
       }
+
+    signalNewLocals(part, oldCell);
   
     //Push the next virtual event, this is the reason the scheduler
     //doesn't need a second callback
@@ -239,7 +266,7 @@ namespace dynamo {
 
     reinitialise();
 
-    dout << "Neighbourlist contains " << partCellData.size() 
+    dout << "Neighbourlist contains " << getParticleCount()
 	 << " particle entries"
 	 << std::endl;
   }
@@ -262,6 +289,63 @@ namespace dynamo {
       Sim->ptrScheduler->initialise();
   }
 
+  void
+  GCells::saveCheckpoint(CheckpointWriter& out) const
+  {
+    out.write(NCells);
+    out.write(_dense);
+    if (_dense)
+      {
+	out.write(_cellCapacity);
+	out.write(_cellData);
+	out.write(_cellSlot);
+	out.write(_cellSlots);
+	out.write(_cellOccupancy);
+	return;
+      }
+
+    for (const std::vector<size_t>& cell : list)
+      out.write(cell);
+  }
+
+  void
+  GCells::loadCheckpoint(CheckpointReader& in)
+  {
+    size_t storedNCells;
+    bool dense;
+    in.read(storedNCells);
+    in.read(dense);
+
+    //The run may have switched to the sparse store after the cells
+    //overflowed (see growCells)
+    if (_dense && !dense)
+      useSparseStore();
+
+    if ((storedNCells != NCells) || (dense != _dense))
+      M_throw() << "The cells of " << globName << " in the checkpoint (" << storedNCells << (dense ? " dense" : " sparse")
+		<< ") do not match the simulation (" << NCells << (_dense ? " dense" : " sparse") << ")";
+
+    if (_dense)
+      {
+	in.read(_cellCapacity);
+	in.read(_cellData);
+	in.read(_cellSlot);
+	in.read(_cellSlots);
+	in.read(_cellOccupancy);
+	return;
+      }
+
+    //The order of the particles in each cell sets the order in
+    //which the neighbours are visited, so it is restored exactly
+    partCellData.clear();
+    for (size_t cellID(0); cellID < list.size(); ++cellID)
+      {
+	in.read(list[cellID]);
+	for (const size_t ID : list[cellID])
+	  partCellData[ID] = cellID;
+      }
+  }
+
   void
   GCells::outputXML(magnet::xml::XmlStream& XML) const
   { 
@@ -273,6 +357,10 @@ namespace dynamo {
     
     if (overlink > 1)   XML << magnet::xml::attr("OverLink") << overlink;
     if (_oversizeCells != 1.0) XML << magnet::xml::attr("Oversize") << _oversizeCells;
+    //The switch to the sparse store after an overflow (see growCells)
+    //is only recorded in the checkpoint, not in the configuration
+    if (!_storage.empty()) XML << magnet::xml::attr("Storage") << _storage;
+    if (!_sortLocals) XML << magnet::xml::attr("SortLocals") << _sortLocals;
     
     XML << range
 	<< magnet::xml::endtag("Global");
@@ -283,6 +371,10 @@ namespace dynamo {
   {
     list.clear();
     partCellData.clear();
+    _cellData.clear();
+    _cellSlot.clear();
+    _cellSlots.clear();
+    _cellOccupancy.clear();
     NCells = 1;
 
     for (size_t iDim = 0; iDim < NDIM; iDim++)
@@ -309,7 +401,19 @@ namespace dynamo {
     magnet::math::MortonNumber<3> coords(cellCount[0], cellCount[1], cellCount[2]);
     size_t sizeReq = coords.getMortonNum();
 
-    list.resize(sizeReq); //Empty Cells created!
+    if (_dense)
+      {
+	//Start with twice the average cell occupancy, the store is
+	//grown if any cell overflows this
+	_cellCapacity = std::max(size_t(4), 2 * (range->size() / NCells + 1));
+	_maxCellCapacity = 4 * _cellCapacity;
+	_cellSlots.resize(sizeReq * _cellCapacity);
+	_cellOccupancy.resize(sizeReq, 0); //Empty Cells created!
+	_cellData.resize(Sim->N, std::numeric_limits<size_t>::max());
+	_cellSlot.resize(Sim->N);
+      }
+    else
+      list.resize(sizeReq); //Empty Cells created!
 
     dout << "Cells <x,y,z> " << cellCount[0] << ","
 	 << cellCount[1] << "," << cellCount[2]
@@ -346,8 +450,7 @@ namespace dynamo {
 	addToCell(id);
 	if (verbose)
 	  {
-	    std::unordered_map<size_t, size_t>::iterator it = partCellData.find(id);
-	    magnet::math::MortonNumber<3> currentCell(it->second);
+	    magnet::math::MortonNumber<3> currentCell(getCell(id));
 	    
 	    magnet::math::MortonNumber<3> estCell(getCellID(Sim->particles[ID].getPosition()));
 	  
@@ -364,7 +467,7 @@ namespace dynamo {
 		 << "," << currentCell[1].getRealValue()
 		 << "," << currentCell[2].getRealValue()
 		 << ">"
-		 << "\nParticle is at this distance " << Vector(p.getPosition() - calcPosition(it->second, p)).toString() << " from the cell origin"
+		 << "\nParticle is at this distance " << Vector(p.getPosition() - calcPosition(getCell(id), p)).toString() << " from the cell origin"
 		 << "\nParticle position  " << p.getPosition().toString()	
 		 << "\nParticle wrapped distance  " << wrapped_pos.toString()	
 		 << "\nParticle relative position  " << origin_pos.toString()
@@ -376,8 +479,152 @@ namespace dynamo {
 	  }
       }
 
-    dout << "Cell loading " << float(partCellData.size()) / NCells 
+    dout << "Cell loading " << float(getParticleCount()) / NCells 
 	 << std::endl;
+
+    buildCellLocals();
+  }
+
+  void
+  GCells::buildCellLocals()
+  {
+    _cellLocalStart.clear();
+    _cellLocals.clear();
+
+    _localsInCells = _sortLocals && !Sim->locals.empty()
+      && !std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs)
+      && !std::dynamic_pointer_cast<DynCompression>(Sim->dynamics);
+
+    if (!_localsInCells) return;
+
+    //A dimension is periodic if the boundary conditions wrap a
+    //vector across it
+    for (size_t iDim(0); iDim < NDIM; ++iDim)
+      {
+	Vector probe(0, 0, 0);
+	probe[iDim] = 0.75 * Sim->primaryCellSize[iDim];
+	Sim->BCs->applyBC(probe);
+	_localBounds[iDim] = (probe[iDim] == 0.75 * Sim->primaryCellSize[iDim]) ? Sim->primaryCellSize[iDim] : HUGE_VAL;
+      }
+
+    const size_t sizeReq = magnet::math::MortonNumber<3>(cellCount[0], cellCount[1], cellCount[2]).getMortonNum();
+    std::vector<size_t> counts(sizeReq, 0);
+    std::vector<std::vector<size_t> > localCells(Sim->locals.size());
+    std::vector<char> inCell(sizeReq);
+    for (const shared_ptr<Local>& local : Sim->locals)
+      {
+	std::fill(inCell.begin(), inCell.end(), false);
+
+	//Test the cells against every image of the Local which a
+	//particle within the bounds can reach
+	std::array<long, 3> k = {{-1, -1, -1}};
+	for (k[0] = -1; k[0] <= 1; ++k[0])
+	  for (k[1] = -1; k[1] <= 1; ++k[1])
+	    for (k[2] = -1; k[2] <= 1; ++k[2])
+	      {
+		Vector shift;
+		for (size_t iDim(0); iDim < NDIM; ++iDim)
+		  shift[iDim] = k[iDim] * Sim->primaryCellSize[iDim];
+		addLocalToCells(*local, {{0, 0, 0}}, {{cellCount[0], cellCount[1], cellCount[2]}}, shift, inCell);
+	      }
+
+	for (size_t cellID(0); cellID < sizeReq; ++cellID)
+	  if (inCell[cellID])
+	    {
+	      localCells[local->getID()].push_back(cellID);
+	      ++counts[cellID];
+	    }
+      }
+
+    _cellLocalStart.resize(sizeReq + 1, 0);
+    for (size_t cellID(0); cellID < sizeReq; ++cellID)
+      _cellLocalStart[cellID + 1] = _cellLocalStart[cellID] + counts[cellID];
+
+    //Fill the cells in Local order, so each cell's Locals are sorted
+    _cellLocals.resize(_cellLocalStart.back());
+    std::fill(counts.begin(), counts.end(), 0);
+    for (size_t localID(0); localID < localCells.size(); ++localID)
+      for (const size_t cellID : localCells[localID])
+	_cellLocals[_cellLocalStart[cellID] + counts[cellID]++] = localID;
+
+    dout << "Locals per cell " << double(_cellLocals.size()) / NCells
+	 << " (of " << Sim->locals.size() << " Locals)" << std::endl;
+  }
+
+  void
+  GCells::addLocalToCells(const Local& local, std::array<size_t, 3> lo, std::array<size_t, 3> hi,
+			  const Vector& shift, std::vector<char>& inCell) const
+  {
+    //The box of the cells, expanded slightly to cover rounding
+    //errors in the cell transitions
+    Vector origin, width;
+    for (size_t iDim(0); iDim < NDIM; ++iDim)
+      {
+	const double margin = 0.01 * cellLatticeWidth[iDim];
+	origin[iDim] = lo[iDim] * cellLatticeWidth[iDim] - 0.5 * Sim->primaryCellSize[iDim] 
+	  + cellOffset[iDim] + shift[iDim] - margin;
+	width[iDim] = (hi[iDim] - lo[iDim] - 1) * cellLatticeWidth[iDim] + cellDimension[iDim] + 2 * margin;
+      }
+
+    if (!local.isInCell(origin, width)) return;
+
+    size_t split(0);
+    for (size_t iDim(1); iDim < NDIM; ++iDim)
+      if (hi[iDim] - lo[iDim] > hi[split] - lo[split])
+	split = iDim;
+
+    if (hi[split] - lo[split] == 1)
+      {
+	inCell[magnet::math::MortonNumber<3>(lo[0], lo[1], lo[2]).getMortonNum()] = true;
+	return;
+      }
+
+    std::array<size_t, 3> mid = hi;
+    mid[split] = (lo[split] + hi[split]) / 2;
+    addLocalToCells(local, lo, mid, shift, inCell);
+    std::array<size_t, 3> midlo = lo;
+    midlo[split] = mid[split];
+    addLocalToCells(local, midlo, hi, shift, inCell);
+  }
+
+  std::unique_ptr<IDRange>
+  GCells::getParticleLocals(const Particle& part) const
+  {
+    if (!_localsInCells || !inLocalBounds(part.getPosition()))
+      return GNeighbourList::getParticleLocals(part);
+
+    const size_t cellID = getCell(part.getID());
+    IDRangeList* retval = new IDRangeList;
+    retval->getContainer().assign(_cellLocals.begin() + _cellLocalStart[cellID],
+				  _cellLocals.begin() + _cellLocalStart[cellID + 1]);
+    return std::unique_ptr<IDRange>(retval);
+  }
+
+  void
+  GCells::signalNewLocals(const Particle& part, size_t oldCell) const
+  {
+    if (!_localsInCells) return;
+
+    //The particle already has the events of at least the Locals of
+    //its old cell
+    const size_t* oldBegin = _cellLocals.data() + _cellLocalStart[oldCell];
+    const size_t* oldEnd = _cellLocals.data() + _cellLocalStart[oldCell + 1];
+
+    //Outside of the bounds the particle may reach any Local. Some of
+    //these events may already be scheduled, but the duplicates are
+    //removed when the particle's events are next rebuilt.
+    if (!inLocalBounds(part.getPosition()))
+      {
+	for (size_t localID(0); localID < Sim->locals.size(); ++localID)
+	  if (!std::binary_search(oldBegin, oldEnd, localID))
+	    _sigNewLocal(part, localID);
+	return;
+      }
+
+    const size_t newCell = getCell(part.getID());
+    for (size_t i(_cellLocalStart[newCell]); i < _cellLocalStart[newCell + 1]; ++i)
+      if (!std::binary_search(oldBegin, oldEnd, _cellLocals[i]))
+	_sigNewLocal(part, _cellLocals[i]);
   }
 
   magnet::math::MortonNumber<3>
@@ -429,7 +676,7 @@ namespace dynamo {
 	      {
 		coords[2] = (zero_coords[2].getRealValue() + z) % cellCount[2];
 
-		const std::vector<size_t>&  nlist = list[coords.getMortonNum()];
+		const CellContents nlist = getCellContents(coords.getMortonNum());
 		retval.getContainer().insert(retval.getContainer().end(), nlist.begin(), nlist.end());
 	      }
 	  }
@@ -441,7 +688,7 @@ namespace dynamo {
   IDRangeList
   GCells::getParticleNeighbours(const Particle& part) const
   {
-    return getParticleNeighbours(partCellData[part.getID()]);
+    return getParticleNeighbours(getCell(part.getID()));
   }
 
   IDRangeList
@@ -450,6 +697,62 @@ namespace dynamo {
     return getParticleNeighbours(getCellID(vec));
   }
 
+  size_t
+  GCells::getParticleCount() const
+  {
+    if (!_dense) return partCellData.size();
+
+    size_t count(0);
+    for (const size_t occupancy : _cellOccupancy)
+      count += occupancy;
+    return count;
+  }
+
+  void
+  GCells::growCells() const
+  {
+    const size_t newCapacity = 2 * _cellCapacity;
+    if (newCapacity > _maxCellCapacity)
+      {
+	useSparseStore();
+	return;
+      }
+
+    std::vector<size_t> newSlots(_cellOccupancy.size() * newCapacity);
+
+    for (size_t cellID(0); cellID < _cellOccupancy.size(); ++cellID)
+      std::copy(_cellSlots.begin() + cellID * _cellCapacity,
+		_cellSlots.begin() + cellID * _cellCapacity + _cellOccupancy[cellID],
+		newSlots.begin() + cellID * newCapacity);
+
+    _cellSlots.swap(newSlots);
+    _cellCapacity = newCapacity;
+  }
+
+  void
+  GCells::useSparseStore() const
+  {
+    dout << "A cell of " << globName << " holds more than " << _cellCapacity
+	 << " particles, switching to the sparse cell store" << std::endl;
+
+    list.assign(_cellOccupancy.size(), std::vector<size_t>());
+    partCellData.clear();
+    for (size_t cellID(0); cellID < _cellOccupancy.size(); ++cellID)
+      {
+	const CellContents contents = getCellContents(cellID);
+	list[cellID].assign(contents.begin(), contents.end());
+	for (const size_t ID : contents)
+	  partCellData[ID] = cellID;
+      }
+
+    std::vector<size_t>().swap(_cellData);
+    std::vector<size_t>().swap(_cellSlot);
+    std::vector<size_t>().swap(_cellSlots);
+    std::vector<size_t>().swap(_cellOccupancy);
+    _cellCapacity = 0;
+    _dense = false;
+  }
+
   double 
   GCells::getMaxSupportedInteractionLength() const
   {
@@ -20,7 +20,9 @@
 #include <dynamo/particle.hpp>
 #include <magnet/math/morton_number.hpp>
 #include <unordered_map>
+#include <array>
 #include <vector>
+#include <limits>
 
 namespace dynamo {
   /*! \brief A regular cell neighbour list implementation.
@@ -40,10 +42,32 @@ namespace dynamo {
     events where particles rapidly pass between two cells.
 
     The second property is that the contents of each cell is stored as
-    a std::vector. In theory, a linked list is far more memory
-    efficient however, the vector is much more cache friendly and can
+    a contiguous array. In theory, a linked list is far more memory
+    efficient however, the array is much more cache friendly and can
     boost performance by 50% in cases where the cell has multiple
     particles inside of it.
+
+    Two storage layouts are available, selected by the Storage
+    attribute of the XML node. The default "Dense" layout keeps a
+    per-particle array of cell and slot indices, and stores the cell
+    contents in a single flat array with a fixed capacity per cell.
+    Moving a particle between cells is then a pair of array writes.
+    The capacity of every cell is doubled when one cell overflows, up
+    to eight times the mean cell occupancy; if a cell overflows
+    beyond this (e.g., in a strongly clustered system) the dense store
+    would waste most of its memory, so the neighbour list switches to
+    the sparse layout for the rest of the run. This switch is saved in
+    checkpoints but not in the configuration, which keeps the Storage
+    it was loaded with. The "Sparse" layout stores a
+    std::vector per cell and an unordered_map from the particle ID to
+    its cell, so its memory is proportional to the number of particles
+    in the neighbour list rather than the number in the simulation.
+
+    The \ref Local "Locals" are also sorted into the cells, using
+    Local::isInCell on the box of each cell (see
+    buildCellLocals). A particle then only tests the Locals it can
+    reach from its current cell, and the Locals it can newly reach
+    are signalled through _sigNewLocal when it changes cell.
    */
   class GCells: public GNeighbourList
   {
@@ -61,8 +85,13 @@ namespace dynamo {
 
     virtual void reinitialise();
 
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+    virtual void loadCheckpoint(CheckpointReader&);
+
     virtual IDRangeList getParticleNeighbours(const Particle&) const;
     virtual IDRangeList getParticleNeighbours(const Vector&) const;
+
+    virtual std::unique_ptr<IDRange> getParticleLocals(const Particle&) const;
     
     virtual void operator<<(const magnet::xml::Node&);
 
@@ -84,16 +113,99 @@ namespace dynamo {
     size_t NCells;
     size_t overlink;
 
-    //! \brief The list of particles in each cell.
+    //! \brief If the dense cell store is used (see \ref GCells).
+    mutable bool _dense;
+
+    //! \brief The Storage attribute of the XML node, empty if it was not set.
+    std::string _storage;
+
+    //! \brief If the Locals may be sorted into the cells (the SortLocals attribute).
+    bool _sortLocals;
+    //! \brief If the Locals are sorted into the cells (see buildCellLocals).
+    bool _localsInCells;
+    /*! \brief The bounds on the particle coordinates for which the
+        Locals of the cells are valid.
+
+	This is infinite in the periodic dimensions.
+     */
+    Vector _localBounds;
+    /*! \brief The start of the Locals of each cell in \ref
+        _cellLocals, indexed by the Morton number of the cell.
+     */
+    std::vector<size_t> _cellLocalStart;
+    //! \brief The IDs of the Locals in each cell, in ascending order.
+    std::vector<size_t> _cellLocals;
+
+    //! \brief The list of particles in each cell (sparse store).
     mutable std::vector<std::vector<size_t> > list;
 
-    /*! \brief The cell for a given particle.
+    /*! \brief The cell for a given particle (sparse store).
       
       This container is an unordered map, so we only store the linked
       list for the particles actually inserted into this neighborlist.
      */
     mutable std::unordered_map<size_t, size_t> partCellData;
 
+    //! \brief The cell of each particle, indexed by ID (dense store).
+    mutable std::vector<size_t> _cellData;
+    //! \brief The slot each particle occupies in its cell (dense store).
+    mutable std::vector<size_t> _cellSlot;
+    /*! \brief The contents of all cells (dense store).
+      
+      Cell \f$i\f$ occupies the range
+      \f$[i\,C,\,i\,C + n_i)\f$ where \f$C\f$ is the \ref
+      _cellCapacity and \f$n_i\f$ is the \ref _cellOccupancy of the
+      cell.
+     */
+    mutable std::vector<size_t> _cellSlots;
+    //! \brief The number of particles in each cell (dense store).
+    mutable std::vector<size_t> _cellOccupancy;
+    //! \brief The number of slots allocated to each cell (dense store).
+    mutable size_t _cellCapacity;
+    //! \brief The capacity above which the sparse store is used instead.
+    size_t _maxCellCapacity;
+
+    /*! \brief A lightweight range over the IDs of the particles in a
+        cell, valid until the cell contents are next modified.
+     */
+    struct CellContents
+    {
+      CellContents(const size_t* begin, const size_t* end): _begin(begin), _end(end) {}
+      const size_t* begin() const { return _begin; }
+      const size_t* end() const { return _end; }
+      size_t size() const { return _end - _begin; }
+    private:
+      const size_t* _begin;
+      const size_t* _end;
+    };
+
+    inline CellContents getCellContents(size_t cellID) const
+    {
+      if (_dense)
+	{
+	  const size_t* begin = _cellSlots.data() + cellID * _cellCapacity;
+	  return CellContents(begin, begin + _cellOccupancy[cellID]);
+	}
+
+      return CellContents(list[cellID].data(), list[cellID].data() + list[cellID].size());
+    }
+
+    //! \brief The ID of the cell which a particle is stored in.
+    inline size_t getCell(size_t ID) const
+    { return _dense ? _cellData[ID] : partCellData[ID]; }
+
+    //! \brief The number of particles stored in the cells.
+    size_t getParticleCount() const;
+
+    /*! \brief Doubles the capacity of every cell in the dense store,
+        or switches to the sparse store if this would exceed \ref
+        _maxCellCapacity.
+     */
+    void growCells() const;
+
+    //! \brief Moves the contents of the dense store into the sparse store.
+    void useSparseStore() const;
+
     GCells(const GCells&);
 
     virtual void outputXML(magnet::xml::XmlStream&) const;
@@ -102,6 +214,42 @@ namespace dynamo {
 
     void addCells(double);
 
+    /*! \brief Sorts the Locals into the cells.
+
+      A Local is stored in a cell if Local::isInCell is true for the
+      box of the cell, or any of its periodic images, so a particle
+      only needs the Locals of its own cell. In the non-periodic
+      dimensions the cells also hold the particles outside of the
+      primary image, so the images are only tested for a particle
+      within one system width of the origin (see _localBounds). All
+      of the Locals are returned for particles outside of this
+      region.
+
+      The Locals are not sorted for Lees-Edwards boundary conditions,
+      where the images are sheared, or for compressing systems, where
+      the reach of the Locals grows. Sorting can also be turned off
+      with SortLocals="0", so every particle tests every Local.
+     */
+    void buildCellLocals();
+
+    //! \brief Recursively adds a Local to the cells in the box [lo, hi) which it is in.
+    void addLocalToCells(const Local&, std::array<size_t, 3> lo, std::array<size_t, 3> hi,
+			 const Vector& shift, std::vector<char>& inCell) const;
+
+    //! \brief If the Locals of the cells are valid for a particle at this position.
+    inline bool inLocalBounds(const Vector& pos) const
+    {
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	if (std::abs(pos[iDim]) > _localBounds[iDim])
+	  return false;
+      return true;
+    }
+
+    /*! \brief Signals the Locals which a particle can reach from its
+        new cell but not from its old one.
+     */
+    void signalNewLocals(const Particle&, size_t oldCell) const;
+
     inline Vector calcPosition(const magnet::math::MortonNumber<3>& coords,
 			       const Particle& part) const;
 
@@ -112,12 +260,43 @@ namespace dynamo {
 
     inline void addToCell(size_t ID, size_t cellID) const
     {
+      if (_dense && (_cellOccupancy[cellID] == _cellCapacity))
+	growCells();
+
+      if (_dense)
+	{
+	  const size_t slot = _cellOccupancy[cellID]++;
+	  _cellSlots[cellID * _cellCapacity + slot] = ID;
+	  _cellSlot[ID] = slot;
+	  _cellData[ID] = cellID;
+	  return;
+	}
+
       list[cellID].push_back(ID);
       partCellData[ID] = cellID;
     }
   
     inline void removeFromCell(size_t ID) const
-    { removeFromCellwIt(ID, partCellData.find(ID)); }
+    {
+      if (_dense)
+	{
+	  const size_t cellID = _cellData[ID];
+#ifdef DYNAMO_DEBUG
+	  if (cellID == std::numeric_limits<size_t>::max())
+	    M_throw() << "Removing a particle (ID=" << ID << ") which is not in a cell";
+#endif
+	  //Move the last particle of the cell into the vacated slot
+	  size_t* const cell = _cellSlots.data() + cellID * _cellCapacity;
+	  const size_t slot = _cellSlot[ID];
+	  const size_t lastID = cell[--_cellOccupancy[cellID]];
+	  cell[slot] = lastID;
+	  _cellSlot[lastID] = slot;
+	  _cellData[ID] = std::numeric_limits<size_t>::max();
+	  return;
+	}
+
+      removeFromCellwIt(ID, partCellData.find(ID)); 
+    }
 
     inline void removeFromCellwIt(size_t ID, std::unordered_map<size_t, size_t>::iterator it) const
     {
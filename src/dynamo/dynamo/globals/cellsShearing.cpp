@@ -68,7 +68,7 @@ namespace dynamo {
     return GlobalEvent(part,
 		       Sim->dynamics->
 		       getSquareCellCollision2
-		       (part, calcPosition(partCellData[part.getID()]), 
+		       (part, calcPosition(getCell(part.getID())), 
 			cellDimension)
 		       - Sim->dynamics->getParticleDelay(part),
 		       CELL, *this);
@@ -79,7 +79,7 @@ namespace dynamo {
   {
     Sim->dynamics->updateParticle(part);
 
-    size_t oldCell(partCellData[part.getID()]);
+    size_t oldCell(getCell(part.getID()));
     magnet::math::MortonNumber<3> oldCellCoords(oldCell);
     Vector oldCellPosition(calcPosition(oldCellCoords));
 
@@ -232,7 +232,7 @@ namespace dynamo {
 	      {
 		newNBCell[dim1] %= cellCount[dim1];
   
-		for (const size_t& next : list[newNBCell.getMortonNum()])
+		for (const size_t& next : getCellContents(newNBCell.getMortonNum()))
 		  _sigNewNeighbour(part, next);
 	  
 		++newNBCell[dim1];
@@ -242,6 +242,8 @@ namespace dynamo {
 	    ++newNBCell[dim2];
 	  }
       }
+
+    signalNewLocals(part, oldCell);
     
     //Push the next virtual event, this is the reason the scheduler
     //doesn't need a second callback
@@ -273,7 +275,7 @@ namespace dynamo {
   IDRangeList
   GCellsShearing::getParticleNeighbours(const Particle& part) const
   {
-    return getParticleNeighbours(magnet::math::MortonNumber<3>(partCellData[part.getID()]));
+    return getParticleNeighbours(magnet::math::MortonNumber<3>(getCell(part.getID())));
   }
 
   IDRangeList
@@ -298,7 +300,7 @@ namespace dynamo {
   std::vector<size_t>
   GCellsShearing::getAdditionalLEParticleNeighbourhood(const Particle& part) const
   {
-    return getAdditionalLEParticleNeighbourhood(magnet::math::MortonNumber<3>(partCellData[part.getID()]));
+    return getAdditionalLEParticleNeighbourhood(magnet::math::MortonNumber<3>(getCell(part.getID())));
   }
 
   std::vector<size_t>
@@ -324,7 +326,7 @@ namespace dynamo {
 
 	for (size_t j(0); j < cellCount[0]; ++j)
 	  {
-	    const std::vector<size_t>& nbs(list[cellCoords.getMortonNum()]);
+	    const CellContents nbs(getCellContents(cellCoords.getMortonNum()));
 	    retval.insert(retval.end(), nbs.begin(), nbs.end());
 
 	    ++cellCoords[0];
@@ -30,6 +30,14 @@ namespace dynamo {
     range(nR ? nR : new IDRangeAll(tmp))
   {}
 
+  void
+  Global::saveCheckpoint(CheckpointWriter&) const
+  { M_throw() << "The " << name << " \"" << globName << "\" does not support checkpoints"; }
+
+  void
+  Global::loadCheckpoint(CheckpointReader&)
+  { M_throw() << "The " << name << " \"" << globName << "\" does not support checkpoints"; }
+
   bool 
   Global::isInteraction(const Particle &p1) const
   {
@@ -23,6 +23,8 @@ namespace magnet { namespace xml { class Node; } }
 namespace xml { class XmlStream; }
 
 namespace dynamo {
+  class CheckpointWriter;
+  class CheckpointReader;
   class IntEvent;
   class NEventData;
   class GlobalEvent;
@@ -68,6 +70,18 @@ namespace dynamo {
      */
     virtual void initialise(size_t) = 0;
 
+    /*! \brief Writes any run-time state of the Global (e.g., the
+        contents of the cells of a neighbour list) to a checkpoint (see
+        Simulation::writeCheckpoint).
+
+	As for Interaction::saveCheckpoint, every Global must override
+	this and the default throws.
+     */
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+
+    //! \brief Restores the state written by saveCheckpoint, after initialise is called.
+    virtual void loadCheckpoint(CheckpointReader&);
+
     /*! \brief Helper function for saving an XML representation of this
      * class.
      */
@@ -93,6 +107,10 @@ namespace dynamo {
     /*! \brief Returns the unique ID number of this Global.
      */
     inline const size_t& getID() const { return ID; }
+
+    /*! \brief Returns the range of particles this Global acts on.
+     */
+    const shared_ptr<IDRange>& getRange() const { return range; }
   
   protected:
     /*! \brief Writes out an XML representation of the Global
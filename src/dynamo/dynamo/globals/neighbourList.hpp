@@ -19,6 +19,7 @@
 #include <dynamo/globals/global.hpp>
 #include <dynamo/simulation.hpp>
 #include <dynamo/ranges/IDRangeList.hpp>
+#include <dynamo/ranges/IDRangeRange.hpp>
 #include <boost/function.hpp>
 #include <magnet/function/delegate.hpp>
 #include <magnet/math/vector.hpp>
@@ -50,6 +51,16 @@ namespace dynamo {
     virtual IDRangeList getParticleNeighbours(const Particle&) const = 0;
     virtual IDRangeList getParticleNeighbours(const Vector&) const = 0;
 
+    /*! \brief Returns the IDs of the Locals which a particle may
+      have an event with.
+
+      The default returns every Local. Neighbour lists which sort the
+      Locals spatially must also signal the Locals a particle can
+      newly reach using _sigNewLocal.
+     */
+    virtual std::unique_ptr<IDRange> getParticleLocals(const Particle&) const
+    { return std::unique_ptr<IDRange>(new IDRangeRange(0, Sim->locals.size())); }
+
     /*! \brief This returns the maximum interaction length this
       neighbourlist supports.
       
@@ -99,6 +110,7 @@ namespace dynamo {
 
     mutable magnet::Signal<void(const Particle&, const size_t&)> _sigNewNeighbour;
     mutable magnet::Signal<void(const Particle&, const size_t&)> _sigCellChange;
+    mutable magnet::Signal<void(const Particle&, const size_t&)> _sigNewLocal;
     mutable magnet::Signal<void()> _sigReInitialise;
 
   protected:
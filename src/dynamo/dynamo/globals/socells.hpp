@@ -35,6 +35,10 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    //! \brief There is no run-time state to checkpoint.
+    virtual void saveCheckpoint(CheckpointWriter&) const {}
+    virtual void loadCheckpoint(CheckpointReader&) {}
+
     virtual void operator<<(const magnet::xml::Node&);
 
     virtual void outputXML(magnet::xml::XmlStream& XML) const;
@@ -75,7 +75,7 @@ namespace dynamo {
   void 
   GWaker::operator<<(const magnet::xml::Node& XML)
   {
-    range = shared_ptr<IDRange>(IDRange::getClass(XML, Sim));
+    range = shared_ptr<IDRange>(IDRange::getClass(XML.getNode("IDRange"), Sim));
 
     try {
       globName = XML.getAttribute("Name");
@@ -148,8 +148,7 @@ namespace dynamo {
       
     (*Sim->_sigParticleUpdate)(EDat);
       
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    Sim->signalEvent(iEvent, EDat);
 
     //Now we're past the event, update the scheduler and plugins
     Sim->ptrScheduler->fullUpdate(part);
@@ -114,6 +114,45 @@ namespace dynamo {
     return retval;
   }
 
+  po::options_description
+  IPPacker::getHiddenOptions()
+  {
+    po::options_description retval;
+
+    retval.add_options()
+      ("b1", "boolean option one.")
+      ("b2", "boolean option two.")
+      ("i1", po::value<size_t>(), "integer option one.")
+      ("i2", po::value<size_t>(), "integer option two.")
+      ("s1", po::value<std::string>(), "string option one.")
+      ("s2", po::value<std::string>(), "string option two.")
+      ("f1", po::value<double>(), "double option one.")
+      ("f2", po::value<double>(), "double option two.")
+      ("f3", po::value<double>(), "double option three.")
+      ("f4", po::value<double>(), "double option four.")
+      ("f5", po::value<double>(), "double option five.")
+      ("f6", po::value<double>(), "double option six.")
+      ("f7", po::value<double>(), "double option seven.")
+      ("f8", po::value<double>(), "double option eight.")
+      ("f9", po::value<double>(), "double option nine.")
+      ("f10", po::value<double>(), "double option ten.")
+      ("NCells,C", po::value<unsigned long>()->default_value(7),
+       "Default number of unit cells per dimension, used for crystal packing of particles.")
+      ("xcell,x", po::value<unsigned long>(),
+       "Number of unit cells in the x dimension.")
+      ("ycell,y", po::value<unsigned long>(),
+       "Number of unit cells in the y dimension.")
+      ("zcell,z", po::value<unsigned long>(),
+       "Number of unit cells in the z dimension.")
+      ("rectangular-box", "Force the simulation box to be deformed so "
+       "that the x,y,z cells also specify the box aspect ratio.")
+      ("density,d", po::value<double>()->default_value(0.5),
+       "System number density.")
+      ;
+
+    return retval;
+  }
+
   void
   IPPacker::initialise()
   {
@@ -206,7 +245,7 @@ namespace dynamo {
 	    Sim->particles.push_back(Particle(position, getRandVelVec() * Sim->units.unitVelocity(), nParticles++));
 
 	  if (vm.count("i2"))
-	    Sim->systems.push_back(shared_ptr<System>(new SysRescale(Sim, vm["i2"].as<size_t>(), "RescalerEvent")));
+	    Sim->systems.push_back(shared_ptr<System>(new SysRescale(Sim, vm["i2"].as<size_t>(), "RescalerEvent", Sim->units.unitEnergy())));
 
 	  break;
 	}
@@ -2922,7 +2961,7 @@ namespace dynamo {
 	  Sim->primaryCellSize = Vector(2 * R + 1, 2 * R + 1, depth);
 
 	  //Set up a standard simulation
-	  Sim->ptrScheduler = shared_ptr<SNeighbourList>(new SNeighbourList(Sim, new FELCBT()));
+	  Sim->ptrScheduler = shared_ptr<SNeighbourList>(new SNeighbourList(Sim, new FELCBT<>()));
 	  
 	  incline *= M_PI /180.0;
 	  Sim->dynamics = shared_ptr<Dynamics>(new DynGravity(Sim, g * Vector(0, -cos(incline), sin(incline)), elasticV));
@@ -37,6 +37,11 @@ namespace dynamo {
 
     static po::options_description getOptions();
 
+    /*! \brief The generic options of the packer modes (--i1, --f1,
+        --density, --NCells, ...), which are not listed in the help.
+     */
+    static po::options_description getHiddenOptions();
+
   protected:
     std::array<long, 3> getCells();
     Vector  getNormalisedCellDimensions();
@@ -31,9 +31,9 @@ namespace dynamo {
       {      
 	clear();
 
-	for (std::vector<Particle>::const_iterator iPtr1 = Sim->particles.begin();
+	for (ParticleList::const_iterator iPtr1 = Sim->particles.begin();
 	     iPtr1 != Sim->particles.end(); iPtr1++)
-	  for (std::vector<Particle>::const_iterator iPtr2 = iPtr1+1;
+	  for (ParticleList::const_iterator iPtr2 = iPtr1+1;
 	       iPtr2 != Sim->particles.end(); iPtr2++)
 	    //Check this interaction is the correct interaction for the pair
 	    if (Sim->getInteraction(*iPtr1, *iPtr2).get() == static_cast<const Interaction*>(this))
@@ -62,12 +62,56 @@ namespace dynamo {
       }
   }
 
+  void
+  ICapture::renumberParticles(const std::vector<size_t>& newIDs)
+  {
+    Map oldMap;
+    oldMap.swap(*this);
+    for (const Map::value_type& IDs : oldMap)
+      Map::operator[](Map::key_type(newIDs[IDs.first.first], newIDs[IDs.first.second])) = IDs.second;
+  }
+
+  void
+  ICapture::saveCheckpoint(CheckpointWriter& out) const
+  {
+    out.write(Map::size());
+    for (const Map::value_type& IDs : *this)
+      {
+	out.write(IDs.first.first);
+	out.write(IDs.first.second);
+	out.write(IDs.second);
+      }
+  }
+
+  void
+  ICapture::loadCheckpoint(CheckpointReader& in)
+  {
+    clear();
+    size_t count;
+    in.read(count);
+    for (size_t i(0); i < count; ++i)
+      {
+	size_t ID1, ID2, val;
+	in.read(ID1);
+	in.read(ID2);
+	in.read(val);
+	Map::operator[](Map::key_type(ID1, ID2)) = val;
+      }
+  }
+
   void 
   ICapture::outputCaptureMap(magnet::xml::XmlStream& XML) const 
   {
     XML << magnet::xml::tag("CaptureMap");
 
+    //If the particles were renumbered, the pairs are re-sorted by
+    //their original IDs so the output is the same as without the
+    //renumbering.
+    std::map<detail::PairKey, size_t> originalMap;
     for (const Map::value_type& IDs : *this)
+      originalMap[detail::PairKey(Sim->getOriginalID(IDs.first.first), Sim->getOriginalID(IDs.first.second))] = IDs.second;
+
+    for (const Map::value_type& IDs : originalMap)
       XML << magnet::xml::tag("Pair")
 	  << magnet::xml::attr("ID1") << IDs.first.first
 	  << magnet::xml::attr("ID2") << IDs.first.second
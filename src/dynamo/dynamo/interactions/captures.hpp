@@ -157,6 +157,11 @@ namespace dynamo {
   public:
     ICapture(dynamo::Simulation* sim, IDPairRange* range): Interaction(sim, range), noXmlLoad(true) {}
 
+    virtual void renumberParticles(const std::vector<size_t>& newIDs);
+
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+    virtual void loadCheckpoint(CheckpointReader&);
+
     //! \brief A test if two particles are captured
     size_t isCaptured(const Particle& p1, const Particle& p2) const {
       return Map::operator[](Map::key_type(p1, p2));
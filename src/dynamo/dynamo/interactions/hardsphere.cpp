@@ -27,6 +27,7 @@
 #include <dynamo/NparticleEventData.hpp>
 #include <dynamo/dynamics/compression.hpp>
 #include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 #include <cmath>
@@ -45,6 +46,27 @@ namespace dynamo {
     _post_event_overlap = 0;
     _accum_overlap_magnitude = 0;
     _overlapped_tests = 0;
+    _kernel = kernels::selectKernel(*Sim);
+  }
+
+  void
+  IHardSphere::saveCheckpoint(CheckpointWriter& out) const
+  {
+    out.write(_complete_events);
+    out.write(_post_event_overlap);
+    out.write(_accum_overlap_magnitude);
+    out.write(_overlapped_tests.load());
+  }
+
+  void
+  IHardSphere::loadCheckpoint(CheckpointReader& in)
+  {
+    in.read(_complete_events);
+    in.read(_post_event_overlap);
+    in.read(_accum_overlap_magnitude);
+    size_t overlapped_tests;
+    in.read(overlapped_tests);
+    _overlapped_tests = overlapped_tests;
   }
 
   void 
@@ -71,7 +93,7 @@ namespace dynamo {
 	<< magnet::xml::attr("AvgPostEventOverlapMagnitude") << _accum_overlap_magnitude / (_post_event_overlap *  Sim->units.unitLength())
 	<< magnet::xml::attr("Events") << _complete_events
 	<< magnet::xml::attr("OverlapFreq") << double(_post_event_overlap) / double(_complete_events)
-	<< magnet::xml::attr("OverlappedTests") << _overlapped_tests
+	<< magnet::xml::attr("OverlappedTests") << _overlapped_tests.load()
 	<< magnet::xml::endtag("Interaction");
   }
 
@@ -120,6 +142,57 @@ namespace dynamo {
     return IntEvent(p1,p2,HUGE_VAL, NONE, *this);  
   }
 
+  void
+  IHardSphere::getEvents(const Particle& p1, const std::vector<size_t>& ids,
+			 std::vector<IntEvent>& events) const
+  {
+    switch (_kernel)
+      {
+      case kernels::NEWTONIAN_PERIODIC:
+	getEventsKernel(p1, ids, events, kernels::NewtonianKernel<kernels::PeriodicBC>(*Sim));
+	break;
+      case kernels::NEWTONIAN_NOBC:
+	getEventsKernel(p1, ids, events, kernels::NewtonianKernel<kernels::NoBC>(*Sim));
+	break;
+      default:
+	getEventsKernel(p1, ids, events, kernels::GenericKernel(*Sim));
+      }
+  }
+
+  template<class Kernel>
+  void
+  IHardSphere::getEventsKernel(const Particle& p1, const std::vector<size_t>& ids,
+			       std::vector<IntEvent>& events, const Kernel& kernel) const
+  {
+    const double d1 = _diameter->getProperty(p1.getID());
+
+    const size_t blocksize = 64;
+    double d[blocksize], dt[blocksize];
+    for (size_t start(0); start < ids.size(); start += blocksize)
+      {
+	const size_t n = std::min(blocksize, ids.size() - start);
+	for (size_t i(0); i < n; ++i)
+	  d[i] = (d1 + _diameter->getProperty(ids[start + i])) * 0.5;
+
+	kernel.sphereSphereInRoot(p1, &ids[start], d, dt, n);
+
+	for (size_t i(0); i < n; ++i)
+	  {
+	    const Particle& p2 = Sim->particles[ids[start + i]];
+#ifdef DYNAMO_DEBUG
+	    if (!Sim->dynamics->isUpToDate(p2))
+	      M_throw() << "Particle 2 is not up to date: ID1=" << p1.getID() << ", ID2=" << p2.getID();
+	    
+	    if (p1 == p2)
+	      M_throw() << "You shouldn't pass p1==p2 events to the interactions!";
+#endif
+	    if (kernel.sphereOverlap(p1, p2, d[i])) ++_overlapped_tests;
+	    
+	    events.push_back(IntEvent(p1, p2, dt[i], (dt[i] != HUGE_VAL) ? CORE : NONE, *this));
+	  }
+      }
+  }
+
   void
   IHardSphere::runEvent(Particle& p1, Particle& p2, const IntEvent& iEvent)
   {
@@ -155,8 +228,7 @@ namespace dynamo {
     //Now we're past the event, update the scheduler and plugins
     Sim->ptrScheduler->fullUpdate(p1, p2);
   
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent,EDat);
+    Sim->signalEvent(iEvent,EDat);
   }
    
   void 
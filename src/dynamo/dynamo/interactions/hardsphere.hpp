@@ -20,6 +20,8 @@
 #include <dynamo/interactions/interaction.hpp>
 #include <dynamo/simulation.hpp>
 #include <dynamo/interactions/glyphrepresentation.hpp>
+#include <dynamo/dynamics/kernels.hpp>
+#include <atomic>
 
 namespace dynamo {
   class IHardSphere: public GlyphRepresentation, public Interaction
@@ -63,6 +65,11 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    //! \brief Writes the overlap statistics reported by outputData.
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+
+    virtual void loadCheckpoint(CheckpointReader&);
+
     virtual double maxIntDist() const;
 
     virtual double getExcludedVolume(size_t) const;
@@ -70,6 +77,7 @@ namespace dynamo {
     virtual void rescaleLengths(double) {}
 
     virtual IntEvent getEvent(const Particle&, const Particle&) const;
+    virtual void getEvents(const Particle&, const std::vector<size_t>&, std::vector<IntEvent>&) const;
  
     virtual void runEvent(Particle&, Particle&, const IntEvent&);
    
@@ -80,6 +88,9 @@ namespace dynamo {
     void outputData(magnet::xml::XmlStream& XML) const;
 
   protected:
+    template<class Kernel>
+    void getEventsKernel(const Particle&, const std::vector<size_t>&, std::vector<IntEvent>&, const Kernel&) const;
+
     shared_ptr<Property> _diameter;
     shared_ptr<Property> _e;
     shared_ptr<Property> _et;
@@ -87,6 +98,8 @@ namespace dynamo {
     mutable size_t _complete_events;
     mutable size_t _post_event_overlap;
     mutable double _accum_overlap_magnitude;
-    mutable size_t _overlapped_tests;
+    mutable std::atomic<size_t> _overlapped_tests;
+    //! \brief The sphere event kernel selected in initialise.
+    kernels::Type _kernel;
   };
 }
@@ -33,6 +33,22 @@ namespace dynamo {
   Interaction::operator<<(const magnet::xml::Node& XML)
   { range = shared_ptr<IDPairRange>(IDPairRange::getClass(XML.getNode("IDPairRange"), Sim)); }
 
+  void
+  Interaction::saveCheckpoint(CheckpointWriter&) const
+  { M_throw() << "The " << name << " \"" << intName << "\" does not support checkpoints"; }
+
+  void
+  Interaction::loadCheckpoint(CheckpointReader&)
+  { M_throw() << "The " << name << " \"" << intName << "\" does not support checkpoints"; }
+
+  void
+  Interaction::getEvents(const Particle& p1, const std::vector<size_t>& ids,
+			 std::vector<IntEvent>& events) const
+  {
+    for (const size_t id2 : ids)
+      events.push_back(getEvent(p1, Sim->particles[id2]));
+  }
+
   bool 
   Interaction::isInteraction(const IntEvent &coll) const
   { 
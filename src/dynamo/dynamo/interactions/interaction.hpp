@@ -21,10 +21,13 @@
 #include <dynamo/ranges/IDPairRange.hpp>
 #include <string>
 #include <limits>
+#include <vector>
 
 namespace magnet { namespace xml { class Node; class XmlStream; } }
 
 namespace dynamo {
+  class CheckpointWriter;
+  class CheckpointReader;
   class IDRange;
   class PairEventData;
   class IntEvent;
@@ -64,16 +67,49 @@ namespace dynamo {
 
     virtual void initialise(size_t) = 0;
 
+    /*! \brief Writes any run-time state of the Interaction (e.g., a
+        capture map) to a checkpoint (see Simulation::writeCheckpoint).
+
+	Every Interaction must override this, even if it has no state
+	to write, so that a new Interaction cannot silently drop its
+	state from the checkpoints. The default throws.
+     */
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+
+    //! \brief Restores the state written by saveCheckpoint, after initialise is called.
+    virtual void loadCheckpoint(CheckpointReader&);
+
     /*! \brief Calculate if and when an event is to occur between two
         particles.
      */
     virtual IntEvent getEvent(const Particle &, 
 			      const Particle &) const = 0;
 
+    /*! \brief Calculate the events between a particle and a batch of
+        other particles.
+
+	The events (including those of type NONE) are appended to \p
+	events in the order of \p ids. The default implementation calls
+	getEvent for each pair, but interactions which can use the
+	batched Dynamics root finders (e.g.,
+	Dynamics::SphereSphereInRoot) override this to process several
+	pairs at once.
+     */
+    virtual void getEvents(const Particle&, const std::vector<size_t>& ids,
+			   std::vector<IntEvent>& events) const;
+
     /*! \brief Run the dynamics of an event which is occuring now.
      */
     virtual void runEvent(Particle&, Particle&, const IntEvent&) = 0;
 
+    /*! \brief Remaps any per-particle data held by the Interaction
+        after the particles are renumbered (see
+        Simulation::renumberParticles).
+
+	\param newIDs The new ID of each particle, indexed by its old ID.
+     */
+    virtual void renumberParticles(const std::vector<size_t>& newIDs) {}
+
     /*! \brief Return the maximum distance at which two particles may interact using this Interaction.
     
       This value is used in GNeighbourList's to make sure a certain
@@ -46,7 +46,16 @@ namespace dynamo {
   PotentialStepped::PotentialStepped(std::vector<std::pair<double, double> > steps, bool direction):
     _direction(direction)
   {
-    if (direction)
+    setSteps(steps);
+  }
+
+  void
+  PotentialStepped::setSteps(std::vector<std::pair<double, double> > steps)
+  {
+    _r_cache.clear();
+    _u_cache.clear();
+
+    if (_direction)
       std::sort(steps.begin(), steps.end());
     else
       std::sort(steps.rbegin(), steps.rend());
@@ -92,6 +101,6 @@ namespace dynamo {
     if (steps.empty())
       M_throw() << "You cannot load a stepped potential with no steps.\nXML path: " << XML.getPath();
     
-    *this = PotentialStepped(steps, _direction);
+    setSteps(steps);
   }
 }
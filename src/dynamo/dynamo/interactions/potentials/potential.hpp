@@ -18,7 +18,9 @@
 #pragma once
 #include <vector>
 #include <cmath>
+#include <mutex>
 #include <dynamo/base.hpp>
+#include <magnet/containers/append_only_array.hpp>
 
 namespace magnet { namespace xml { class Node; class XmlStream; } }
 
@@ -41,7 +43,10 @@ namespace dynamo {
 
     This class also implements a cache, to allow fast lookup of previously
     accessed steps, as some calculated potentials are expensive to
-    compute.
+    compute. The events of several particles may be predicted at once
+    (see \ref Scheduler), so the cache is only extended under a lock,
+    and its steps never move once calculated so they may be read
+    without one.
    */
   class Potential {
   public:    
@@ -59,7 +64,11 @@ namespace dynamo {
       if (step_id >= steps()) M_throw() << "Out of range access";
 #endif 
 
-      if (step_id >= cached_steps()) calculateToStep(step_id);
+      if (step_id >= cached_steps())
+	{
+	  std::lock_guard<std::mutex> lock(_cacheLock);
+	  if (step_id >= cached_steps()) calculateToStep(step_id);
+	}
 
       return value_type(_r_cache[step_id], _u_cache[step_id]);
     }
@@ -214,8 +223,15 @@ namespace dynamo {
     virtual void calculateToStep(size_t) const = 0;
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
 
-    mutable std::vector<double> _r_cache;
-    mutable std::vector<double> _u_cache;
+    /*! \brief The cached step positions and energies, see
+        calculateToStep.
+
+	calculateToStep is only called with \ref _cacheLock held.
+     */
+    mutable magnet::containers::AppendOnlyArray<double> _r_cache;
+    mutable magnet::containers::AppendOnlyArray<double> _u_cache;
+    //! \brief Serialises the calls to calculateToStep.
+    mutable std::mutex _cacheLock;
   };
 
   /*! \brief A manually stepped potential.
@@ -273,5 +289,8 @@ namespace dynamo {
     }
 
     virtual void outputXML(magnet::xml::XmlStream&) const;
+
+    //! \brief Sorts the passed steps and stores them in the cache.
+    void setSteps(std::vector<std::pair<double, double> > step_pos_energy);
   };
 }
@@ -51,6 +51,10 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    //! \brief There is no run-time state to checkpoint.
+    virtual void saveCheckpoint(CheckpointWriter&) const {}
+    virtual void loadCheckpoint(CheckpointReader&) {}
+
     virtual bool captureTest(const Particle&, const Particle&) const;
 
     virtual IntEvent getEvent(const Particle&, const Particle&) const;
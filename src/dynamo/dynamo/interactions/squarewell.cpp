@@ -84,6 +84,7 @@ namespace dynamo {
   {
     ID = nID;
     ICapture::initCaptureMap();
+    _kernel = kernels::selectKernel(*Sim);
   }
 
   size_t
@@ -152,6 +153,71 @@ namespace dynamo {
     return retval;
   }
 
+  void
+  ISquareWell::getEvents(const Particle& p1, const std::vector<size_t>& ids,
+			 std::vector<IntEvent>& events) const
+  {
+    switch (_kernel)
+      {
+      case kernels::NEWTONIAN_PERIODIC:
+	getEventsKernel(p1, ids, events, kernels::NewtonianKernel<kernels::PeriodicBC>(*Sim));
+	break;
+      case kernels::NEWTONIAN_NOBC:
+	getEventsKernel(p1, ids, events, kernels::NewtonianKernel<kernels::NoBC>(*Sim));
+	break;
+      default:
+	getEventsKernel(p1, ids, events, kernels::GenericKernel(*Sim));
+      }
+  }
+
+  template<class Kernel>
+  void
+  ISquareWell::getEventsKernel(const Particle& p1, const std::vector<size_t>& ids,
+			       std::vector<IntEvent>& events, const Kernel& kernel) const
+  {
+    const double d1 = _diameter->getProperty(p1.getID());
+    const double l1 = _lambda->getProperty(p1.getID());
+
+    //Captured pairs test for the core and uncaptured pairs for the
+    //well edge, so both in-roots can go through one batch.
+    const size_t blocksize = 64;
+    double d[blocksize], l[blocksize], din[blocksize], dt[blocksize];
+    bool captured[blocksize];
+    for (size_t start(0); start < ids.size(); start += blocksize)
+      {
+	const size_t n = std::min(blocksize, ids.size() - start);
+	for (size_t i(0); i < n; ++i)
+	  {
+	    const size_t id2 = ids[start + i];
+	    d[i] = (d1 + _diameter->getProperty(id2)) * 0.5;
+	    l[i] = (l1 + _lambda->getProperty(id2)) * 0.5;
+	    captured[i] = isCaptured(p1.getID(), id2);
+	    din[i] = captured[i] ? d[i] : l[i] * d[i];
+	  }
+
+	kernel.sphereSphereInRoot(p1, &ids[start], din, dt, n);
+
+	for (size_t i(0); i < n; ++i)
+	  {
+	    const Particle& p2 = Sim->particles[ids[start + i]];
+	    IntEvent retval(p1, p2, HUGE_VAL, NONE, *this);
+	    if (captured[i])
+	      {
+		if (dt[i] != HUGE_VAL)
+		  retval = IntEvent(p1, p2, dt[i], CORE, *this);
+
+		const double dtout = kernel.sphereSphereOutRoot(p1, p2, l[i] * d[i]);
+		if (retval.getdt() > dtout)
+		  retval = IntEvent(p1, p2, dtout, STEP_OUT, *this);
+	      }
+	    else if (dt[i] != HUGE_VAL)
+	      retval = IntEvent(p1, p2, dt[i], STEP_IN, *this);
+
+	    events.push_back(retval);
+	  }
+      }
+  }
+
   void
   ISquareWell::runEvent(Particle& p1, Particle& p2, const IntEvent& iEvent)
   {
@@ -177,8 +243,7 @@ namespace dynamo {
 	  PairEventData retVal(Sim->dynamics->SmoothSpheresColl(iEvent, e, d2, CORE));
 	  (*Sim->_sigParticleUpdate)(retVal);
 	  Sim->ptrScheduler->fullUpdate(p1, p2);
-	  for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-	    Ptr->eventUpdate(iEvent, retVal);
+	  Sim->signalEvent(iEvent, retVal);
 	  break;
 	}
       case STEP_IN:
@@ -187,8 +252,7 @@ namespace dynamo {
 	  if (retVal.getType() != BOUNCE) ICapture::add(p1, p2);
 	  Sim->ptrScheduler->fullUpdate(p1, p2);
 	  (*Sim->_sigParticleUpdate)(retVal);
-	  for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-	    Ptr->eventUpdate(iEvent, retVal);
+	  Sim->signalEvent(iEvent, retVal);
 	  break;
 	}
       case STEP_OUT:
@@ -197,8 +261,7 @@ namespace dynamo {
 	  if (retVal.getType() != BOUNCE) ICapture::remove(p1, p2);
 	  (*Sim->_sigParticleUpdate)(retVal);
 	  Sim->ptrScheduler->fullUpdate(p1, p2);
-	  for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-	    Ptr->eventUpdate(iEvent, retVal);
+	  Sim->signalEvent(iEvent, retVal);
 	  break;
 	}
       default:
@@ -19,6 +19,7 @@
 
 #include <dynamo/interactions/captures.hpp>
 #include <dynamo/interactions/glyphrepresentation.hpp>
+#include <dynamo/dynamics/kernels.hpp>
 #include <dynamo/simulation.hpp>
 
 namespace dynamo {
@@ -56,6 +57,7 @@ namespace dynamo {
     virtual void initialise(size_t);
 
     virtual IntEvent getEvent(const Particle&, const Particle&) const;
+    virtual void getEvents(const Particle&, const std::vector<size_t>&, std::vector<IntEvent>&) const;
   
     virtual void runEvent(Particle&, Particle&, const IntEvent&);
   
@@ -69,9 +71,14 @@ namespace dynamo {
     ISquareWell(dynamo::Simulation* tmp, IDPairRange* nR):
       ICapture(tmp,nR) {}
 
+    template<class Kernel>
+    void getEventsKernel(const Particle&, const std::vector<size_t>&, std::vector<IntEvent>&, const Kernel&) const;
+
     shared_ptr<Property> _diameter;
     shared_ptr<Property> _lambda;
     shared_ptr<Property> _wellDepth;
     shared_ptr<Property> _e;
+    //! \brief The sphere event kernel selected in initialise.
+    kernels::Type _kernel;
   };
 }
@@ -83,6 +83,7 @@ namespace dynamo {
   {
     ID = nID;
     ICapture::initCaptureMap();
+    _kernel = kernels::selectKernel(*Sim);
   }
 
   size_t 
@@ -154,6 +155,70 @@ namespace dynamo {
     return retval;
   }
 
+  void
+  IStepped::getEvents(const Particle& p1, const std::vector<size_t>& ids,
+		      std::vector<IntEvent>& events) const
+  {
+    switch (_kernel)
+      {
+      case kernels::NEWTONIAN_PERIODIC:
+	getEventsKernel(p1, ids, events, kernels::NewtonianKernel<kernels::PeriodicBC>(*Sim));
+	break;
+      case kernels::NEWTONIAN_NOBC:
+	getEventsKernel(p1, ids, events, kernels::NewtonianKernel<kernels::NoBC>(*Sim));
+	break;
+      default:
+	getEventsKernel(p1, ids, events, kernels::GenericKernel(*Sim));
+      }
+  }
+
+  template<class Kernel>
+  void
+  IStepped::getEventsKernel(const Particle& p1, const std::vector<size_t>& ids,
+			    std::vector<IntEvent>& events, const Kernel& kernel) const
+  {
+    const double l1 = _lengthScale->getProperty(p1.getID());
+
+    const size_t blocksize = 64;
+    double din[blocksize], dt[blocksize], length_scale[blocksize];
+    size_t step_ID[blocksize];
+    for (size_t start(0); start < ids.size(); start += blocksize)
+      {
+	const size_t n = std::min(blocksize, ids.size() - start);
+	for (size_t i(0); i < n; ++i)
+	  {
+	    const size_t id2 = ids[start + i];
+	    ICapture::const_iterator capstat = ICapture::find(ICapture::key_type(p1.getID(), id2));
+	    step_ID[i] = (capstat == ICapture::end()) ? 0 : capstat->second;
+	    length_scale[i] = 0.5 * (l1 + _lengthScale->getProperty(id2));
+	    din[i] = _potential->getStepBounds(step_ID[i]).first * length_scale[i];
+	  }
+
+	kernel.sphereSphereInRoot(p1, &ids[start], din, dt, n);
+
+	for (size_t i(0); i < n; ++i)
+	  {
+	    const Particle& p2 = Sim->particles[ids[start + i]];
+	    const std::pair<double, double> step_bounds = _potential->getStepBounds(step_ID[i]);
+
+	    IntEvent retval(p1, p2, HUGE_VAL, NONE, *this);
+	    //Pairs without an inner step were tested against a zero
+	    //diameter, so their result is discarded.
+	    if ((step_bounds.first != 0) && (dt[i] != HUGE_VAL))
+	      retval = IntEvent(p1, p2, dt[i], STEP_IN, *this);
+
+	    if (!std::isinf(step_bounds.second))
+	      {
+		const double dtout = kernel.sphereSphereOutRoot(p1, p2, step_bounds.second * length_scale[i]);
+		if (retval.getdt() > dtout)
+		  retval = IntEvent(p1, p2, dtout, STEP_OUT, *this);
+	      }
+
+	    events.push_back(retval);
+	  }
+      }
+  }
+
   void
   IStepped::runEvent(Particle& p1, Particle& p2, const IntEvent& iEvent)
   {
@@ -197,8 +262,7 @@ namespace dynamo {
     if (retVal.getType() != BOUNCE) ICapture::operator[](ICapture::key_type(p1, p2)) = new_step_ID;
     (*Sim->_sigParticleUpdate)(retVal);
     Sim->ptrScheduler->fullUpdate(p1, p2);
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, retVal);
+    Sim->signalEvent(iEvent, retVal);
   }
 
   bool
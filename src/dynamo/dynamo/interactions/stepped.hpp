@@ -19,6 +19,7 @@
 
 #include <dynamo/interactions/captures.hpp>
 #include <dynamo/interactions/glyphrepresentation.hpp>
+#include <dynamo/dynamics/kernels.hpp>
 #include <dynamo/interactions/potentials/potential.hpp>
 #include <dynamo/simulation.hpp>
 #include <dynamo/eventtypes.hpp>
@@ -53,6 +54,7 @@ namespace dynamo {
     virtual void initialise(size_t);
 
     virtual IntEvent getEvent(const Particle&, const Particle&) const;
+    virtual void getEvents(const Particle&, const std::vector<size_t>&, std::vector<IntEvent>&) const;
   
     virtual void runEvent(Particle&, Particle&, const IntEvent&);
   
@@ -67,6 +69,9 @@ namespace dynamo {
     virtual void outputData(magnet::xml::XmlStream&) const;
 
   protected:
+    template<class Kernel>
+    void getEventsKernel(const Particle&, const std::vector<size_t>&, std::vector<IntEvent>&, const Kernel&) const;
+
     //!This class is used to track how the length scale changes in the system
     shared_ptr<Property> _lengthScale;
     //!This class is used to track how the energy scale changes in the system
@@ -80,5 +85,7 @@ namespace dynamo {
       double rdotv_sum;
     };
     std::map<std::pair<size_t, EEventType>, EdgeData> _edgedata;
+    //! \brief The sphere event kernel selected in initialise.
+    kernels::Type _kernel;
   };
 }
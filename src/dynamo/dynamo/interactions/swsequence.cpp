@@ -286,8 +286,7 @@ namespace dynamo {
 	
 	  Sim->ptrScheduler->fullUpdate(p1, p2);
 	
-	  for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-	    Ptr->eventUpdate(iEvent, retVal);
+	  Sim->signalEvent(iEvent, retVal);
 
 	  break;
 	}
@@ -297,8 +296,7 @@ namespace dynamo {
 	  if (retVal.getType() != BOUNCE) ICapture::add(p1, p2);      
 	  (*Sim->_sigParticleUpdate)(retVal);
 	  Sim->ptrScheduler->fullUpdate(p1, p2);
-	  for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-	    Ptr->eventUpdate(iEvent, retVal);
+	  Sim->signalEvent(iEvent, retVal);
 
 	  break;
 	}
@@ -308,8 +306,7 @@ namespace dynamo {
 	  if (retVal.getType() != BOUNCE) ICapture::remove(p1, p2);
 	  (*Sim->_sigParticleUpdate)(retVal);
 	  Sim->ptrScheduler->fullUpdate(p1, p2);
-	  for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-	    Ptr->eventUpdate(iEvent, retVal);
+	  Sim->signalEvent(iEvent, retVal);
 	  break;
 	}
       default:
@@ -59,8 +59,7 @@ namespace dynamo {
     //Now we're past the event update the scheduler and plugins
     Sim->ptrScheduler->fullUpdate(part);
   
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    Sim->signalEvent(iEvent, EDat);
   }
 
   void 
@@ -127,6 +126,23 @@ namespace dynamo {
     return false;
   }
 
+  bool
+  LCylinder::isInCell(const Vector& origin, const Vector& width) const
+  {
+    Vector axisPos(vPosition);
+    Sim->BCs->applyBC(axisPos);
+
+    //The distance of the box centre from the axis, every point of
+    //the box is within half the box diagonal of this
+    Vector rij = origin + 0.5 * width - axisPos;
+    rij -= (rij | vAxis) * vAxis;
+    const double dist = rij.nrm();
+    const double extent = 0.5 * width.nrm();
+
+    return (dist - extent <= _cyl_radius + 0.5 * _diameter->getMaxValue())
+      && (dist + extent >= _cyl_radius + 0.5 * _diameter->getMinValue());
+  }
+
 #ifdef DYNAMO_visualizer
 
   shared_ptr<coil::RenderObj>
@@ -37,6 +37,14 @@ namespace dynamo {
     range(nR)
   {}
 
+  void
+  Local::saveCheckpoint(CheckpointWriter&) const
+  { M_throw() << "The " << name << " \"" << localName << "\" does not support checkpoints"; }
+
+  void
+  Local::loadCheckpoint(CheckpointReader&)
+  { M_throw() << "The " << name << " \"" << localName << "\" does not support checkpoints"; }
+
   bool 
   Local::isInteraction(const Particle &p1) const
   {
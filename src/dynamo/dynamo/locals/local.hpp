@@ -25,6 +25,8 @@
 namespace magnet { namespace xml { class Node; } }
 namespace xml { class XmlStream; }
 namespace dynamo {
+  class CheckpointWriter;
+  class CheckpointReader;
   class IntEvent;
   class NEventData;
   class LocalEvent;
@@ -36,7 +38,8 @@ namespace dynamo {
    * neighbor list for efficiency.
    *
    * To do this, the Local class provides the isInCell method, used by a
-   * GNeighbourList to check if this Local is in a certain cell.
+   * GNeighbourList to check if this Local is in a certain cell (see
+   * GCells::getParticleLocals).
    */
   class Local: public dynamo::SimBase
   {
@@ -55,6 +58,39 @@ namespace dynamo {
   
     virtual void initialise(size_t nID)  { ID = nID; }
 
+    /*! \brief Writes any run-time state of the Local to a checkpoint
+        (see Simulation::writeCheckpoint).
+
+	As for Interaction::saveCheckpoint, every Local must override
+	this and the default throws.
+     */
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+
+    //! \brief Restores the state written by saveCheckpoint, after initialise is called.
+    virtual void loadCheckpoint(CheckpointReader&);
+
+    /*! \brief False if the Local moves, so that rescaling the
+      particle velocities does not simply rescale its event times
+      (see Dynamics::timeScaleInvariant).
+     */
+    virtual bool timeScaleInvariant() const { return true; }
+
+    /*! \brief Tests if a particle with its centre inside a box may
+      have an event with this Local.
+
+      The box is given in unwrapped coordinates, as the neighbour
+      list also tests the periodic images of each cell. Any reference
+      point of the Local should therefore be wrapped into the primary
+      image before comparing it to the box. The test may be
+      conservative, but must never return false for a box a
+      colliding particle could be in. The default places the Local in
+      every cell, as is required for Locals which move.
+
+      \param origin The lowest corner of the box.
+      \param width The side lengths of the box.
+     */
+    virtual bool isInCell(const Vector& origin, const Vector& width) const { return true; }
+
     friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream&, const Local&);
 
     static shared_ptr<Local> getClass(const magnet::xml::Node&, dynamo::Simulation*);
@@ -67,6 +103,8 @@ namespace dynamo {
 
     inline const size_t& getID() const { return ID; }
 
+    const shared_ptr<IDRange>& getRange() const { return range; }
+
     /* \brief Test if a particle is in a valid state according to this
        local.
        
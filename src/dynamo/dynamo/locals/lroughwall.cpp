@@ -71,8 +71,7 @@ namespace dynamo {
     //Now we're past the event update the scheduler and plugins
     Sim->ptrScheduler->fullUpdate(part);
   
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    Sim->signalEvent(iEvent, EDat);
   }
 
   void 
@@ -127,5 +126,19 @@ namespace dynamo {
       }
     return false;
   }
+
+  bool
+  LRoughWall::isInCell(const Vector& origin, const Vector& width) const
+  {
+    Vector wallPos(vPosition);
+    Sim->BCs->applyBC(wallPos);
+
+    const double dist = ((origin + 0.5 * width - wallPos) | vNorm);
+    double extent(0);
+    for (size_t iDim(0); iDim < NDIM; ++iDim)
+      extent += 0.5 * width[iDim] * std::abs(vNorm[iDim]);
+
+    return std::abs(dist) <= extent + r;
+  }
 }
 
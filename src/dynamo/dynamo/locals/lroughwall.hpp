@@ -36,6 +36,12 @@ namespace dynamo {
 
     virtual bool validateState(const Particle& part, bool textoutput = true) const;
 
+    virtual bool isInCell(const Vector& origin, const Vector& width) const;
+
+    //! \brief There is no run-time state to checkpoint.
+    virtual void saveCheckpoint(CheckpointWriter&) const {}
+    virtual void loadCheckpoint(CheckpointReader&) {}
+
   protected:
     virtual void outputXML(magnet::xml::XmlStream&) const;
 
@@ -63,8 +63,7 @@ namespace dynamo {
     //Now we're past the event update the scheduler and plugins
     Sim->ptrScheduler->fullUpdate(part);
   
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    Sim->signalEvent(iEvent, EDat);
   }
 
   void 
@@ -139,6 +138,22 @@ namespace dynamo {
     return false;
   }
 
+  bool
+  LWall::isInCell(const Vector& origin, const Vector& width) const
+  {
+    Vector wallPos(vPosition);
+    Sim->BCs->applyBC(wallPos);
+
+    //The distance of the box centre from the wall, and the furthest
+    //any point of the box is from its centre along the normal
+    const double dist = ((origin + 0.5 * width - wallPos) | vNorm);
+    double extent(0);
+    for (size_t iDim(0); iDim < NDIM; ++iDim)
+      extent += 0.5 * width[iDim] * std::abs(vNorm[iDim]);
+
+    return std::abs(dist) <= extent + 0.5 * _diameter->getMaxValue();
+  }
+
 #ifdef DYNAMO_visualizer
 
   shared_ptr<coil::RenderObj>
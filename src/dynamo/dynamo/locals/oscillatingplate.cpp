@@ -87,14 +87,15 @@ namespace dynamo {
 
     (*Sim->_sigParticleUpdate)(EDat);
 
-    //Now we're past the event update the scheduler and plugins
-    //if (strongPlate) 
-    //  Sim->ptrScheduler->fullUpdate(part);
-    //else
-    Sim->ptrScheduler->rebuildList();
-
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    //Now we're past the event update the scheduler and plugins. A
+    //plate with a finite mass is perturbed by the collision, which
+    //only changes the plate events of the other particles
+    if (!strongPlate)
+      Sim->ptrScheduler->updateLocalEvents(*this);
+
+    Sim->ptrScheduler->fullUpdate(part);
+
+    Sim->signalEvent(iEvent, EDat);
   }
 
   void 
@@ -116,6 +117,24 @@ namespace dynamo {
     localName = XML.getAttribute("Name");
   }
 
+  void
+  LOscillatingPlate::saveCheckpoint(CheckpointWriter& out) const
+  {
+    out.write(delta);
+    out.write(timeshift);
+    out.write(lastID);
+    out.write(lastsystemTime);
+  }
+
+  void
+  LOscillatingPlate::loadCheckpoint(CheckpointReader& in)
+  {
+    in.read(delta);
+    in.read(timeshift);
+    in.read(lastID);
+    in.read(lastsystemTime);
+  }
+
   void 
   LOscillatingPlate::outputXML(magnet::xml::XmlStream& XML) const
   {
@@ -40,6 +40,11 @@ namespace dynamo {
   
     virtual void operator<<(const magnet::xml::Node&);
 
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+    virtual void loadCheckpoint(CheckpointReader&);
+
+    virtual bool timeScaleInvariant() const { return false; }
+
     Vector getPosition() const;
 
     Vector getVelocity() const;
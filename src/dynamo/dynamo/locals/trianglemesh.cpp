@@ -23,13 +23,109 @@
 #include <dynamo/units/units.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/outputplugins/outputplugin.hpp>
-
+#include <dynamo/BC/PBC.hpp>
+#include <dynamo/BC/None.hpp>
+#include <magnet/xmlreader.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <typeinfo>
+#include <fstream>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <cstdint>
+#include <array>
+#include <map>
 
 namespace dynamo {
+  namespace {
+    /*! \brief Parses the whitespace separated numbers in the text of
+        an XML tag.
+
+	This avoids the overhead of std::istringstream on meshes with
+	many vertices.
+     */
+    template<class T, class Parser>
+    std::vector<T> parseNumbers(const std::string& text, const Parser& parser, const char* tagName)
+    {
+      std::vector<T> retval;
+      const char* ptr = text.c_str();
+      for (;;)
+	{
+	  while (std::isspace(*ptr)) ++ptr;
+	  if (!*ptr) break;
+
+	  char* end;
+	  retval.push_back(parser(ptr, &end));
+	  if (end == ptr)
+	    M_throw() << "Failed to parse a number in the " << tagName << " tag, near \""
+		      << std::string(ptr, std::min(std::strlen(ptr), size_t(20))) << "\"";
+	  ptr = end;
+	}
+      return retval;
+    }
+  }
+
   LTriangleMesh::LTriangleMesh(const magnet::xml::Node& XML, dynamo::Simulation* tmp):
-    Local(tmp, "LocalWall")
+    Local(tmp, "LocalWall"),
+    _useBVH(false),
+    _periodic(false),
+    _epsilon(0)
   { operator<<(XML); }
 
+  void
+  LTriangleMesh::initialise(size_t nID)
+  {
+    Local::initialise(nID);
+
+    //The images of the particles (and the neighbours of the
+    //triangles) are only simple for these boundary conditions
+    _periodic = (typeid(*Sim->BCs) == typeid(BCPeriodic));
+    _useBVH = _periodic || (typeid(*Sim->BCs) == typeid(BCNone));
+
+    if (!_useBVH)
+      {
+	dout << "The boundary conditions are not supported by the bounding volume hierarchy, "
+	  "every triangle will be tested for each event" << std::endl;
+	return;
+      }
+
+    _bvh.build(_elements.size(), [&](size_t id)
+	       {
+		 const TriangleElements& elem = _elements[id];
+		 const Vector& A = _vertices[std::get<0>(elem)];
+		 const Vector& B = _vertices[std::get<1>(elem)];
+		 const Vector& C = _vertices[std::get<2>(elem)];
+		 Vector min, max;
+		 for (size_t iDim(0); iDim < NDIM; ++iDim)
+		   {
+		     min[iDim] = std::min(A[iDim], std::min(B[iDim], C[iDim]));
+		     max[iDim] = std::max(A[iDim], std::max(B[iDim], C[iDim]));
+		   }
+		 return std::make_pair(min, max);
+	       });
+
+    if (!_bvh.empty())
+      {
+	const magnet::containers::BVH::Node& root = _bvh.getNodes()[0];
+	_epsilon = 1e-10 * (root.max - root.min).nrm();
+      }
+  }
+
+  void
+  LTriangleMesh::testTriangle(const Particle& part, double radius, size_t id,
+			      std::pair<double, size_t>& tmin, size_t& triangleid) const
+  {
+    std::pair<double, size_t> t 
+      = Sim->dynamics->getSphereTriangleEvent(part,
+					      _vertices[std::get<0>(_elements[id])],
+					      _vertices[std::get<1>(_elements[id])],
+					      _vertices[std::get<2>(_elements[id])],
+					      radius);
+
+    //Ties are broken by the lowest ID, as in a linear search
+    if ((t < tmin) || ((t == tmin) && (id < triangleid))) { tmin = t; triangleid = id; }
+  }
+
   LocalEvent 
   LTriangleMesh::getEvent(const Particle& part) const
   {
@@ -43,20 +139,117 @@ namespace dynamo {
 
     std::pair<double, size_t> tmin(HUGE_VAL, 0); //Default to no collision
 
-    for (size_t id(0); id < _elements.size(); ++id)
+    if (!_useBVH)
       {
-	std::pair<double, size_t> t 
-	  = Sim->dynamics->getSphereTriangleEvent(part,
-						  _vertices[std::get<0>(_elements[id])],
-						  _vertices[std::get<1>(_elements[id])],
-						  _vertices[std::get<2>(_elements[id])],
-						  diam);
-	if (t < tmin) { tmin = t; triangleid = id; }
+	for (size_t id(0); id < _elements.size(); ++id)
+	  testTriangle(part, diam, id, tmin, triangleid);
+	return LocalEvent(part, tmin.first, WALL, *this, 8 * triangleid + tmin.second);
       }
 
+    //The boxes of the nodes are expanded by the particle radius, so
+    //the particle centre must enter them before it can touch a
+    //triangle
+    const Vector expansion = Vector(1, 1, 1) * (2 * (diam + _epsilon));
+    const Vector& pos = part.getPosition();
+
+    auto entry = [&](const Vector& min, const Vector& max) -> double
+      {
+	const Vector centre = 0.5 * (min + max);
+	const Vector width = max - min + expansion;
+
+	if (!_periodic)
+	  return Sim->dynamics->getBoxEntryTime(part, pos - centre, width);
+
+	//The triangles are tested against the image of the particle
+	//nearest to their first vertex, so test every image which
+	//is nearest to some point of the box
+	long kmin[NDIM], kmax[NDIM], k[NDIM];
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  {
+	    const double L = Sim->primaryCellSize[iDim];
+	    kmin[iDim] = std::ceil((min[iDim] - 0.5 * L - pos[iDim]) / L);
+	    kmax[iDim] = std::floor((max[iDim] + 0.5 * L - pos[iDim]) / L);
+	    if (kmax[iDim] < kmin[iDim]) return HUGE_VAL;
+	    k[iDim] = kmin[iDim];
+	  }
+
+	double retval = HUGE_VAL;
+	for (;;)
+	  {
+	    Vector image = pos - centre;
+	    for (size_t iDim(0); iDim < NDIM; ++iDim)
+	      image[iDim] += k[iDim] * Sim->primaryCellSize[iDim];
+	    retval = std::min(retval, Sim->dynamics->getBoxEntryTime(part, image, width));
+
+	    size_t iDim(0);
+	    for (; iDim < NDIM; ++iDim)
+	      if (++k[iDim] <= kmax[iDim])
+		break;
+	      else
+		k[iDim] = kmin[iDim];
+
+	    if (iDim == NDIM) break;
+	  }
+
+	return retval;
+      };
+
+    _bvh.search(entry, [&](size_t id) { testTriangle(part, diam, id, tmin, triangleid); }, tmin.first);
+
     return LocalEvent(part, tmin.first, WALL, *this, 8 * triangleid + tmin.second);
   }
 
+  bool
+  LTriangleMesh::isInCell(const Vector& origin, const Vector& width) const
+  {
+    if (!_useBVH) return true;
+
+    if (_bvh.empty()) return false;
+
+    //The triangles are tested against the particle image nearest to
+    //their first vertex, which is only one of the images of the box
+    //tested by the neighbour list if the mesh is inside the primary
+    //image
+    const magnet::containers::BVH::Node& root = _bvh.getNodes()[0];
+    if (_periodic)
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	if ((root.min[iDim] < -0.5 * Sim->primaryCellSize[iDim]) || (root.max[iDim] > 0.5 * Sim->primaryCellSize[iDim]))
+	  return true;
+
+    //The box, expanded by the largest particle radius
+    const Vector expansion = Vector(1, 1, 1) * (0.5 * _diameter->getMaxValue() + _epsilon);
+    const Vector min = origin - expansion;
+    const Vector max = origin + width + expansion;
+
+    auto overlaps = [&](const Vector& nodeMin, const Vector& nodeMax)
+      {
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  if ((nodeMax[iDim] < min[iDim]) || (nodeMin[iDim] > max[iDim]))
+	    return false;
+	return true;
+      };
+
+    //The search is stopped by lowering the limit below the entry
+    //time of the overlapping nodes
+    double limit(0);
+    _bvh.search([&](const Vector& nodeMin, const Vector& nodeMax) { return overlaps(nodeMin, nodeMax) ? 0.0 : HUGE_VAL; },
+		[&](size_t id)
+		{
+		  const Vector& A = _vertices[std::get<0>(_elements[id])];
+		  const Vector& B = _vertices[std::get<1>(_elements[id])];
+		  const Vector& C = _vertices[std::get<2>(_elements[id])];
+		  Vector triMin, triMax;
+		  for (size_t iDim(0); iDim < NDIM; ++iDim)
+		    {
+		      triMin[iDim] = std::min(A[iDim], std::min(B[iDim], C[iDim]));
+		      triMax[iDim] = std::max(A[iDim], std::max(B[iDim], C[iDim]));
+		    }
+		  if (overlaps(triMin, triMax)) limit = -1;
+		}, limit);
+
+    return limit < 0;
+  }
+
   void
   LTriangleMesh::runEvent(Particle& part, const LocalEvent& iEvent) const
   { 
@@ -146,8 +339,7 @@ namespace dynamo {
     //Now we're past the event update the scheduler and plugins
     Sim->ptrScheduler->fullUpdate(part);
   
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    Sim->signalEvent(iEvent, EDat);
   }
 
   void 
@@ -161,39 +353,41 @@ namespace dynamo {
 
     localName = XML.getAttribute("Name");
 
+    _vertices.clear();
+    _elements.clear();
+    _stlFile.clear();
+
+    if (XML.hasAttribute("STLFile"))
+      {
+	loadSTL(XML.getAttribute("STLFile"));
+	return;
+      }
+
     {//Load the vertex coordinates
-      std::istringstream is(XML.getNode("Vertices").getValue());
-      is.exceptions(std::ostringstream::badbit | std::ostringstream::failbit);
-      is.peek(); //Set the eof flag if needed
-      Vector tmp;
-      while (!is.eof())
-	{
-	  is >> tmp[0];
-	  if (is.eof()) M_throw() << "The vertex coordinates is not a multiple of 3";
+      const std::vector<double> coords 
+	= parseNumbers<double>(XML.getNode("Vertices").getValue(), 
+			       [](const char* str, char** end) { return std::strtod(str, end); }, "Vertices");
 
-	  is >> tmp[1];
-	  if (is.eof()) M_throw() << "The vertex coordinates is not a multiple of 3";
+      if (coords.size() % 3)
+	M_throw() << "The vertex coordinates is not a multiple of 3";
 
-	  is >> tmp[2];	  
-	  _vertices.push_back(tmp * Sim->units.unitLength());
-	}
+      _vertices.reserve(coords.size() / 3);
+      for (size_t i(0); i < coords.size(); i += 3)
+	_vertices.push_back(Vector(coords[i], coords[i + 1], coords[i + 2]) * Sim->units.unitLength());
     }
 
     {//Load the triangle elements
-      std::istringstream is(XML.getNode("Elements").getValue());
-      is.exceptions(std::ostringstream::badbit | std::ostringstream::failbit);
-      is.peek(); //Set the eof flag if needed
+      const std::vector<unsigned long long> ids
+	= parseNumbers<unsigned long long>(XML.getNode("Elements").getValue(), 
+					   [](const char* str, char** end) { return std::strtoull(str, end, 10); }, "Elements");
 
-      TriangleElements tmp;
-      while (!is.eof())
-	{
-	  is >> std::get<0>(tmp);
-	  if (is.eof()) M_throw() << "The triangle elements are not a multiple of 3";
-	  
-	  is >> std::get<1>(tmp);
-	  if (is.eof()) M_throw() << "The triangle elements are not a multiple of 3";
+      if (ids.size() % 3)
+	M_throw() << "The triangle elements are not a multiple of 3";
 
-	  is >> std::get<2>(tmp);
+      _elements.reserve(ids.size() / 3);
+      for (size_t i(0); i < ids.size(); i += 3)
+	{
+	  TriangleElements tmp(ids[i], ids[i + 1], ids[i + 2]);
 
 	  if ((std::get<0>(tmp) >= _vertices.size()) 
 	      || (std::get<1>(tmp) >= _vertices.size()) 
@@ -207,20 +401,95 @@ namespace dynamo {
 	  if (normal.nrm() == 0) 
 	    M_throw() << "Triangle " << _elements.size() << " has a zero normal!";
 
-
 	  _elements.push_back(tmp);
 	}
     }
   }
 
+  void
+  LTriangleMesh::loadSTL(const std::string& fileName)
+  {
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    if (!file)
+      M_throw() << "Could not open the STL file " << fileName;
+
+    //The count and vertices are copied straight out of the
+    //little-endian file
+    const uint32_t test = 1;
+    if (*reinterpret_cast<const unsigned char*>(&test) != 1)
+      M_throw() << "STL files can only be loaded on little-endian machines";
+
+    char header[80];
+    uint32_t count(0);
+    file.read(header, 80);
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    file.seekg(0, std::ios::end);
+    if (!file || (uint64_t(file.tellg()) != 84 + 50 * uint64_t(count)))
+      M_throw() << fileName << " is not a binary STL file (ASCII STL files are not supported)";
+    file.seekg(84);
+
+    //STL files store each triangle separately, so the shared
+    //vertices are merged
+    std::map<std::array<float, 3>, size_t> vertexIDs;
+    size_t degenerate(0);
+    for (uint32_t i(0); i < count; ++i)
+      {
+	char facet[50];
+	file.read(facet, 50);
+	if (!file)
+	  M_throw() << "Failed while reading " << fileName;
+
+	size_t ids[3];
+	for (size_t v(0); v < 3; ++v)
+	  {
+	    //The facet normal (ignored) is followed by the vertices
+	    std::array<float, 3> vertex;
+	    std::memcpy(vertex.data(), facet + 12 * (v + 1), 12);
+
+	    auto it = vertexIDs.find(vertex);
+	    if (it == vertexIDs.end())
+	      {
+		it = vertexIDs.insert(std::make_pair(vertex, _vertices.size())).first;
+		_vertices.push_back(Vector(vertex[0], vertex[1], vertex[2]) * Sim->units.unitLength());
+	      }
+	    ids[v] = it->second;
+	  }
+
+	const Vector normal = (_vertices[ids[1]] - _vertices[ids[0]]) ^ (_vertices[ids[2]] - _vertices[ids[1]]);
+	if (normal.nrm() == 0)
+	  {
+	    ++degenerate;
+	    continue;
+	  }
+
+	_elements.push_back(TriangleElements(ids[0], ids[1], ids[2]));
+      }
+
+    if (degenerate)
+      derr << "Skipped " << degenerate << " degenerate triangles in " << fileName << std::endl;
+
+    dout << "Loaded " << _elements.size() << " triangles and " << _vertices.size() 
+	 << " vertices from " << fileName << std::endl;
+
+    _stlFile = fileName;
+  }
+
   void 
   LTriangleMesh::outputXML(magnet::xml::XmlStream& XML) const
   {
     XML << magnet::xml::attr("Type") << "TriangleMesh" 
 	<< magnet::xml::attr("Name") << localName
 	<< magnet::xml::attr("Elasticity") << _e->getName()
-	<< magnet::xml::attr("Diameter") << _diameter->getName()
-	<< range;
+	<< magnet::xml::attr("Diameter") << _diameter->getName();
+
+    //Meshes loaded from STL files are not written out again
+    if (!_stlFile.empty())
+      {
+	XML << magnet::xml::attr("STLFile") << _stlFile << range;
+	return;
+      }
+
+    XML << range;
 
     XML << magnet::xml::tag("Vertices") << magnet::xml::chardata();
     for (Vector vert : _vertices)
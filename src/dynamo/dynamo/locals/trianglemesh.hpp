@@ -19,6 +19,7 @@
 #include <dynamo/locals/local.hpp>
 #include <dynamo/coilRenderObj.hpp>
 #include <dynamo/simulation.hpp>
+#include <magnet/containers/bvh.hpp>
 #include <tuple>
 #include <vector>
 
@@ -27,6 +28,18 @@
 #endif
 
 namespace dynamo {
+  /*! \brief A wall made of a mesh of triangles.
+
+    The vertices and triangles are either given in the Vertices and
+    Elements tags of the XML, or loaded from the binary STL file
+    named by the STLFile attribute.
+
+    For systems without boundary conditions or with
+    BCPeriodic, the triangles are stored in a bounding volume
+    hierarchy, so that predicting an event only tests the triangles
+    near the particle trajectory. For other boundary conditions
+    every triangle is tested.
+   */
   class LTriangleMesh: public Local, public CoilRenderObj
   {
   public:
@@ -38,11 +51,20 @@ namespace dynamo {
       _e(Sim->_properties.getProperty
 	 (e, Property::Units::Dimensionless())),
       _diameter(Sim->_properties.getProperty
-		(d, Property::Units::Length()))
+		(d, Property::Units::Length())),
+      _useBVH(false),
+      _periodic(false),
+      _epsilon(0)
     { localName = name; }
 
     virtual ~LTriangleMesh() {}
 
+    virtual void initialise(size_t);
+
+    //! \brief There is no run-time state to checkpoint.
+    virtual void saveCheckpoint(CheckpointWriter&) const {}
+    virtual void loadCheckpoint(CheckpointReader&) {}
+
     virtual LocalEvent getEvent(const Particle&) const;
 
     virtual void runEvent(Particle&, const LocalEvent&) const;
@@ -51,6 +73,8 @@ namespace dynamo {
 
     virtual bool validateState(const Particle& part, bool textoutput = true) const { return false; }
 
+    virtual bool isInCell(const Vector& origin, const Vector& width) const;
+
 #ifdef DYNAMO_visualizer
     virtual shared_ptr<coil::RenderObj> getCoilRenderObj() const;
     virtual void updateRenderData() const {}
@@ -63,6 +87,13 @@ namespace dynamo {
 
     virtual void outputXML(magnet::xml::XmlStream&) const;
 
+    //! \brief Loads the vertices and elements from a binary STL file.
+    void loadSTL(const std::string& fileName);
+
+    //! \brief Tests the particle against a triangle, keeping the earliest event.
+    void testTriangle(const Particle& part, double radius, size_t id,
+		      std::pair<double, size_t>& tmin, size_t& triangleid) const;
+
     std::vector<Vector> _vertices;
 
     typedef std::tuple<size_t, size_t, size_t> TriangleElements;
@@ -70,5 +101,17 @@ namespace dynamo {
 
     shared_ptr<Property> _e;
     shared_ptr<Property> _diameter;
+
+    //! \brief The STL file the mesh was loaded from, if any.
+    std::string _stlFile;
+
+    //! \brief The hierarchy of the triangle bounding boxes.
+    magnet::containers::BVH _bvh;
+    //! \brief If the hierarchy is used, false for unsupported boundary conditions.
+    bool _useBVH;
+    //! \brief If the particle images must be tested (for periodic boundary conditions).
+    bool _periodic;
+    //! \brief A small length to expand the boxes by, covering rounding errors.
+    double _epsilon;
   };
 }
@@ -16,6 +16,7 @@
 */
 
 #include <dynamo/outputplugins/collMatrix.hpp>
+#include <dynamo/outputplugins/eventbuffer.hpp>
 #include <dynamo/simulation.hpp>
 #include <dynamo/include.hpp>
 #include <dynamo/interactions/include.hpp>
@@ -26,6 +27,7 @@ namespace dynamo {
     OutputPlugin(tmp,"CollisionMatrix"),
     totalCount(0)
   {
+    _bufferedEvents = true;
   }
 
   void 
@@ -41,10 +43,10 @@ namespace dynamo {
   OPCollMatrix::eventUpdate(const IntEvent& iEvent, const PairEventData&)
   {
     newEvent(iEvent.getParticle1ID(), iEvent.getType(), 
-	     getClassKey(iEvent));
+	     getClassKey(iEvent), Sim->systemTime);
 
     newEvent(iEvent.getParticle2ID(), iEvent.getType(), 
-	     getClassKey(iEvent));
+	     getClassKey(iEvent), Sim->systemTime);
   }
 
 
@@ -53,15 +55,15 @@ namespace dynamo {
   {
     for (const ParticleEventData& pData : SDat.L1partChanges)
       newEvent(pData.getParticleID(), pData.getType(), 
-	       getClassKey(globEvent));  
+	       getClassKey(globEvent), Sim->systemTime);  
   
     for (const PairEventData& pData : SDat.L2partChanges)
       {
 	newEvent(pData.particle1_.getParticleID(), 
-		 pData.getType(), getClassKey(globEvent));
+		 pData.getType(), getClassKey(globEvent), Sim->systemTime);
 
 	newEvent(pData.particle2_.getParticleID(), 
-		 pData.getType(), getClassKey(globEvent));
+		 pData.getType(), getClassKey(globEvent), Sim->systemTime);
       }
   }
 
@@ -70,15 +72,15 @@ namespace dynamo {
   {
     for (const ParticleEventData& pData : SDat.L1partChanges)
       newEvent(pData.getParticleID(), 
-	       pData.getType(), getClassKey(localEvent));  
+	       pData.getType(), getClassKey(localEvent), Sim->systemTime);  
   
     for (const PairEventData& pData : SDat.L2partChanges)
       {
 	newEvent(pData.particle1_.getParticleID(), 
-		 pData.getType(), getClassKey(localEvent));
+		 pData.getType(), getClassKey(localEvent), Sim->systemTime);
 
 	newEvent(pData.particle2_.getParticleID(),
-		 pData.getType(), getClassKey(localEvent));
+		 pData.getType(), getClassKey(localEvent), Sim->systemTime);
       }
   }
 
@@ -86,34 +88,56 @@ namespace dynamo {
   OPCollMatrix::eventUpdate(const System& sysEvent, const NEventData& SDat, const double&)
   {
     for (const ParticleEventData& pData : SDat.L1partChanges)
-      newEvent(pData.getParticleID(), pData.getType(), getClassKey(sysEvent));
+      newEvent(pData.getParticleID(), pData.getType(), getClassKey(sysEvent), Sim->systemTime);
   
     for (const PairEventData& pData : SDat.L2partChanges)
       {
 	newEvent(pData.particle1_.getParticleID(), 
-		 pData.getType(), getClassKey(sysEvent));
+		 pData.getType(), getClassKey(sysEvent), Sim->systemTime);
 
 	newEvent(pData.particle2_.getParticleID(), 
-		 pData.getType(), getClassKey(sysEvent));  
+		 pData.getType(), getClassKey(sysEvent), Sim->systemTime);  
       } 
   }
 
 
+  void
+  OPCollMatrix::eventUpdate(const EventRecord* begin, const EventRecord* end)
+  {
+    for (const EventRecord* record = begin; record != end; ++record)
+      if (record->source.second == INTERACTION)
+	{
+	  newEvent(record->pairData.particle1_.getParticleID(), record->type, record->source, record->systemTime);
+	  newEvent(record->pairData.particle2_.getParticleID(), record->type, record->source, record->systemTime);
+	}
+      else
+	{
+	  for (const ParticleEventData& pData : record->NData.L1partChanges)
+	    newEvent(pData.getParticleID(), pData.getType(), record->source, record->systemTime);
+
+	  for (const PairEventData& pData : record->NData.L2partChanges)
+	    {
+	      newEvent(pData.particle1_.getParticleID(), pData.getType(), record->source, record->systemTime);
+	      newEvent(pData.particle2_.getParticleID(), pData.getType(), record->source, record->systemTime);
+	    }
+	}
+  }
+
   void 
-  OPCollMatrix::newEvent(const size_t& part, const EEventType& etype, const classKey& ck)
+  OPCollMatrix::newEvent(const size_t& part, const EEventType& etype, const classKey& ck, const long double& time)
   {
     if (lastEvent[part].second.first.second != NONE)
       {
 	counterData& refCount = counters[counterKey(eventKey(ck,etype), lastEvent[part].second)];
       
-	refCount.totalTime += Sim->systemTime - lastEvent[part].first;
+	refCount.totalTime += time - lastEvent[part].first;
 	++(refCount.count);
 	++(totalCount);
       }
     else
       ++initialCounter[eventKey(ck,etype)];
 
-    lastEvent[part].first = Sim->systemTime;
+    lastEvent[part].first = time;
     lastEvent[part].second = eventKey(ck, etype);
   }
 
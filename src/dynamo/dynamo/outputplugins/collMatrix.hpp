@@ -45,13 +45,15 @@ namespace dynamo {
 
     virtual void eventUpdate(const System&, const NEventData&, const double&);
 
+    virtual void eventUpdate(const EventRecord*, const EventRecord*);
+
     void output(magnet::xml::XmlStream &);
 
     //This is fine to replica exchange as the interaction, global and system lookups are done using names
     virtual void changeSystem(OutputPlugin* plug) { std::swap(Sim, static_cast<OPCollMatrix*>(plug)->Sim); }
   
   protected:
-    void newEvent(const size_t&, const EEventType&, const classKey&);
+    void newEvent(const size_t&, const EEventType&, const classKey&, const long double&);
   
     struct counterData
     {
@@ -16,6 +16,7 @@
 */
 
 #include <dynamo/outputplugins/colldistcheck.hpp>
+#include <dynamo/outputplugins/eventbuffer.hpp>
 #include <dynamo/include.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
@@ -26,6 +27,7 @@ namespace dynamo {
     OutputPlugin(t1,"CollDistCheck"),
     binwidth(0.01)
   {
+    _bufferedEvents = true;
     operator<<(XML);
   }
 
@@ -44,6 +46,31 @@ namespace dynamo {
       binwidth = XML.getAttribute("binwidth").as<double>();
   }
 
+  void
+  OPCollDistCheck::eventUpdate(const EventRecord* begin, const EventRecord* end)
+  {
+    for (const EventRecord* record = begin; record != end; ++record)
+      {
+	const eventKey locPair(record->source, record->type);
+
+	if (record->source.second == INTERACTION)
+	  {
+	    if (distList.find(locPair) == distList.end())
+	      distList[locPair] = magnet::math::Histogram<>(binwidth * Sim->units.unitLength());
+
+	    distList[locPair].addVal(record->pairData.rij.nrm());
+	    continue;
+	  }
+
+	if ((!record->NData.L2partChanges.empty())
+	    && (distList.find(locPair) == distList.end()))
+	  distList[locPair] = magnet::math::Histogram<>(binwidth * Sim->units.unitLength());
+
+	for (const PairEventData& dat : record->NData.L2partChanges)
+	  distList[locPair].addVal(dat.rij.nrm());
+      }
+  }
+
   void 
   OPCollDistCheck::eventUpdate(const IntEvent& eevent, 
 			       const PairEventData& PDat)
@@ -42,6 +42,8 @@ namespace dynamo {
   
     void eventUpdate(const System&, const NEventData&, const double&);
 
+    void eventUpdate(const EventRecord*, const EventRecord*);
+
     virtual void initialise();
 
     virtual void output(magnet::xml::XmlStream&);
@@ -0,0 +1,175 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/outputplugins/eventbuffer.hpp>
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/interactions/intEvent.hpp>
+#include <dynamo/globals/globEvent.hpp>
+#include <dynamo/locals/localEvent.hpp>
+#include <dynamo/systems/system.hpp>
+#include <dynamo/simulation.hpp>
+
+namespace dynamo {
+  OutputEventBuffer::OutputEventBuffer(const Simulation* sim, size_t capacity, bool threaded):
+    Sim(sim),
+    _records(2 * std::max(capacity / 2, size_t(1))),
+    _halfSize(_records.size() / 2),
+    _threaded(threaded),
+    _fillStart(0),
+    _filled(0),
+    _pendingStart(0),
+    _pending(0),
+    _shutdown(false)
+  {
+    if (_threaded)
+      _consumer = std::thread(&OutputEventBuffer::consumerLoop, this);
+  }
+
+  OutputEventBuffer::~OutputEventBuffer()
+  {
+    if (!_threaded) return;
+
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _shutdown = true;
+    }
+    _condition.notify_all();
+    _consumer.join();
+  }
+
+  EventRecord&
+  OutputEventBuffer::nextRecord(const EventTypeTracking::classKey& source, EEventType type, double dt)
+  {
+    EventRecord& record = _records[_fillStart + _filled];
+    record.source = source;
+    record.type = type;
+    record.dt = dt;
+    record.systemTime = Sim->systemTime;
+    return record;
+  }
+
+  void
+  OutputEventBuffer::push(const IntEvent& event, const PairEventData& data)
+  {
+    nextRecord(EventTypeTracking::getClassKey(event), event.getType(), event.getdt()).pairData = data;
+    if (++_filled == _halfSize) dispatch();
+  }
+
+  void
+  OutputEventBuffer::push(const GlobalEvent& event, const NEventData& data)
+  {
+    nextRecord(EventTypeTracking::getClassKey(event), event.getType(), event.getdt()).NData = data;
+    if (++_filled == _halfSize) dispatch();
+  }
+
+  void
+  OutputEventBuffer::push(const LocalEvent& event, const NEventData& data)
+  {
+    nextRecord(EventTypeTracking::getClassKey(event), event.getType(), event.getdt()).NData = data;
+    if (++_filled == _halfSize) dispatch();
+  }
+
+  void
+  OutputEventBuffer::push(const System& event, const NEventData& data, const double& dt)
+  {
+    nextRecord(EventTypeTracking::getClassKey(event), event.getType(), dt).NData = data;
+    if (++_filled == _halfSize) dispatch();
+  }
+
+  void
+  OutputEventBuffer::dispatch()
+  {
+    if (!_filled) return;
+
+    const EventRecord* begin = &_records[_fillStart];
+
+    if (!_threaded)
+      {
+	consume(begin, begin + _filled);
+	_filled = 0;
+	return;
+      }
+
+    {
+      //Wait for the consumer to release the other half before
+      //handing this one over
+      std::unique_lock<std::mutex> lock(_mutex);
+      _condition.wait(lock, [this]() { return _pending == 0; });
+      rethrowConsumerError();
+      _pendingStart = _fillStart;
+      _pending = _filled;
+    }
+    _condition.notify_all();
+
+    _fillStart = _halfSize - _fillStart;
+    _filled = 0;
+  }
+
+  void
+  OutputEventBuffer::flush()
+  {
+    dispatch();
+
+    if (!_threaded) return;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this]() { return _pending == 0; });
+    rethrowConsumerError();
+  }
+
+  void
+  OutputEventBuffer::consume(const EventRecord* begin, const EventRecord* end)
+  {
+    //Each plugin processes the whole batch in turn, to keep its data
+    //in the cache
+    for (const shared_ptr<OutputPlugin>& plugin : Sim->outputPlugins)
+      if (plugin->bufferedEvents())
+	plugin->eventUpdate(begin, end);
+  }
+
+  void
+  OutputEventBuffer::consumerLoop()
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;)
+      {
+	_condition.wait(lock, [this]() { return _pending || _shutdown; });
+	if (!_pending) return;
+
+	const EventRecord* begin = &_records[_pendingStart];
+	const EventRecord* end = begin + _pending;
+	lock.unlock();
+	try
+	  { consume(begin, end); }
+	catch (...)
+	  { _consumerError = std::current_exception(); }
+	lock.lock();
+
+	_pending = 0;
+	_condition.notify_all();
+      }
+  }
+
+  void
+  OutputEventBuffer::rethrowConsumerError()
+  {
+    if (!_consumerError) return;
+    std::exception_ptr error = _consumerError;
+    _consumerError = std::exception_ptr();
+    std::rethrow_exception(error);
+  }
+}
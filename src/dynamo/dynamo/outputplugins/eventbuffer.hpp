@@ -0,0 +1,112 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/outputplugins/eventtypetracking.hpp>
+#include <dynamo/NparticleEventData.hpp>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <vector>
+
+namespace dynamo {
+  class Simulation;
+
+  /*! \brief A copy of the data passed to the OutputPlugin-s for a
+      single event, as stored in the OutputEventBuffer.
+   */
+  struct EventRecord
+  {
+    //! \brief The ID and class (Interaction, Global, ...) of the source of the event.
+    EventTypeTracking::classKey source;
+    //! \brief The type of the event.
+    EEventType type;
+    //! \brief The time since the previous event.
+    double dt;
+    //! \brief The Simulation::systemTime just after the event.
+    long double systemTime;
+    //! \brief The event data of an Interaction event.
+    PairEventData pairData;
+    //! \brief The event data of a Global, Local or System event.
+    NEventData NData;
+  };
+
+  /*! \brief Collects the events for the OutputPlugin-s which can
+      process them in batches (see OutputPlugin::bufferedEvents).
+
+      Events are copied into one of two halves of a ring of
+      EventRecord-s. Once a half is full it is passed to the plugins
+      through OutputPlugin::eventUpdate(const EventRecord*, const
+      EventRecord*), while the other half is filled. If threaded, the
+      full half is processed on a consumer thread so that the analysis
+      overlaps with the event loop, otherwise it is processed
+      immediately.
+
+      Buffered plugins may only use the data in the EventRecord-s, as
+      the state of the Simulation will have moved on by the time the
+      records are processed. Any results of the plugins are only
+      complete after a call to flush.
+   */
+  class OutputEventBuffer
+  {
+  public:
+    OutputEventBuffer(const Simulation* sim, size_t capacity, bool threaded);
+    ~OutputEventBuffer();
+
+    void push(const IntEvent&, const PairEventData&);
+    void push(const GlobalEvent&, const NEventData&);
+    void push(const LocalEvent&, const NEventData&);
+    void push(const System&, const NEventData&, const double&);
+
+    /*! \brief Processes all of the buffered events and waits for
+        the consumer thread to finish.
+     */
+    void flush();
+
+    bool threaded() const { return _threaded; }
+
+  private:
+    EventRecord& nextRecord(const EventTypeTracking::classKey&, EEventType, double);
+
+    //! \brief Hands the filled half of the buffer to the plugins.
+    void dispatch();
+
+    void consume(const EventRecord* begin, const EventRecord* end);
+    void consumerLoop();
+    void rethrowConsumerError();
+
+    const Simulation* Sim;
+    std::vector<EventRecord> _records;
+    const size_t _halfSize;
+    const bool _threaded;
+    //! \brief The start of the half of the buffer being filled.
+    size_t _fillStart;
+    //! \brief The number of records in the half being filled.
+    size_t _filled;
+
+    std::thread _consumer;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    //! \brief The start of the half being processed by the consumer thread.
+    size_t _pendingStart;
+    //! \brief The number of records awaiting the consumer thread (0 if idle).
+    size_t _pending;
+    bool _shutdown;
+    std::exception_ptr _consumerError;
+  };
+}
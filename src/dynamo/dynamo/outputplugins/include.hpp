@@ -27,3 +27,4 @@
 #include <dynamo/outputplugins/intEnergyHist.hpp>
 #include <dynamo/outputplugins/msd.hpp>
 #include <dynamo/outputplugins/replexTrace.hpp>
+#include <dynamo/outputplugins/profile.hpp>
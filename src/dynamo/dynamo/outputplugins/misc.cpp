@@ -21,6 +21,8 @@
 #include <magnet/memUsage.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <dynamo/systems/tHalt.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <sys/time.h>
 #include <ctime>
 
@@ -50,6 +52,83 @@ namespace dynamo {
     _KE  = _KE.current() * scale;
   }
 
+  void
+  OPMisc::saveCheckpoint(CheckpointWriter& out) const
+  {
+    out.write(uint64_t(_counters.size()));
+    for (const auto& counter : _counters)
+      {
+	out.write(counter.first.first.first);
+	out.write(counter.first.first.second);
+	out.write(counter.first.second);
+	out.write(counter.second.count);
+	out.write(counter.second.netimpulse);
+      }
+
+    out.write(_dualEvents);
+    out.write(_singleEvents);
+    out.write(_virtualEvents);
+    out.write(_reverseEvents);
+
+    _KE.saveState(out);
+    _internalE.saveState(out);
+    _sysMomentum.saveState(out);
+    _kineticP.saveState(out);
+
+    _thermalConductivity.saveState(out);
+    _viscosity.saveState(out);
+    for (const auto& correlator : _thermalDiffusion)
+      correlator.saveState(out);
+    for (size_t spid1(0); spid1 < Sim->species.size(); ++spid1)
+      for (size_t spid2(spid1); spid2 < Sim->species.size(); ++spid2)
+	_mutualDiffusion[spid1 * Sim->species.size() + spid2].saveState(out);
+
+    out.write(_internalEnergy);
+    out.write(_speciesMomenta);
+    out.write(collisionalP);
+  }
+
+  void
+  OPMisc::loadCheckpoint(CheckpointReader& in)
+  {
+    uint64_t counters;
+    in.read(counters);
+    _counters.clear();
+    for (uint64_t i(0); i < counters; ++i)
+      {
+	CounterKey key;
+	in.read(key.first.first);
+	in.read(key.first.second);
+	in.read(key.second);
+	CounterData& data = _counters[key];
+	in.read(data.count);
+	in.read(data.netimpulse);
+      }
+
+    in.read(_dualEvents);
+    in.read(_singleEvents);
+    in.read(_virtualEvents);
+    in.read(_reverseEvents);
+
+    _KE.loadState(in);
+    _internalE.loadState(in);
+    _sysMomentum.loadState(in);
+    _kineticP.loadState(in);
+
+    //initialise has sized the species correlators
+    _thermalConductivity.loadState(in);
+    _viscosity.loadState(in);
+    for (auto& correlator : _thermalDiffusion)
+      correlator.loadState(in);
+    for (size_t spid1(0); spid1 < Sim->species.size(); ++spid1)
+      for (size_t spid2(spid1); spid2 < Sim->species.size(); ++spid2)
+	_mutualDiffusion[spid1 * Sim->species.size() + spid2].loadState(in);
+
+    in.read(_internalEnergy);
+    in.read(_speciesMomenta);
+    in.read(collisionalP);
+  }
+
   double 
   OPMisc::getMeankT() const
   {
@@ -505,7 +584,18 @@ namespace dynamo {
 	<< endtag("totMeanFreeTime")
 	<< tag("NegativeTimeEvents")
 	<< attr("Count") << _reverseEvents
-	<< endtag("NegativeTimeEvents")
+	<< endtag("NegativeTimeEvents");
+
+    //How much work the lazy deletion of interaction events costs
+    const Scheduler& scheduler = *Sim->ptrScheduler;
+    const size_t stale = scheduler.getStaleEventCount();
+    XML << tag("EventQueue")
+	<< attr("Invalidation") << (scheduler.eagerInvalidation() ? "Eager" : "Lazy")
+	<< attr("StaleEvents") << stale
+	<< attr("StaleFraction") << ((stale + Sim->eventCount) ? double(stale) / (stale + Sim->eventCount) : 0.0)
+	<< attr("EagerlyRemovedEvents") << scheduler.getEagerRemovalCount()
+	<< attr("RecalculatedEvents") << scheduler.getRecalculatedEventCount()
+	<< endtag("EventQueue")
 	<< tag("Memusage")
 	<< attr("MaxKiloBytes") << magnet::process_mem_usage()
 	<< endtag("Memusage")
@@ -57,6 +57,10 @@ namespace dynamo {
 
     void temperatureRescale(const double&);
 
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+
+    virtual void loadCheckpoint(CheckpointReader&);
+
     double getMeankT() const;
     double getMeanSqrkT() const;
     double getCurrentkT() const;
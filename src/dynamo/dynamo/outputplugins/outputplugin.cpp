@@ -28,7 +28,8 @@
 namespace dynamo {
   OutputPlugin::OutputPlugin(const dynamo::Simulation* tmp, const char *aName, unsigned char order):
     SimBase_const(tmp, aName),
-    updateOrder(order)
+    updateOrder(order),
+    _bufferedEvents(false)
   {
     dout << "Loaded" << std::endl;
   }
@@ -41,6 +42,12 @@ namespace dynamo {
   OutputPlugin::periodicOutput()
   {}
 
+  void
+  OutputPlugin::loadCheckpoint(CheckpointReader&)
+  {
+    derr << "This plugin does not support checkpoints, its results only cover the run since the checkpoint" << std::endl;
+  }
+
   std::ostream&
   OutputPlugin::I_Pcout() const
   {
@@ -168,6 +175,8 @@ namespace dynamo {
       return testGeneratePlugin<OPMSDOrientationalCorrelator>(Sim, XML);
     else if (!Name.compare("OrientationalOrder"))
       return testGeneratePlugin<OPOrientationalOrder>(Sim, XML);
+    else if (!Name.compare("Profile"))
+      return testGeneratePlugin<OPProfile>(Sim, XML);
     else
       M_throw() << Name << ", Unknown type of OutputPlugin encountered";
   }
@@ -30,6 +30,9 @@ namespace dynamo {
   class System;
   class LocalEvent;
   class IDRange;
+  struct EventRecord;
+  class CheckpointWriter;
+  class CheckpointReader;
 
   class OutputPlugin: public dynamo::SimBase_const
   {
@@ -47,10 +50,42 @@ namespace dynamo {
     virtual void eventUpdate(const LocalEvent&, const NEventData&) = 0;
 
     virtual void eventUpdate(const System&, const NEventData&, const double&) = 0;
+
+    /*! \brief Process a batch of events from the OutputEventBuffer.
+
+      This is only called for plugins where bufferedEvents() is true,
+      and then replaces the other eventUpdate functions. It may be
+      called from a separate thread to the simulation, so it must only
+      use the data in the records.
+     */
+    virtual void eventUpdate(const EventRecord* begin, const EventRecord* end) {}
+
+    /*! \brief If the plugin receives its events in batches through
+        the OutputEventBuffer (if one is in use).
+     */
+    inline bool bufferedEvents() const { return _bufferedEvents; }
+
+    inline const std::string& getPluginName() const { return name; }
   
     virtual void output(magnet::xml::XmlStream&);
   
     virtual void periodicOutput();
+
+    /*! \brief Writes the accumulated results of the plugin to a
+        checkpoint (see Simulation::writeCheckpoint).
+
+	Plugins which do not override this and loadCheckpoint begin
+	new averages when a run is continued from the checkpoint.
+     */
+    virtual void saveCheckpoint(CheckpointWriter&) const {}
+
+    /*! \brief Restores the results written by saveCheckpoint, after
+        initialise is called.
+
+	The default warns that the results of the plugin only cover the
+	run since the checkpoint.
+     */
+    virtual void loadCheckpoint(CheckpointReader&);
   
     static shared_ptr<OutputPlugin> getPlugin(const magnet::xml::Node&, const dynamo::Simulation*);
     static shared_ptr<OutputPlugin> getPlugin(const std::string, const dynamo::Simulation*);
@@ -76,5 +111,8 @@ namespace dynamo {
     //
     // Lets other plugins take data from plugins before/after they are updated
     unsigned char updateOrder;
+
+    //! \brief Set by plugins which implement the batched eventUpdate.
+    bool _bufferedEvents;
   };
 }
@@ -0,0 +1,119 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/outputplugins/profile.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/simulation.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <algorithm>
+
+namespace dynamo {
+  OPProfile::OPProfile(const dynamo::Simulation* t1, const magnet::xml::Node&):
+    OutputPlugin(t1, "Profile")
+  {}
+
+  OPProfile::~OPProfile()
+  {
+    if (Sim->ptrScheduler && (Sim->ptrScheduler->getProfiler() == &_profiler))
+      Sim->ptrScheduler->setProfiler(NULL);
+  }
+
+  void
+  OPProfile::initialise()
+  {
+    if (!Sim->ptrScheduler)
+      M_throw() << "The Profile plugin requires a Scheduler";
+
+    _profiler.reset();
+    Sim->ptrScheduler->setProfiler(&_profiler);
+  }
+
+  void
+  OPProfile::changeSystem(OutputPlugin* plug)
+  {
+    OPProfile& other = static_cast<OPProfile&>(*plug);
+    std::swap(Sim, other.Sim);
+    Sim->ptrScheduler->setProfiler(&_profiler);
+    other.Sim->ptrScheduler->setProfiler(&other._profiler);
+  }
+
+  void
+  OPProfile::output(magnet::xml::XmlStream& XML)
+  {
+    typedef std::pair<const EventProfiler::EventKey, EventProfiler::Counters> Entry;
+
+    EventProfiler::Counters totals;
+    for (const Entry& entry : _profiler.getCounters())
+      {
+	totals.count += entry.second.count;
+	for (size_t i(0); i < EventProfiler::PHASE_COUNT; ++i)
+	  totals.cycles[i] += entry.second.cycles[i];
+      }
+
+    uint64_t totalCycles(0);
+    for (size_t i(0); i < EventProfiler::PHASE_COUNT; ++i)
+      totalCycles += totals.cycles[i];
+
+    XML << magnet::xml::tag("Profile")
+	<< magnet::xml::attr("Passes") << totals.count
+	<< magnet::xml::attr("Cycles") << totalCycles
+	<< magnet::xml::attr("CyclesPerPass") << double(totalCycles) / std::max(totals.count, uint64_t(1));
+
+    for (size_t i(0); i < EventProfiler::PHASE_COUNT; ++i)
+      XML << magnet::xml::tag("Phase")
+	  << magnet::xml::attr("Name") << EventProfiler::getPhaseName(i)
+	  << magnet::xml::attr("Cycles") << totals.cycles[i]
+	  << magnet::xml::attr("Fraction") << double(totals.cycles[i]) / std::max(totalCycles, uint64_t(1))
+	  << magnet::xml::endtag("Phase");
+
+    for (const Entry& entry : _profiler.getCounters())
+      {
+	const EventTypeTracking::classKey& source = entry.first.first;
+	const EventProfiler::Counters& counters = entry.second;
+
+	uint64_t cycles(0);
+	for (size_t i(0); i < EventProfiler::PHASE_COUNT; ++i)
+	  cycles += counters.cycles[i];
+
+	XML << magnet::xml::tag("Event")
+	    << magnet::xml::attr("Type") << entry.first.second;
+
+	if (source.second == RECALCULATE)
+	  //Recalculations requested by the scheduler itself
+	  XML << magnet::xml::attr("Class") << "Scheduler";
+	else
+	  XML << magnet::xml::attr("Class") << EventTypeTracking::getClass(source)
+	      << magnet::xml::attr("Name") << EventTypeTracking::getName(source, Sim);
+
+	XML << magnet::xml::attr("Count") << counters.count
+	    << magnet::xml::attr("Cycles") << cycles
+	    << magnet::xml::attr("CyclesPerEvent") << double(cycles) / counters.count
+	    << magnet::xml::attr("Fraction") << double(cycles) / std::max(totalCycles, uint64_t(1));
+
+	for (size_t i(0); i < EventProfiler::PHASE_COUNT; ++i)
+	  if (counters.cycles[i])
+	    XML << magnet::xml::tag("Phase")
+		<< magnet::xml::attr("Name") << EventProfiler::getPhaseName(i)
+		<< magnet::xml::attr("CyclesPerEvent") << double(counters.cycles[i]) / counters.count
+		<< magnet::xml::endtag("Phase");
+
+	XML << magnet::xml::endtag("Event");
+      }
+
+    XML << magnet::xml::endtag("Profile");
+  }
+}
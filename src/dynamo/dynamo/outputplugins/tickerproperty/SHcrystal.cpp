@@ -15,25 +15,29 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <boost/math/special_functions/spherical_harmonic.hpp>
 #include <dynamo/outputplugins/tickerproperty/SHcrystal.hpp>
-#include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/globals/neighbourList.hpp>
 #include <dynamo/units/units.hpp>
 #include <dynamo/BC/BC.hpp>
-#include <boost/math/special_functions/spherical_harmonic.hpp>
-#include <magnet/math/wigner3J.hpp>
+#include <magnet/thread/threadpool.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
-#include <fstream>
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
 namespace dynamo {
+  namespace {
+    //! \brief The number of particles sampled by each task.
+    const size_t chunkSize = 1024;
+  }
+
   OPSHCrystal::OPSHCrystal(const dynamo::Simulation* tmp, const magnet::xml::Node& XML):
     OPTicker(tmp,"SHCrystal"), rg(1.2), maxl(7),
     nblistID(std::numeric_limits<size_t>::max()),
-    count(0)
+    count(0),
+    localQBinWidth(0.01),
+    localWBinWidth(0.001)
   {
     operator<<(XML);
   }
@@ -47,6 +51,12 @@ namespace dynamo {
     if (XML.hasAttribute("MaxL"))
       maxl = XML.getAttribute("MaxL").as<size_t>();
 
+    if (XML.hasAttribute("LocalQBinWidth"))
+      localQBinWidth = XML.getAttribute("LocalQBinWidth").as<double>();
+
+    if (XML.hasAttribute("LocalWBinWidth"))
+      localWBinWidth = XML.getAttribute("LocalWBinWidth").as<double>();
+
     rg *= Sim->units.unitLength();
 
 
@@ -76,9 +86,10 @@ namespace dynamo {
       M_throw() << "There is not a suitable neighbourlist for the cut-off radius selected."
 	"\nR_g = " << rg / Sim->units.unitLength();
 
-    globalcoeff.resize(maxl);
-    for (size_t l=0; l < maxl; ++l)
-      globalcoeff[l].resize(2*l+1,std::complex<double>(0,0));
+    _bop = magnet::math::BondOrderParameters(maxl);
+    globalcoeff.assign(_bop.size(), complex(0, 0));
+    _localQ.assign(maxl, magnet::math::Histogram<>(localQBinWidth));
+    _localW.assign(maxl, magnet::math::Histogram<>(localWBinWidth));
 
     ticker();
   }
@@ -86,21 +97,79 @@ namespace dynamo {
   void 
   OPSHCrystal::ticker()
   {
-    sphericalsum ssum(Sim, rg, maxl);
-  
-    for (const Particle& part : Sim->particles)
+    const size_t nCoeffs = _bop.size();
+    const size_t nChunks = (Sim->N + chunkSize - 1) / chunkSize;
+    _chunkCoeffs.assign(nChunks * nCoeffs, complex(0, 0));
+    _chunkCounts.assign(nChunks, 0);
+    _localValues.resize(2 * maxl * Sim->N);
+
+    auto sampleChunks = [&](size_t first, size_t last)
       {
-	std::unique_ptr<IDRange> ids(Sim->ptrScheduler->getParticleNeighbours(part));
-	for (const size_t& id1 : *ids)
-	  ssum(part, id1);
-      
-	for (size_t l(0); l < maxl; ++l)
-	  for (int m(-l); m <= static_cast<int>(l); ++m)
-	    globalcoeff[l][m+l] += ssum.coeffsum[l][m+l];
-      
-	count += ssum.count;
+	for (size_t chunk(first); chunk < last; ++chunk)
+	  sampleParticles(chunk * chunkSize, std::min(Sim->N, (chunk + 1) * chunkSize),
+			  &_chunkCoeffs[chunk * nCoeffs], _chunkCounts[chunk]);
+      };
+
+    if (Sim->threads && Sim->threads->getThreadCount())
+      Sim->threads->parallel_for(0, nChunks, sampleChunks, 1);
+    else
+      sampleChunks(0, nChunks);
+
+    //Sum the chunks in order, so the result is independent of the
+    //number of threads
+    for (size_t chunk(0); chunk < nChunks; ++chunk)
+      {
+	for (size_t i(0); i < nCoeffs; ++i)
+	  globalcoeff[i] += _chunkCoeffs[chunk * nCoeffs + i];
+	count += _chunkCounts[chunk];
+      }
 
-	ssum.clear();
+    for (size_t ID(0); ID < Sim->N; ++ID)
+      for (size_t l(0); l < maxl; ++l)
+	{
+	  const double* local = &_localValues[2 * maxl * ID];
+	  if (std::isnan(local[l])) continue;
+	  _localQ[l].addVal(local[l]);
+	  _localW[l].addVal(local[maxl + l]);
+	}
+  }
+
+  void
+  OPSHCrystal::sampleParticles(size_t begin, size_t end, complex* coeffsum, size_t& bondCount)
+  {
+    const GNeighbourList& nblist = static_cast<const GNeighbourList&>(*Sim->globals[nblistID]);
+    std::vector<complex> qlm(_bop.size());
+
+    for (size_t ID(begin); ID < end; ++ID)
+      {
+	const Particle& part = Sim->particles[ID];
+	std::fill(qlm.begin(), qlm.end(), complex(0, 0));
+	size_t bonds(0);
+
+	for (const size_t& ID2 : nblist.getParticleNeighbours(part))
+	  {
+	    if (ID2 == ID) continue;
+	    Vector rij = part.getPosition() - Sim->particles[ID2].getPosition();
+	    Sim->BCs->applyBC(rij);
+
+	    const double norm = rij.nrm();
+	    if (norm <= rg)
+	      {
+		_bop.addBond(rij / norm, &qlm[0]);
+		++bonds;
+	      }
+	  }
+
+	double* local = &_localValues[2 * maxl * ID];
+	for (size_t l(0); l < maxl; ++l)
+	  {
+	    local[l] = bonds ? _bop.Q(l, &qlm[0], 1.0 / bonds) : std::numeric_limits<double>::quiet_NaN();
+	    local[maxl + l] = _bop.W(l, &qlm[0]);
+	  }
+
+	for (size_t i(0); i < qlm.size(); ++i)
+	  coeffsum[i] += qlm[i];
+	bondCount += bonds;
       }
   }
 
@@ -112,89 +181,29 @@ namespace dynamo {
     for (int l(0); l < static_cast<int>(maxl); ++l)
       {
 	XML << magnet::xml::tag("Q")
-	    << magnet::xml::attr("l") << l;
-      
-	double Qsum(0);
-	for (int m(-l); m <= l; ++m)
-	  Qsum += std::norm(globalcoeff[l][m+l] / std::complex<double>(count, 0));
-      
-	XML << magnet::xml::attr("val")
-	    << std::sqrt(Qsum * 4.0 * M_PI / (2.0 * l + 1.0))
+	    << magnet::xml::attr("l") << l
+	    << magnet::xml::attr("val") << _bop.Q(l, &globalcoeff[0], 1.0 / count)
 	    << magnet::xml::endtag("Q");
       
 	XML << magnet::xml::tag("W")
-	    << magnet::xml::attr("l") << l;
-
-	std::complex<double> Wsum(0, 0);
-	for (int m1(-l); m1 <= l; ++m1)
-	  for (int m2(-l); m2 <= l; ++m2)
-	    {
-	      int m3 = -(m1+m2);
-	      if (std::abs(m3) <= l)
-		Wsum += std::complex<double>(magnet::math::wignerThreej(l,l,l,m1,m2,m3) 
-					     * std::pow(count,-3.0), 0)
-		  * globalcoeff[l][m1+l]
-		  * globalcoeff[l][m2+l]
-		  * globalcoeff[l][l-(m1+m2)]
-		  ;
-	    }
-      
-	XML << magnet::xml::attr("val")
-	    << Wsum * std::pow(Qsum, -1.5)
+	    << magnet::xml::attr("l") << l
+	    << magnet::xml::attr("val") << _bop.W(l, &globalcoeff[0])
 	    << magnet::xml::endtag("W");
       }
 
-    XML << magnet::xml::endtag("SHCrystal");
-  }
-
-  OPSHCrystal::sphericalsum::sphericalsum
-  (const dynamo::Simulation * const nSim, const double& nrg, const size_t& nl):
-    Sim(nSim), rg(nrg), maxl(nl), count(0)
-  {
-    coeffsum.resize(maxl);
-    for (size_t l=0; l < maxl; ++l)
-      coeffsum[l].resize(2*l+1,std::complex<double>(0,0));
-  }
-
-  void 
-  OPSHCrystal::sphericalsum::operator()
-    (const Particle& part, const size_t& ID) const
-  {
-    if (part.getID() == ID) return;
-    Vector rij = part.getPosition() - Sim->particles[ID].getPosition();
-    Sim->BCs->applyBC(rij);
-  
-    double norm = rij.nrm();
-    if (norm <= rg)
+    for (int l(0); l < static_cast<int>(maxl); ++l)
       {
-	++count;
-	rij /= norm;
-	double theta = std::acos(rij[0]);
-	double sintheta = std::sin(theta);
-	double phi = rij[1] / sintheta;
-      
-	if (fabs(phi) > 1.0)
-	  phi = (phi > 0) ? 0.5 * M_PI : 1.5 * M_PI;
-	else
-	  phi = std::asin(phi);
-
-	if (std::sin(theta) == 0) phi = 0;
-      
-	if (phi < 0) phi += 2.0 * M_PI;
+	XML << magnet::xml::tag("LocalQ")
+	    << magnet::xml::attr("l") << l;
+	_localQ[l].outputHistogram(XML, 1.0);
+	XML << magnet::xml::endtag("LocalQ");
 
-	for (size_t l(0); l < maxl; ++l)
-	  for (int m(-l); m <= static_cast<int>(l); ++m)
-	    coeffsum[l][m+l] += boost::math::spherical_harmonic(l,m,theta,phi);
+	XML << magnet::xml::tag("LocalW")
+	    << magnet::xml::attr("l") << l;
+	_localW[l].outputHistogram(XML, 1.0);
+	XML << magnet::xml::endtag("LocalW");
       }
-  }
-
-  void
-  OPSHCrystal::sphericalsum::clear()
-  {
-    count = 0;
 
-    for (size_t l(0); l < maxl; ++l)
-      for (int m(-l); m <= static_cast<int>(l); ++m)
-	coeffsum[l][m+l] = std::complex<double>(0,0);
+    XML << magnet::xml::endtag("SHCrystal");
   }
 }
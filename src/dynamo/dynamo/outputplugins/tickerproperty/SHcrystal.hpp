@@ -17,11 +17,28 @@
 
 #pragma once
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
+#include <magnet/math/bondorder.hpp>
+#include <magnet/math/histogram.hpp>
 #include <vector>
 #include <complex>
 
 namespace dynamo {
   class Particle;
+
+  /*! \brief Samples the Steinhardt bond-order parameters, \f$Q_l\f$
+      and \f$\hat W_l\f$, of the bonds shorter than a cut-off radius.
+
+      The global parameters are averaged over every bond of every
+      sample. The local parameters, \f$q_l(i)\f$ and \f$\hat
+      w_l(i)\f$, are calculated from the bonds of each particle and
+      histogrammed over every particle with at least one bond.
+
+      The bonds are found using the smallest neighbour list which
+      supports the cut-off radius. The particles are split into
+      fixed-size chunks which are processed in parallel if the
+      Simulation has a thread pool. The results do not depend on the
+      number of threads.
+   */
   class OPSHCrystal: public OPTicker
   {
   public:
@@ -38,31 +55,36 @@ namespace dynamo {
     virtual void operator<<(const magnet::xml::Node&);
 
   protected:
+    typedef magnet::math::BondOrderParameters::complex complex;
 
-    std::complex<double> localq(const Particle& part, int l, int m);
+    /*! \brief Calculates the local order parameters of the particles
+        with IDs in [begin, end).
+
+	The coefficients of all the bonds are added to coeffsum and
+	the number of bonds to bondCount.
+     */
+    void sampleParticles(size_t begin, size_t end, complex* coeffsum, size_t& bondCount);
 
     //! Cut-off radius 
     double rg;
     size_t maxl;
     size_t nblistID;
     long count;
-  
-    std::vector<std::vector<std::complex<double> > > globalcoeff;
-
-    struct sphericalsum
-    {
-      sphericalsum(const dynamo::Simulation * const, 
-		   const double&, const size_t&);
-    
-      void operator()(const Particle&, const size_t&) const;
-    
-      void clear();
-
-      const dynamo::Simulation* const Sim;
-      const double rg;
-      const size_t maxl;
-      mutable size_t count;
-      mutable std::vector<std::vector<std::complex<double> > > coeffsum;
-    };
+    //! \brief The bin widths of the histograms of the local \f$q_l\f$ and \f$\hat w_l\f$.
+    double localQBinWidth, localWBinWidth;
+
+    magnet::math::BondOrderParameters _bop;
+
+    //! \brief The sum of the spherical harmonics of every bond, see BondOrderParameters::index.
+    std::vector<complex> globalcoeff;
+
+    std::vector<magnet::math::Histogram<> > _localQ;
+    std::vector<magnet::math::Histogram<> > _localW;
+
+    //! \brief The local \f$q_l\f$ (then \f$\hat w_l\f$) of each particle in the current sample, NaN if it has no bonds.
+    std::vector<double> _localValues;
+    //! \brief The coefficients and bond count of each chunk of particles.
+    std::vector<complex> _chunkCoeffs;
+    std::vector<size_t> _chunkCounts;
   };
 }
@@ -19,8 +19,14 @@
 #include <dynamo/outputplugins/misc.hpp>
 #include <dynamo/include.hpp>
 #include <dynamo/dynamics/dynamics.hpp>
+#include <dynamo/globals/neighbourList.hpp>
+#include <dynamo/BC/LEBC.hpp>
+#include <magnet/thread/threadpool.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <typeinfo>
+#include <algorithm>
+#include <cmath>
 
 namespace dynamo {
   OPRadialDistribution::OPRadialDistribution(const dynamo::Simulation* tmp, 
@@ -32,6 +38,8 @@ namespace dynamo {
     sample_energy(0),
     sample_energy_bin_width(0)
   { 
+    std::fill(_gridCells, _gridCells + NDIM, 0);
+
     if (NDIM != 3)
       M_throw() << "This plugin will not work as I've not correctly calculated "
 	"the volume of a shell";
@@ -123,21 +131,158 @@ namespace dynamo {
       }
     
     ++sampleCount;
-  
-    for (const shared_ptr<Species>& sp1 : Sim->species)
-      for (const shared_ptr<Species>& sp2 : Sim->species)
-      for (const size_t& p1 : *sp1->getRange())
-      for (const size_t& p2 : *sp2->getRange())
+
+    const size_t NSpecies = Sim->species.size();
+    _speciesID.assign(Sim->N, NSpecies);
+    for (const shared_ptr<Species>& sp : Sim->species)
+      for (const size_t& p : *sp->getRange())
+	_speciesID[p] = sp->getID();
+
+    //Pairs at or beyond this distance are past the last bin
+    const double cutoff = (length - 0.5) * binWidth;
+
+    //Use the neighbour list of the scheduler if it reaches far
+    //enough, it always returns each neighbour once. The sheared
+    //cells of Lees-Edwards BCs are skipped to be safe.
+    const GNeighbourList* nblist = NULL;
+    if (!std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs))
+      for (const shared_ptr<Global>& glob : Sim->globals)
+	if (glob->getName() == "SchedulerNBList")
+	  {
+	    nblist = dynamic_cast<const GNeighbourList*>(glob.get());
+	    if (nblist && (nblist->getMaxSupportedInteractionLength() < cutoff))
+	      nblist = NULL;
+	  }
+
+    std::fill(_gridCells, _gridCells + NDIM, 0);
+    if (!nblist && (typeid(*Sim->BCs) == typeid(BCPeriodic)))
+      buildGrid(cutoff);
+
+    const size_t histogramSize = NSpecies * NSpecies * length;
+    const size_t nChunks = (Sim->threads && Sim->threads->getThreadCount()) ? 4 * Sim->threads->getThreadCount() : 1;
+    _chunkData.resize(nChunks);
+    for (std::vector<unsigned long>& histogram : _chunkData)
+      histogram.assign(histogramSize, 0);
+
+    if (nChunks == 1)
+      sampleParticles(0, Sim->N, _chunkData[0], nblist);
+    else
+      Sim->threads->parallel_for(0, nChunks, [&](size_t first, size_t last) {
+	  for (size_t chunk(first); chunk < last; ++chunk)
+	    sampleParticles(chunk * Sim->N / nChunks, (chunk + 1) * Sim->N / nChunks, _chunkData[chunk], nblist);
+	}, 1);
+
+    for (const std::vector<unsigned long>& histogram : _chunkData)
+      for (size_t s1(0); s1 < NSpecies; ++s1)
+	for (size_t s2(0); s2 < NSpecies; ++s2)
+	  for (size_t i(0); i < length; ++i)
+	    data[s1][s2][i] += histogram[(s1 * NSpecies + s2) * length + i];
+  }
+
+  void
+  OPRadialDistribution::buildGrid(double cutoff)
+  {
+    size_t NCells(1);
+    for (size_t iDim(0); iDim < NDIM; ++iDim)
       {
-	Vector  rij = Sim->particles[p1].getPosition()
-	  - Sim->particles[p2].getPosition();
-	
-	Sim->BCs->applyBC(rij);
-	
-	size_t i = (long) (((rij.nrm())/binWidth) + 0.5);
-	
-	if (i < length)
-	  ++data[sp1->getID()][sp2->getID()][i];
+	_gridCells[iDim] = std::max(size_t(1), size_t(Sim->primaryCellSize[iDim] / cutoff));
+	NCells *= _gridCells[iDim];
+      }
+
+    //A counting sort of the particles into the cells
+    _gridCell.resize(Sim->N);
+    _gridStart.assign(NCells + 1, 0);
+    for (const Particle& part : Sim->particles)
+      {
+	Vector pos = part.getPosition();
+	Sim->BCs->applyBC(pos);
+
+	size_t cell(0);
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  {
+	    const long coord = std::floor((pos[iDim] / Sim->primaryCellSize[iDim] + 0.5) * _gridCells[iDim]);
+	    cell = cell * _gridCells[iDim] + std::min(size_t(std::max(coord, 0l)), _gridCells[iDim] - 1);
+	  }
+	_gridCell[part.getID()] = cell;
+	++_gridStart[cell + 1];
+      }
+
+    for (size_t cell(0); cell < NCells; ++cell)
+      _gridStart[cell + 1] += _gridStart[cell];
+
+    std::vector<size_t> fill(_gridStart.begin(), _gridStart.end() - 1);
+    _gridParticles.resize(Sim->N);
+    for (size_t ID(0); ID < Sim->N; ++ID)
+      _gridParticles[fill[_gridCell[ID]]++] = ID;
+  }
+
+  void
+  OPRadialDistribution::sampleParticles(size_t begin, size_t end, std::vector<unsigned long>& histogram, const GNeighbourList* nblist) const
+  {
+    const size_t NSpecies = Sim->species.size();
+
+    for (size_t p1(begin); p1 < end; ++p1)
+      {
+	const size_t s1 = _speciesID[p1];
+	if (s1 == NSpecies) continue;
+
+	const Vector r1 = Sim->particles[p1].getPosition();
+	unsigned long* const row = &histogram[s1 * NSpecies * length];
+	auto addPair = [&](const size_t p2)
+	  {
+	    const size_t s2 = _speciesID[p2];
+	    if (s2 == NSpecies) return;
+
+	    Vector rij = r1 - Sim->particles[p2].getPosition();
+	    Sim->BCs->applyBC(rij);
+	    const size_t i = (long) ((rij.nrm() / binWidth) + 0.5);
+	    if (i < length)
+	      ++row[s2 * length + i];
+	  };
+
+	if (nblist)
+	  {
+	    const IDRangeList ids = nblist->getParticleNeighbours(Sim->particles[p1]);
+	    for (const size_t p2 : ids.getContainer())
+	      addPair(p2);
+	  }
+	else if (_gridCells[0])
+	  {
+	    //The cells to visit in each dimension, every cell if
+	    //there are fewer than three
+	    size_t coords[NDIM], cells[NDIM][3], counts[NDIM];
+	    for (size_t iDim(NDIM), cell(_gridCell[p1]); iDim-- > 0;)
+	      {
+		coords[iDim] = cell % _gridCells[iDim];
+		cell /= _gridCells[iDim];
+		counts[iDim] = std::min(_gridCells[iDim], size_t(3));
+		for (size_t j(0); j < counts[iDim]; ++j)
+		  cells[iDim][j] = (_gridCells[iDim] < 3) ? j : (coords[iDim] + _gridCells[iDim] + j - 1) % _gridCells[iDim];
+	      }
+
+	    size_t idx[NDIM] = {0};
+	    for (;;)
+	      {
+		size_t cell(0);
+		for (size_t iDim(0); iDim < NDIM; ++iDim)
+		  cell = cell * _gridCells[iDim] + cells[iDim][idx[iDim]];
+
+		for (size_t j(_gridStart[cell]); j < _gridStart[cell + 1]; ++j)
+		  addPair(_gridParticles[j]);
+
+		size_t iDim(NDIM);
+		while (iDim-- > 0)
+		  if (++idx[iDim] < counts[iDim])
+		    break;
+		  else
+		    idx[iDim] = 0;
+
+		if (iDim == size_t(-1)) break;
+	      }
+	  }
+	else
+	  for (size_t p2(0); p2 < Sim->N; ++p2)
+	    addPair(p2);
       }
   }
 
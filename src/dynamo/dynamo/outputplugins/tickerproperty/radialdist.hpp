@@ -19,9 +19,29 @@
 
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
 #include <magnet/math/histogram.hpp>
+#include <magnet/math/vector.hpp>
 #include <vector>
 
 namespace dynamo {
+  class GNeighbourList;
+
+  /*! \brief Samples the radial distribution function, g(r), of
+      every pair of Species.
+
+      Only the pairs closer than the end of the histogram are
+      visited. The neighbours of each particle are taken from the
+      neighbour list of the Scheduler if it supports the cut off
+      distance. Otherwise, for periodic boundary conditions, the
+      particles are sorted into a private grid of cells at least as
+      wide as the cut off. Only in the remaining cases (e.g., Lees
+      Edwards boundary conditions without a large enough neighbour
+      list) is every pair tested. Each sample is therefore O(N) for
+      a fixed histogram length.
+
+      If the Simulation has a thread pool, the particles are split
+      into chunks which are sampled into separate histograms in
+      parallel, and then summed.
+   */
   class OPRadialDistribution: public OPTicker
   {
   public:
@@ -45,5 +65,29 @@ namespace dynamo {
     double sample_energy; 
     double sample_energy_bin_width;
     std::vector<std::vector<std::vector<unsigned long> > > data;
+
+    /*! \brief Adds the pairs of the particles with IDs in [begin,
+        end) to a flattened histogram.
+
+	\param nblist The neighbour list to use, or NULL to use the
+	cell grid (if built) or test every pair.
+     */
+    void sampleParticles(size_t begin, size_t end, std::vector<unsigned long>& histogram, const GNeighbourList* nblist) const;
+
+    //! \brief Sorts the particles into the private cell grid.
+    void buildGrid(double cutoff);
+
+    //! \brief The Species ID of each particle (or the number of Species if it has none).
+    std::vector<size_t> _speciesID;
+    //! \brief The number of cells in each dimension of the private grid, zero if it is not used.
+    size_t _gridCells[NDIM];
+    //! \brief The offset of the first particle of each cell in _gridParticles, with a final entry for the end.
+    std::vector<size_t> _gridStart;
+    //! \brief The IDs of the particles, sorted by their cell.
+    std::vector<size_t> _gridParticles;
+    //! \brief The cell of each particle.
+    std::vector<size_t> _gridCell;
+    //! \brief The histogram of each chunk of particles.
+    std::vector<std::vector<unsigned long> > _chunkData;
   };
 }
@@ -15,204 +15,132 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <dynamo/outputplugins/trajectory.hpp>
-
 #include <dynamo/units/units.hpp>
 #include <dynamo/globals/globEvent.hpp>
 #include <dynamo/interactions/intEvent.hpp>
 #include <dynamo/locals/localEvent.hpp>
 #include <dynamo/NparticleEventData.hpp>
 #include <dynamo/systems/system.hpp>
-#include <dynamo/BC/BC.hpp>
-#include <iomanip>
+#include <dynamo/simulation.hpp>
+#include <magnet/xmlreader.hpp>
+#include <cstring>
 
 namespace dynamo {
-  OPTrajectory::OPTrajectory(const dynamo::Simulation* t1, const magnet::xml::Node&):
-    OutputPlugin(t1,"Trajectory")
-  {}
-
-  OPTrajectory::OPTrajectory(const OPTrajectory& trj):
-    OutputPlugin(trj)
+  OPTrajectory::OPTrajectory(const dynamo::Simulation* t1, const magnet::xml::Node& XML):
+    OutputPlugin(t1,"Trajectory"),
+    _fileName("trajectory.dyntraj"),
+    _compression(EventLogHeader::NONE),
+    _chunkSize(65536)
   {
-    if (trj.logfile.is_open())
-      trj.logfile.close();
+    operator<<(XML);
   }
 
   void
-  OPTrajectory::initialise()
+  OPTrajectory::operator<<(const magnet::xml::Node& XML)
   {
-    if (logfile.is_open())
-      logfile.close();
- 
-    logfile.open("trajectory.out", std::ios::out|std::ios::trunc);
-    logfile.precision(4);
-    logfile.setf(std::ios::fixed);
+    if (XML.hasAttribute("FileName"))
+      _fileName = XML.getAttribute("FileName").as<std::string>();
+
+    if (XML.hasAttribute("Compression"))
+      _compression = eventLogCompression(XML.getAttribute("Compression").as<std::string>());
+
+    if (XML.hasAttribute("ChunkSize"))
+      _chunkSize = XML.getAttribute("ChunkSize").as<size_t>();
   }
 
   void
-  OPTrajectory::printData(const size_t& p1,
-			  const size_t& p2) const
+  OPTrajectory::initialise()
   {
-    size_t id1 = ((p1 < p2) 
-		  ? p1 : p2);
-  
-    size_t id2 = ((p1 > p2) 
-		  ? p1 : p2);
-
-    Vector  rij = Sim->particles[id1].getPosition()
-      - Sim->particles[id2].getPosition(),
-      vij = Sim->particles[id1].getVelocity()
-      - Sim->particles[id2].getVelocity();
-  
-
-    Sim->BCs->applyBC(rij, vij);
-  
-    rij /= Sim->units.unitLength();
-    vij /= Sim->units.unitVelocity();
-
-    logfile << " p1 " << std::setw(5) << id1
-	    << " p2 " << std::setw(5) << id2
-	    << " |r12| " << std::setw(5) << rij.nrm()
-	    << " post-r12 < ";
-  
-    for (size_t iDim(0); iDim < NDIM; ++iDim)
-      logfile << std::setw(7) << rij[iDim] << " ";
-
-    logfile << ">";
-
-    logfile << " post-v12 < ";
-    for (size_t iDim(0); iDim < NDIM; ++iDim)
-      logfile << std::setw(7) << vij[iDim] << " ";
-
-    logfile << "> post-rvdot " << (vij | rij) ;
+    //Close any previous log before the file is truncated
+    _log.reset();
+    _log.reset(new EventLogWriter(_fileName, Sim->particles.size(), _compression, _chunkSize));
   }
 
-  void 
-  OPTrajectory::eventUpdate(const IntEvent& eevent, 
-			    const PairEventData& pdat)
+  EventLogRecord
+  OPTrajectory::makeRecord(EEventType sourceClass, size_t sourceID, EEventType type) const
   {
-    logfile << std::setw(8) << Sim->eventCount
-	    << " INTERACTION " << eevent.getInteractionID()
-	    << " TYPE " << eevent.getType()
-	    << " t " << std::setw(5) << Sim->systemTime / Sim->units.unitTime() 
-	    << " dt " << std::setw(5) << eevent.getdt() / Sim->units.unitTime();
-
-    logfile << " deltaP1 < ";
-    for (size_t iDim(0); iDim < NDIM; ++iDim)
-      logfile << std::setw(7) 
-	      << ((eevent.getParticle1ID() < eevent.getParticle2ID())? -1 : 1) 
-	* pdat.impulse[iDim] << " ";
-
-    logfile << " >";
-  
-    printData(eevent.getParticle1ID(),
-	      eevent.getParticle2ID());
-  
-    logfile << "\n";
+    EventLogRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.eventCount = Sim->eventCount;
+    record.time = Sim->systemTime / Sim->units.unitTime();
+    record.sourceClass = sourceClass;
+    record.sourceID = sourceID;
+    record.type = type;
+    record.particle1 = eventLogNoParticle;
+    record.particle2 = eventLogNoParticle;
+    return record;
   }
 
-  void 
-  OPTrajectory::eventUpdate(const GlobalEvent& eevent, 
-			    const NEventData& SDat)
+  void
+  OPTrajectory::addChange(EventLogRecord& record, const ParticleEventData& pData) const
   {
-    logfile << std::setw(8) << Sim->eventCount
-	    << " GLOBAL " << eevent.getGlobalID()
-	    << " TYPE " << eevent.getType()
-	    << " t " << Sim->systemTime / Sim->units.unitTime() 
-	    << " dt " << eevent.getdt() / Sim->units.unitTime()
-	    << "\n";
+    const Particle& part = Sim->particles[pData.getParticleID()];
+    const double mass = Sim->species[pData.getSpeciesID()]->getMass(part.getID());
 
-    for (const ParticleEventData& pData : SDat.L1partChanges)
+    if (record.particle1 == eventLogNoParticle)
       {
-	const Particle& part = Sim->particles[pData.getParticleID()];
-	logfile << "    1PEvent p1 " << part.getID();
-	Vector delP = Sim->species[pData.getSpeciesID()]->getMass(part.getID()) * (part.getVelocity() - pData.getOldVel());
-	delP /= Sim->units.unitMomentum();
-	Vector pos = part.getPosition() / Sim->units.unitLength();
-	Vector oldv = pData.getOldVel() / Sim->units.unitVelocity();
-	Vector newv = part.getVelocity() / Sim->units.unitVelocity();
-	logfile << " delP1=" << delP.toString() << ", pos=" << pos.toString() << ", vel=" << newv.toString() << ", oldvel=" << oldv.toString() << "\n";
+	record.particle1 = part.getID();
+	const Vector delP = mass * (part.getVelocity() - pData.getOldVel()) / Sim->units.unitMomentum();
+	for (size_t iDim(0); iDim < 3; ++iDim)
+	  record.deltaP[iDim] = delP[iDim];
       }
-  
-    for (const PairEventData& pData : SDat.L2partChanges)
-      {
-	logfile << "    2PEvent";
-
-	printData(pData.particle1_.getParticleID(),
-		  pData.particle2_.getParticleID());
+    else
+      record.particle2 = part.getID();
 
-	logfile << "\n";
-      }
+    record.deltaKE += 0.5 * mass * (part.getVelocity().nrm2() - pData.getOldVel().nrm2()) / Sim->units.unitEnergy();
+    record.deltaU += pData.getDeltaU() / Sim->units.unitEnergy();
   }
 
-  void 
-  OPTrajectory::eventUpdate(const LocalEvent& eevent, 
-			    const NEventData& SDat)
+  void
+  OPTrajectory::writeEvent(const NEventData& SDat, EEventType sourceClass, size_t sourceID, EEventType type)
   {
-    logfile << std::setw(8) << Sim->eventCount 
-	    << " LOCAL " << eevent.getLocalID()
-	    << " TYPE " << eevent.getType()
-	    << " t " << Sim->systemTime / Sim->units.unitTime() 
-	    << " dt " << eevent.getdt() / Sim->units.unitTime()
-	    << "\n";
+    if (SDat.L1partChanges.empty() && SDat.L2partChanges.empty())
+      {
+	_log->push(makeRecord(sourceClass, sourceID, type));
+	return;
+      }
 
     for (const ParticleEventData& pData : SDat.L1partChanges)
       {
-	const Particle& part = Sim->particles[pData.getParticleID()];
-	logfile << "    1PEvent p1 " << part.getID();
-	Vector delP = Sim->species[pData.getSpeciesID()]->getMass(part.getID()) * (part.getVelocity() - pData.getOldVel());
-	delP /= Sim->units.unitMomentum();
-	Vector pos = part.getPosition() / Sim->units.unitLength();
-	Vector oldv = pData.getOldVel() / Sim->units.unitVelocity();
-	Vector newv = part.getVelocity() / Sim->units.unitVelocity();
-	logfile << " delP1=" << delP.toString() << ", pos=" << pos.toString() << ", vel=" << newv.toString() << ", oldvel=" << oldv.toString() << "\n";
+	EventLogRecord record = makeRecord(sourceClass, sourceID, pData.getType());
+	addChange(record, pData);
+	_log->push(record);
       }
 
     for (const PairEventData& pData : SDat.L2partChanges)
       {
-	logfile << "    2PEvent";
-      
-	printData(pData.particle1_.getParticleID(),
-		  pData.particle2_.getParticleID());
-      
-	logfile << "\n";
+	EventLogRecord record = makeRecord(sourceClass, sourceID, pData.getType());
+	addChange(record, pData.particle1_);
+	addChange(record, pData.particle2_);
+	_log->push(record);
       }
   }
 
   void 
-  OPTrajectory::eventUpdate(const System& sys, const NEventData& SDat, 
-			    const double& dt)
+  OPTrajectory::eventUpdate(const IntEvent& eevent, const PairEventData& pdat)
   {
-    logfile << std::setw(8) << Sim->eventCount
-	    << " SYSTEM " << sys.getID()
-	    << " TYPE " << sys.getType()
-	    << " t " << Sim->systemTime / Sim->units.unitTime() 
-	    << " dt " << dt / Sim->units.unitTime()
-	    << "\n";
-
-    for (const ParticleEventData& pData : SDat.L1partChanges)
-      {
-	const Particle& part = Sim->particles[pData.getParticleID()];
-	logfile << "    1PEvent p1 " << part.getID();
-	Vector delP = Sim->species[pData.getSpeciesID()]->getMass(part.getID()) * (part.getVelocity() - pData.getOldVel());
-	delP /= Sim->units.unitMomentum();
-	Vector pos = part.getPosition() / Sim->units.unitLength();	
-	Vector oldv = pData.getOldVel() / Sim->units.unitVelocity();
-	Vector newv = part.getVelocity() / Sim->units.unitVelocity();
-	logfile << " delP1=" << delP.toString() << ", pos=" << pos.toString() << ", vel=" << newv.toString() << ", oldvel=" << oldv.toString() << "\n";
-      }
-  
-    for (const PairEventData& pData : SDat.L2partChanges)
-      {
-	logfile << "    2PEvent";
-      
-	printData(pData.particle1_.getParticleID(),
-		  pData.particle2_.getParticleID());
-      
-	logfile << "\n";
-      }
+    EventLogRecord record = makeRecord(INTERACTION, eevent.getInteractionID(), eevent.getType());
+    addChange(record, pdat.particle1_);
+    addChange(record, pdat.particle2_);
+    _log->push(record);
   }
 
+  void 
+  OPTrajectory::eventUpdate(const GlobalEvent& eevent, const NEventData& SDat)
+  { writeEvent(SDat, GLOBAL, eevent.getGlobalID(), eevent.getType()); }
+
+  void 
+  OPTrajectory::eventUpdate(const LocalEvent& eevent, const NEventData& SDat)
+  { writeEvent(SDat, LOCAL, eevent.getLocalID(), eevent.getType()); }
+
+  void 
+  OPTrajectory::eventUpdate(const System& sys, const NEventData& SDat, const double&)
+  { writeEvent(SDat, SYSTEM, sys.getID(), sys.getType()); }
+
   void 
   OPTrajectory::output(magnet::xml::XmlStream& XML)
-  {}
+  {
+    //Make sure the log is complete whenever the results are written
+    if (_log) _log->flush();
+  }
 }
@@ -17,18 +17,27 @@
 
 #pragma once
 #include <dynamo/outputplugins/outputplugin.hpp>
-#include <fstream>
+#include <dynamo/eventlog.hpp>
+#include <dynamo/eventtypes.hpp>
+#include <memory>
+#include <string>
 
 namespace dynamo {
+  /*! \brief Records every change made to the particles in a binary
+      event log (see EventLogHeader).
+
+      The log is written to the file given by the FileName attribute
+      (default "trajectory.dyntraj"), and may be compressed by setting
+      the Compression attribute to Zlib or BZip2 (default None). The
+      ChunkSize attribute sets the number of records buffered and
+      compressed together. The log can be converted to text using the
+      dynatrajectory program.
+   */
   class OPTrajectory: public OutputPlugin
   {
   public:
     OPTrajectory(const dynamo::Simulation*, const magnet::xml::Node&);
 
-    OPTrajectory(const OPTrajectory&);
-  
-    ~OPTrajectory() {}
-
     void eventUpdate(const IntEvent&, const PairEventData&);
 
     void eventUpdate(const GlobalEvent&, const NEventData&);
@@ -43,11 +52,18 @@ namespace dynamo {
 
     virtual void output(magnet::xml::XmlStream&);
 
+    void operator<<(const magnet::xml::Node&);
+
   private:
+    void writeEvent(const NEventData&, EEventType sourceClass, size_t sourceID, EEventType type);
+
+    EventLogRecord makeRecord(EEventType sourceClass, size_t sourceID, EEventType type) const;
 
-    void printData(const size_t&,
-		   const size_t&) const;
+    void addChange(EventLogRecord&, const ParticleEventData&) const;
 
-    mutable std::ofstream logfile;
+    std::unique_ptr<EventLogWriter> _log;
+    std::string _fileName;
+    EventLogHeader::Compression _compression;
+    size_t _chunkSize;
   };
 }
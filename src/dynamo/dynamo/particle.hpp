@@ -18,6 +18,10 @@
 #pragma once
 
 #include <magnet/math/vector.hpp>
+#include <magnet/memory/aligned_allocator.hpp>
+#include <magnet/exception.hpp>
+#include <vector>
+#include <stdint.h>
 
 namespace magnet { namespace xml { class Node; class XmlStream; } }
 
@@ -28,6 +32,15 @@ namespace dynamo {
   //! particle, such as its position, velocity, ID, and state
   //! flags. Other data is "attached" to this particle using
   //! Property classes stored in the PropertyStore.
+  //!
+  //! The data members are ordered and sized so that a Particle
+  //! occupies exactly one 64 byte cache line. The position, velocity
+  //! and peculiar time (everything read while predicting an event)
+  //! come first, followed by the ID and state packed into 32 bits
+  //! each. Together with the aligned storage of \ref ParticleList,
+  //! testing a neighbour only ever touches a single cache line. The
+  //! 32 bit ID limits a Simulation to 2^32-1 particles, which is
+  //! checked whenever an ID is set.
   class Particle
   {
   public:
@@ -55,14 +68,14 @@ namespace dynamo {
 		     const Vector  &velocity,
 		     const unsigned long& nID):
       _pos(position), _vel(velocity), 
-      _ID(nID), _peculiarTime(0.0),
+      _peculiarTime(0.0), _ID(checkID(nID)),
       _state(DEFAULT)
     {}
   
     //! \brief Constructor to build a particle from an XML node.
     Particle(const magnet::xml::Node& XML, unsigned long nID):
-      _ID(nID),
       _peculiarTime(0.0),
+      _ID(checkID(nID)),
       _state(DEFAULT)
     {
       if (XML.hasAttribute("Static")) clearState(DYNAMIC);
@@ -93,7 +106,12 @@ namespace dynamo {
     //! \brief ID accessor function.
     //! This ID is a unique value for each Particle in the Simulation
     //! and so it can also be used as a reference to a particle.
-    inline const unsigned long &getID() const { return _ID; };
+    inline unsigned long getID() const { return _ID; };
+
+    //! \brief ID mutator function.
+    //! This must only be used when the particles are reordered (see
+    //! Simulation::renumberParticles).
+    inline void setID(unsigned long nID) { _ID = checkID(nID); }
 
     //! \brief Const peculiar time accessor function.
     //! This value is used in the "delayed states" or "Time warp" algorithm.
@@ -122,10 +140,28 @@ namespace dynamo {
     inline void clearState(State nState) { _state &= (~nState); }  
 
   private:
+    //! \brief Checks a particle ID fits in the 32 bits it is stored in.
+    static uint32_t checkID(unsigned long nID)
+    {
+      if (nID > UINT32_MAX)
+	M_throw() << "Particle ID " << nID << " is too large, at most " << UINT32_MAX << " particles are supported";
+      return nID;
+    }
+
     Vector _pos;
     Vector _vel;
-    unsigned long _ID;
     double _peculiarTime;
-    int _state;
+    uint32_t _ID;
+    uint32_t _state;
   };
+
+  static_assert(sizeof(Particle) == 64, "Particle no longer fits in a single cache line");
+
+  /*! \brief The container type used to store the Particle's of a
+      Simulation.
+
+      Particles are stored in cache line aligned memory so that no
+      Particle straddles two cache lines (see Particle).
+   */
+  typedef std::vector<Particle, magnet::memory::AlignedAllocator<Particle, 64> > ParticleList;
 }
@@ -19,6 +19,7 @@
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 #include <magnet/units.hpp>
+#include <dynamo/binaryconfig.hpp>
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -72,6 +73,13 @@ namespace dynamo {
     //! Fetch the units of this property
     inline const Units& getUnits() const { return _units; }
 
+    /*! \brief Remaps any per-particle data after the particles are
+        renumbered (see Simulation::renumberParticles).
+
+	\param newIDs The new ID of each particle, indexed by its old ID.
+    */
+    inline virtual void renumberParticles(const std::vector<size_t>& newIDs) {}
+
     //! Helper to write out derived classes
     friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const Property& prop)
     { prop.outputXML(XML); return XML; }
@@ -84,6 +92,21 @@ namespace dynamo {
     inline virtual void outputParticleXMLData(magnet::xml::XmlStream& XML, 
 					      const size_t pID) const {}
 
+    /*! Load this Property's data on the particles from a binary
+      configuration file.
+      \param N The number of particles.
+    */
+    inline virtual void loadParticleBinaryData(BinaryConfigReader& reader, const size_t N) {}
+
+    /*! Write this Property's data on the particles to a binary
+      configuration file.
+      \param order The ID of the particle to write for each entry.
+    */
+    inline virtual void outputParticleBinaryData(BinaryConfigWriter& writer, const std::vector<size_t>& order) const {}
+
+    //! Test if this Property has data to store for each particle.
+    inline virtual bool isPerParticle() const { return false; }
+
   protected:
     virtual void outputXML(magnet::xml::XmlStream& XML) const 
     { M_throw() << "Unimplemented"; }
@@ -202,6 +225,33 @@ namespace dynamo {
 
     inline void outputParticleXMLData(magnet::xml::XmlStream& XML, const size_t pID) const
     { XML << magnet::xml::attr(_name) << getProperty(pID); }
+
+    //! \sa Property::loadParticleBinaryData
+    inline virtual void loadParticleBinaryData(BinaryConfigReader& reader, const size_t N)
+    {
+      const double* values = reader.nextArray<double>(N);
+      _values.assign(values, values + N);
+    }
+
+    //! \sa Property::outputParticleBinaryData
+    inline virtual void outputParticleBinaryData(BinaryConfigWriter& writer, const std::vector<size_t>& order) const
+    {
+      Container values(order.size());
+      for (size_t i(0); i < order.size(); ++i)
+	values[i] = _values[order[i]];
+      writer.writeArray(values);
+    }
+
+    inline virtual bool isPerParticle() const { return true; }
+
+    //! \sa Property::renumberParticles
+    inline virtual void renumberParticles(const std::vector<size_t>& newIDs)
+    {
+      Container newValues(_values.size());
+      for (size_t ID(0); ID < _values.size(); ++ID)
+	newValues[newIDs[ID]] = _values[ID];
+      _values.swap(newValues);
+    }
   
   
   protected:
@@ -335,6 +385,13 @@ namespace dynamo {
 	property->rescaleUnit(dim, rescale);
     }
 
+    //! \sa Property::renumberParticles
+    inline void renumberParticles(const std::vector<size_t>& newIDs)
+    {
+      for (auto& property : _namedProperties)
+	property->renumberParticles(newIDs);
+    }
+
     /*! \brief Write any XML attributes relevent to Property-s for a
       single particle.
     
@@ -347,6 +404,35 @@ namespace dynamo {
 	property->outputParticleXMLData(XML, pID);
     }
 
+    //! \brief The number of Property-s with data for each particle (columns in a binary configuration).
+    inline size_t getParticleColumnCount() const
+    {
+      size_t count(0);
+      for (const auto& property : _namedProperties)
+	count += property->isPerParticle();
+      return count;
+    }
+
+    /*! \brief Load the per-particle data of the Property-s from a
+      binary configuration file, in the order they were loaded.
+    */
+    inline void loadParticleBinaryData(BinaryConfigReader& reader, size_t N)
+    {
+      for (const auto& property : _namedProperties)
+	property->loadParticleBinaryData(reader, N);
+    }
+
+    /*! \brief Write the per-particle data of the Property-s to a
+      binary configuration file.
+
+      \param order The ID of the particle to write for each entry.
+    */
+    inline void outputParticleBinaryData(BinaryConfigWriter& writer, const std::vector<size_t>& order) const
+    {
+      for (const auto& property : _namedProperties)
+	property->outputParticleBinaryData(writer, order);
+    }
+
     /*! \brief Method for pushing constructed properties into the
       PropertyStore.
      
@@ -17,12 +17,14 @@
 
 #pragma once
 #include <memory>
+#include <vector>
 
 namespace magnet { namespace xml { class Node; class XmlStream; } }
 namespace dynamo { 
   using std::shared_ptr;
   class Simulation;
   class Particle;
+  class IDRange;
 
   class IDPairRange
   {
@@ -31,6 +33,20 @@ namespace dynamo {
  
     virtual bool isInRange(const Particle&, const Particle&) const = 0;
 
+    /*! \brief Collects the IDRange-s this range is built from, if a
+      pair is in range purely because of which IDRange-s each of its
+      particles are in.
+
+      Such ranges can be precomputed for classes of particles (see
+      Simulation::getInteractionID), instead of being tested for every
+      pair.
+
+      \param ranges The IDRange-s are appended to this.
+      \returns False if the range depends on the particular pair of
+      particles (e.g., chains or lists of pairs).
+     */
+    virtual bool getMembershipRanges(std::vector<const IDRange*>& ranges) const { return false; }
+
     static IDPairRange* getClass(const magnet::xml::Node&, const dynamo::Simulation*);
     
     friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const IDPairRange& range);
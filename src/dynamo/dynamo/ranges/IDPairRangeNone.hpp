@@ -29,6 +29,9 @@ namespace dynamo {
     
     virtual bool isInRange(const Particle&, const Particle&) const
     { return false; }
+
+    virtual bool getMembershipRanges(std::vector<const IDRange*>&) const
+    { return true; }
   
   protected:
     virtual void outputXML(magnet::xml::XmlStream& XML) const
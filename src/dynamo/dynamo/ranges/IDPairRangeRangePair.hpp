@@ -41,6 +41,13 @@ namespace dynamo {
       return false;
     }
 
+    virtual bool getMembershipRanges(std::vector<const IDRange*>& ranges) const
+    {
+      ranges.push_back(range1.get());
+      ranges.push_back(range2.get());
+      return true;
+    }
+
   protected:
 
     virtual void outputXML(magnet::xml::XmlStream& XML) const
@@ -37,6 +37,12 @@ namespace dynamo {
       return (range->isInRange(p1) && range->isInRange(p2));
     }
 
+    virtual bool getMembershipRanges(std::vector<const IDRange*>& ranges) const
+    {
+      ranges.push_back(range.get());
+      return true;
+    }
+
     const shared_ptr<IDRange>& getRange() const { return range; }
 
   protected:
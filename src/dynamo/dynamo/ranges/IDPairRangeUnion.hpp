@@ -49,6 +49,14 @@ namespace dynamo {
       return false;
     }
 
+    virtual bool getMembershipRanges(std::vector<const IDRange*>& subRanges) const
+    {
+      for (const shared_ptr<IDPairRange>& rPtr : ranges)
+	if (!rPtr->getMembershipRanges(subRanges))
+	  return false;
+      return true;
+    }
+
     void addRange(IDPairRange* nRange)
     { ranges.push_back(shared_ptr<IDPairRange>(nRange)); }
   
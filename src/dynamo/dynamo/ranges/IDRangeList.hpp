@@ -49,6 +49,7 @@ namespace dynamo {
     }
 
     std::vector<size_t>& getContainer() { return IDs; }
+    const std::vector<size_t>& getContainer() const { return IDs; }
     
     virtual unsigned long size() const { return IDs.size(); }
 
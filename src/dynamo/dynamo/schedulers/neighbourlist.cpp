@@ -26,7 +26,6 @@
 #include <dynamo/globals/neighbourList.hpp>
 #include <dynamo/locals/local.hpp>
 #include <dynamo/locals/localEvent.hpp>
-#include <dynamo/ranges/IDRangeRange.hpp>
 #include <magnet/xmlreader.hpp>
 #include <boost/bind.hpp>
 #include <boost/progress.hpp>
@@ -35,6 +34,20 @@
 namespace dynamo {
   void
   SNeighbourList::initialise()
+  {
+    connectNeighbourList();
+    Scheduler::initialise();
+  }
+
+  void
+  SNeighbourList::loadCheckpoint(CheckpointReader& in)
+  {
+    connectNeighbourList();
+    Scheduler::loadCheckpoint(in);
+  }
+
+  void
+  SNeighbourList::connectNeighbourList()
   {
     try {
       NBListID = Sim->globals["SchedulerNBList"]->getID();
@@ -62,7 +75,7 @@ namespace dynamo {
 
     nblist->markAsUsedInScheduler();
     nblist->_sigNewNeighbour.connect<Scheduler, &Scheduler::addInteractionEvent>(this);
-    Scheduler::initialise();
+    nblist->_sigNewLocal.connect<Scheduler, &Scheduler::addLocalEvent>(this);
   }
 
   void 
@@ -121,6 +134,11 @@ namespace dynamo {
   std::unique_ptr<IDRange> 
   SNeighbourList::getParticleLocals(const Particle& part) const
   {
-    return std::unique_ptr<IDRange>(new IDRangeRange(0, Sim->locals.size()));
+#ifdef DYNAMO_DEBUG
+    if (!std::dynamic_pointer_cast<GNeighbourList>(Sim->globals[NBListID]))
+      M_throw() << "Not a GNeighbourList!";
+#endif
+
+    return static_cast<const GNeighbourList&>(*Sim->globals[NBListID]).getParticleLocals(part);
   }
 }
@@ -28,12 +28,17 @@ namespace dynamo {
 
     virtual void initialise();
 
+    virtual void loadCheckpoint(CheckpointReader&);
+
     virtual std::unique_ptr<IDRange> getParticleNeighbours(const Particle&) const;
     virtual std::unique_ptr<IDRange> getParticleNeighbours(const Vector&) const;
     virtual std::unique_ptr<IDRange> getParticleLocals(const Particle&) const;
 
   protected:
     virtual void outputXML(magnet::xml::XmlStream&) const;
+
+    //! \brief Finds the neighbour list and connects to its signals.
+    void connectNeighbourList();
   
     size_t NBListID;
   };
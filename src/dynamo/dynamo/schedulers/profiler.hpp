@@ -0,0 +1,169 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/outputplugins/eventtypetracking.hpp>
+#include <magnet/cyclecount.hpp>
+#include <map>
+#include <cstdint>
+
+namespace dynamo {
+  /*! \brief Accumulates the cycles spent in each phase of the
+      Scheduler event loop, for each type of event.
+
+      The Scheduler (and Simulation::signalEvent) mark the phases using
+      the Phase RAII class. Phases nest, and the cycles of a nested
+      phase are only counted against that phase. Each pass of
+      Scheduler::runNextEvent is wrapped in an Event, and its cycles
+      are added to the event type and source set with Event::set.
+
+      All of the hooks take a pointer to the profiler and do nothing
+      if it is NULL, so the cost when profiling is off is a single
+      test.
+   */
+  class EventProfiler
+  {
+  public:
+    enum PhaseType
+      {
+	SORTER,        //!< Sorting, popping and updating the FEL.
+	LAZY_DELETION, //!< Discarding invalidated events.
+	RECALCULATION, //!< Retesting the next event before it is run.
+	STREAM,        //!< Streaming the system to the event time.
+	EXECUTION,     //!< Running the event dynamics.
+	PREDICTION,    //!< Predicting the new events of the particles.
+	OUTPUT,        //!< Updating the OutputPlugin-s.
+	PHASE_COUNT,
+	IDLE = PHASE_COUNT //!< Time outside the event loop, not recorded.
+      };
+
+    static const char* getPhaseName(size_t phase)
+    {
+      static const char* names[PHASE_COUNT] = {"Sorter", "LazyDeletion", "Recalculation", "Stream", "Execution", "Prediction", "Output"};
+      return names[phase];
+    }
+
+    //! \brief The source (e.g., an Interaction) and type of an event.
+    typedef std::pair<EventTypeTracking::classKey, EEventType> EventKey;
+
+    struct Counters
+    {
+      Counters(): count(0) { for (uint64_t& c : cycles) c = 0; }
+      uint64_t count;
+      uint64_t cycles[PHASE_COUNT];
+    };
+
+    EventProfiler():
+      _phase(IDLE),
+      _lastCount(magnet::cycle_count())
+    { clearCurrent(); }
+
+    /*! \brief Marks the profiler as being in a phase for the lifetime
+        of the object.
+     */
+    class Phase
+    {
+    public:
+      Phase(EventProfiler* profiler, PhaseType phase):
+	_profiler(profiler)
+      { if (_profiler) _previous = _profiler->switchPhase(phase); }
+
+      ~Phase() { end(); }
+
+      //! \brief Leave the phase before the object is destroyed.
+      void end()
+      {
+	if (_profiler) _profiler->switchPhase(_previous);
+	_profiler = NULL;
+      }
+
+    private:
+      EventProfiler* _profiler;
+      PhaseType _previous;
+    };
+
+    /*! \brief Marks one pass of the event loop, which starts in the
+        SORTER phase.
+
+	The cycles are recorded against the event key when the object
+	is destroyed, or discarded if no key was set.
+     */
+    class Event
+    {
+    public:
+      Event(EventProfiler* profiler):
+	_profiler(profiler),
+	_key(EventTypeTracking::classKey(0, NONE), NONE),
+	_set(false)
+      {
+	if (!_profiler) return;
+	_profiler->switchPhase(SORTER);
+	_profiler->clearCurrent();
+      }
+
+      ~Event()
+      {
+	if (!_profiler) return;
+	_profiler->switchPhase(IDLE);
+	if (_set) _profiler->record(_key);
+      }
+
+      void set(const EventTypeTracking::classKey& source, EEventType type)
+      {
+	_key = EventKey(source, type);
+	_set = true;
+      }
+
+    private:
+      EventProfiler* _profiler;
+      EventKey _key;
+      bool _set;
+    };
+
+    const std::map<EventKey, Counters>& getCounters() const { return _counters; }
+
+    void reset() { _counters.clear(); }
+
+  private:
+    PhaseType switchPhase(PhaseType phase)
+    {
+      const uint64_t now = magnet::cycle_count();
+      if (_phase != IDLE)
+	_current[_phase] += now - _lastCount;
+      _lastCount = now;
+
+      const PhaseType previous = _phase;
+      _phase = phase;
+      return previous;
+    }
+
+    void clearCurrent() { for (uint64_t& c : _current) c = 0; }
+
+    void record(const EventKey& key)
+    {
+      Counters& counters = _counters[key];
+      ++counters.count;
+      for (size_t i(0); i < PHASE_COUNT; ++i)
+	counters.cycles[i] += _current[i];
+    }
+
+    PhaseType _phase;
+    uint64_t _lastCount;
+    uint64_t _current[PHASE_COUNT];
+    std::map<EventKey, Counters> _counters;
+  };
+}
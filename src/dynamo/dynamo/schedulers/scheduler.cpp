@@ -23,6 +23,7 @@
 #include <dynamo/locals/local.hpp>
 #include <dynamo/systems/system.hpp>
 #include <dynamo/dynamics/dynamics.hpp>
+#include <dynamo/BC/BC.hpp>
 #include <dynamo/simulation.hpp>
 #include <dynamo/units/units.hpp>
 
@@ -33,12 +34,21 @@
 
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <functional>
+#include <algorithm>
 #include <boost/math/special_functions/fpclassify.hpp>
 
 namespace dynamo {
   Scheduler::Scheduler(dynamo::Simulation* const tmp, const char * aName,
 			 FEL* nS):
     SimBase(tmp, aName),
+    _eagerInvalidation(false),
+    _staleEvents(0),
+    _eagerRemovals(0),
+    _recalculatedEvents(0),
+    _threads(NULL),
+    _profiler(NULL),
     sorter(nS),
     _interactionRejectionCounter(0),
     _localRejectionCounter(0)
@@ -50,6 +60,16 @@ namespace dynamo {
   Scheduler::operator<<(const magnet::xml::Node& XML)
   {
     sorter = FEL::getClass(XML.getNode("Sorter"));
+
+    _eagerInvalidation = false;
+    if (XML.hasAttribute("Invalidation"))
+      {
+	const std::string mode = XML.getAttribute("Invalidation").getValue();
+	if (mode == "Eager")
+	  _eagerInvalidation = true;
+	else if (mode != "Lazy")
+	  M_throw() << "Unknown Invalidation mode \"" << mode << "\" for the Scheduler, valid modes are Lazy or Eager";
+      }
   }
 
   void
@@ -62,22 +82,8 @@ namespace dynamo {
     for (const auto& interaction_ptr : Sim->interactions)
       warnings += interaction_ptr->validateState(warnings < 101, 101 - warnings);
     
-    for (size_t id1(0); id1 < Sim->particles.size(); ++id1)
-      {
-	std::unique_ptr<IDRange> ids(getParticleNeighbours(Sim->particles[id1]));
-	for (const size_t id2 : *ids)
-	  if (id2 > id1)
-	    if (Sim->getInteraction(Sim->particles[id1], Sim->particles[id2])
-		->validateState(Sim->particles[id1], Sim->particles[id2], (warnings < 101)))
-	      ++warnings;
-      }
-    
-    for(const Particle& part : Sim->particles)
-      for (const shared_ptr<Local>& lcl : Sim->locals)
-      if (lcl->isInteraction(part))
-	if (lcl->validateState(part, (warnings < 101)))
-	  ++warnings;
-    
+    warnings = validateParticles(warnings);
+
     if (warnings > 100)
       derr << "Over 100 warnings of invalid states, further output was suppressed (total of " << warnings << " warnings detected)" << std::endl;
 
@@ -93,9 +99,15 @@ namespace dynamo {
     sorter->resize(Sim->N+1);
     eventCount.clear();
     eventCount.resize(Sim->N+1, 0);
-
-    for (Particle& part : Sim->particles)
-      addEvents(part);
+    _eventOwners.clear();
+    if (_eagerInvalidation)
+      _eventOwners.resize(Sim->N+1);
+
+    if (Sim->threads && Sim->threads->getThreadCount())
+      parallelAddEvents();
+    else
+      for (Particle& part : Sim->particles)
+	addEvents(part);
   
     sorter->init();
 
@@ -103,11 +115,246 @@ namespace dynamo {
   }
 
 
+  void
+  Scheduler::velocitiesRescaled(const double factor)
+  {
+    bool invariant = Sim->dynamics->timeScaleInvariant() && Sim->BCs->timeScaleInvariant();
+    for (const shared_ptr<Local>& local : Sim->locals)
+      invariant = invariant && local->timeScaleInvariant();
+
+    if (!invariant)
+      {
+	rebuildList();
+	return;
+      }
+
+    //The System events are not rescaled, they are simply rebuilt
+    sorter->rescaleTimes(1.0 / factor);
+    rebuildSystemEvents();
+  }
+
+  void
+  Scheduler::updateLocalEvents(const Local& local)
+  {
+    for (Particle& part : Sim->particles)
+      if (local.isInteraction(part))
+	{
+	  sorter->removeLocalEvents(part.getID(), local.getID());
+	  Sim->dynamics->updateParticle(part);
+	  sorter->push(local.getEvent(part), part.getID());
+	  sort(part);
+	}
+  }
+
+  size_t
+  Scheduler::validateParticles(size_t warnings) const
+  {
+    if (!Sim->threads || !Sim->threads->getThreadCount())
+      {
+	for (size_t id1(0); id1 < Sim->particles.size(); ++id1)
+	  {
+	    std::unique_ptr<IDRange> ids(getParticleNeighbours(Sim->particles[id1]));
+	    for (const size_t id2 : *ids)
+	      if (id2 > id1)
+		if (Sim->getInteraction(Sim->particles[id1], Sim->particles[id2])
+		    ->validateState(Sim->particles[id1], Sim->particles[id2], (warnings < 101)))
+		  ++warnings;
+	  }
+    
+	for(const Particle& part : Sim->particles)
+	  for (const shared_ptr<Local>& lcl : Sim->locals)
+	    if (lcl->isInteraction(part))
+	      if (lcl->validateState(part, (warnings < 101)))
+		++warnings;
+
+	return warnings;
+      }
+
+    //Each chunk collects the (ID, ID) pairs and the (ID, Local ID)
+    //pairs which fail their tests
+    typedef std::vector<std::pair<size_t, size_t> > Failures;
+    const size_t chunkSize = 1024;
+    const size_t nChunks = (Sim->N + chunkSize - 1) / chunkSize;
+    std::vector<Failures> pairFailures(nChunks), localFailures(nChunks);
+
+    Sim->threads->parallel_for(0, nChunks, [&](size_t first, size_t last) {
+	for (size_t chunk(first); chunk < last; ++chunk)
+	  for (size_t id1(chunk * chunkSize); id1 < std::min((chunk + 1) * chunkSize, Sim->N); ++id1)
+	    {
+	      const Particle& p1 = Sim->particles[id1];
+	      std::unique_ptr<IDRange> ids(getParticleNeighbours(p1));
+	      for (const size_t id2 : *ids)
+		if ((id2 > id1) && Sim->getInteraction(p1, Sim->particles[id2])->validateState(p1, Sim->particles[id2], false))
+		  pairFailures[chunk].push_back(std::make_pair(id1, id2));
+
+	      for (size_t localID(0); localID < Sim->locals.size(); ++localID)
+		if (Sim->locals[localID]->isInteraction(p1) && Sim->locals[localID]->validateState(p1, false))
+		  localFailures[chunk].push_back(std::make_pair(id1, localID));
+	    }
+      }, 1);
+
+    //Repeat the failed tests in the serial order to print the warnings
+    for (const Failures& failures : pairFailures)
+      for (const std::pair<size_t, size_t>& ids : failures)
+	if (Sim->getInteraction(Sim->particles[ids.first], Sim->particles[ids.second])
+	    ->validateState(Sim->particles[ids.first], Sim->particles[ids.second], (warnings < 101)))
+	  ++warnings;
+
+    for (const Failures& failures : localFailures)
+      for (const std::pair<size_t, size_t>& ids : failures)
+	if (Sim->locals[ids.second]->validateState(Sim->particles[ids.first], (warnings < 101)))
+	  ++warnings;
+
+    return warnings;
+  }
+
+  void
+  Scheduler::parallelAddEvents()
+  {
+    for (Particle& part : Sim->particles)
+      Sim->dynamics->updateParticle(part);
+
+    const size_t NInteractions = Sim->interactions.size();
+    const size_t chunkSize = 256;
+    const size_t blockChunks = 4 * Sim->threads->getThreadCount();
+
+    //The interaction events of the particles of a chunk, and the end
+    //of each particle's events in the buffer
+    struct ChunkEvents { std::vector<IntEvent> events; std::vector<size_t> ends; };
+    std::vector<ChunkEvents> chunks(blockChunks);
+
+    for (size_t blockStart(0); blockStart < Sim->N; blockStart += chunkSize * blockChunks)
+      {
+	const size_t blockEnd = std::min(blockStart + chunkSize * blockChunks, size_t(Sim->N));
+	const size_t nChunks = (blockEnd - blockStart + chunkSize - 1) / chunkSize;
+
+	Sim->threads->parallel_for(0, nChunks, [&](size_t first, size_t last) {
+	    std::vector<std::vector<size_t> > batchIDs(NInteractions);
+	    for (size_t chunk(first); chunk < last; ++chunk)
+	      {
+		ChunkEvents& output = chunks[chunk];
+		output.events.clear();
+		output.ends.clear();
+		const size_t begin = blockStart + chunk * chunkSize;
+		for (size_t id(begin); id < std::min(begin + chunkSize, blockEnd); ++id)
+		  {
+		    const Particle& part = Sim->particles[id];
+		    for (std::vector<size_t>& batch : batchIDs)
+		      batch.clear();
+
+		    std::unique_ptr<IDRange> ids(getParticleNeighbours(part));
+		    for (const size_t id2 : *ids)
+		      if (id2 != id)
+			batchIDs[Sim->getInteractionID(part, Sim->particles[id2])].push_back(id2);
+
+		    for (size_t intID(0); intID < NInteractions; ++intID)
+		      if (!batchIDs[intID].empty())
+			Sim->interactions[intID]->getEvents(part, batchIDs[intID], output.events);
+		    output.ends.push_back(output.events.size());
+		  }
+	      }
+	  }, 1);
+
+	//Push the events in the order of the serial algorithm
+	for (size_t chunk(0); chunk < nChunks; ++chunk)
+	  {
+	    const ChunkEvents& output = chunks[chunk];
+	    size_t event(0);
+	    for (size_t i(0); i < output.ends.size(); ++i)
+	      {
+		Particle& part = Sim->particles[blockStart + chunk * chunkSize + i];
+		addGlobalLocalEvents(part);
+		for (; event < output.ends[i]; ++event)
+		  if (output.events[event].getType() != NONE)
+		    pushInteractionEvent(output.events[event], part.getID());
+	      }
+	  }
+      }
+  }
+
+  void
+  Scheduler::saveCheckpoint(CheckpointWriter& out) const
+  {
+    out.section("Scheduler");
+    out.write(eventCount);
+    out.write(_eagerInvalidation);
+    if (_eagerInvalidation)
+      for (const std::vector<std::pair<size_t, size_t> >& owners : _eventOwners)
+	{
+	  out.write(owners.size());
+	  for (const std::pair<size_t, size_t>& owner : owners)
+	    {
+	      out.write(owner.first);
+	      out.write(owner.second);
+	    }
+	}
+
+    out.write(_staleEvents);
+    out.write(_eagerRemovals);
+    out.write(_recalculatedEvents);
+    out.write(_interactionRejectionCounter);
+    out.write(_localRejectionCounter);
+    sorter->saveCheckpoint(out);
+  }
+
+  void
+  Scheduler::loadCheckpoint(CheckpointReader& in)
+  {
+    dout << "Restoring the event lists from the checkpoint at event " << Sim->eventCount << std::endl;
+    in.section("Scheduler");
+    in.read(eventCount);
+    if (eventCount.size() != Sim->N + 1)
+      M_throw() << "The checkpoint holds the event counts of " << eventCount.size() - 1 << " particles, but the simulation has " << Sim->N;
+
+    bool eager;
+    in.read(eager);
+    if (eager != _eagerInvalidation)
+      M_throw() << "The checkpoint was written with " << (eager ? "Eager" : "Lazy") << " invalidation of events, but the Scheduler uses "
+		<< (_eagerInvalidation ? "Eager" : "Lazy") << " invalidation";
+
+    _eventOwners.clear();
+    if (_eagerInvalidation)
+      {
+	_eventOwners.resize(Sim->N + 1);
+	for (std::vector<std::pair<size_t, size_t> >& owners : _eventOwners)
+	  {
+	    size_t count;
+	    in.read(count);
+	    owners.resize(count);
+	    for (std::pair<size_t, size_t>& owner : owners)
+	      {
+		in.read(owner.first);
+		in.read(owner.second);
+	      }
+	  }
+      }
+
+    in.read(_staleEvents);
+    in.read(_eagerRemovals);
+    in.read(_recalculatedEvents);
+    in.read(_interactionRejectionCounter);
+    in.read(_localRejectionCounter);
+
+    sorter->clear();
+    sorter->resize(Sim->N + 1);
+    sorter->loadCheckpoint(in);
+  }
+
   void 
   Scheduler::addEvents(Particle& part)
   {  
     Sim->dynamics->updateParticle(part);
 
+    addGlobalLocalEvents(part);
+
+    //Now add the interaction events
+    std::unique_ptr<IDRange> ids(getParticleNeighbours(part));
+    addInteractionEvents(part, *ids);
+  }
+
+  void
+  Scheduler::addGlobalLocalEvents(Particle& part) const
+  {
     //Add the global events
     for (const shared_ptr<Global>& glob : Sim->globals)
       if (glob->isInteraction(part))
@@ -118,11 +365,72 @@ namespace dynamo {
     
     for (const size_t id2 : *ids)
       addLocalEvent(part, id2);
+  }
 
-    //Now add the interaction events
-    ids = getParticleNeighbours(part);
-    for (const size_t id2 : *ids)
-      addInteractionEvent(part, id2);
+  void
+  Scheduler::parallelFullUpdate(Particle& p1, Particle& p2)
+  {
+    Particle* const parts[2] = {&p1, &p2};
+    const size_t NInteractions = Sim->interactions.size();
+
+    //Serially bring everything up to date and group the neighbours
+    size_t totalPairs(0);
+    for (size_t p(0); p < 2; ++p)
+      {
+	Sim->dynamics->updateParticle(*parts[p]);
+	std::unique_ptr<IDRange> ids(getParticleNeighbours(*parts[p]));
+	groupNeighbours(*parts[p], *ids, _parallelIDs[p]);
+	for (const std::vector<size_t>& batch : _parallelIDs[p])
+	  totalPairs += batch.size();
+      }
+
+    //Split the predictions into roughly one chunk per thread
+    const size_t chunkSize = std::max(size_t(1), (totalPairs + _threads->getThreadCount() - 1) / std::max(size_t(1), _threads->getThreadCount()));
+
+    struct Task { size_t particle; size_t interaction; size_t begin; size_t end; };
+    std::vector<Task> tasks;
+    for (size_t p(0); p < 2; ++p)
+      for (size_t intID(0); intID < NInteractions; ++intID)
+	for (size_t begin(0); begin < _parallelIDs[p][intID].size(); begin += chunkSize)
+	  {
+	    const Task task = {p, intID, begin, std::min(begin + chunkSize, _parallelIDs[p][intID].size())};
+	    tasks.push_back(task);
+	  }
+
+    if (_taskEvents.size() < tasks.size())
+      _taskEvents.resize(tasks.size());
+
+    //Each task is small, so they are run through parallel_for
+    //rather than queued as individual functors
+    _threads->parallel_for(0, tasks.size(), [&](size_t first, size_t last) {
+	for (size_t t(first); t < last; ++t)
+	  {
+	    const Task& task = tasks[t];
+	    std::vector<IntEvent>& output = _taskEvents[t];
+	    const std::vector<size_t>& batch = _parallelIDs[task.particle][task.interaction];
+	    const Particle& part = *parts[task.particle];
+	    const Interaction& interaction = *Sim->interactions[task.interaction];
+	    output.clear();
+	    if ((task.begin == 0) && (task.end == batch.size()))
+	      interaction.getEvents(part, batch, output);
+	    else
+	      interaction.getEvents(part, std::vector<size_t>(batch.begin() + task.begin, batch.begin() + task.end), output);
+	  }
+      }, 1);
+
+    //Merge the buffers in the order of the serial algorithm
+    size_t t(0);
+    for (size_t p(0); p < 2; ++p)
+      {
+	Particle& part = *parts[p];
+	invalidateEvents(part);
+	addGlobalLocalEvents(part);
+	for (; (t < tasks.size()) && (tasks[t].particle == p); ++t)
+	  for (const IntEvent& eevent : _taskEvents[t])
+	    if (eevent.getType() != NONE)
+	      pushInteractionEvent(eevent, part.getID());
+	sort(part);
+      }
   }
 
   shared_ptr<Scheduler>
@@ -142,6 +450,8 @@ namespace dynamo {
   magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, 
 				     const Scheduler& g)
   {
+    if (g._eagerInvalidation)
+      XML << magnet::xml::attr("Invalidation") << "Eager";
     g.outputXML(XML);
     return XML;
   }
@@ -178,11 +488,42 @@ namespace dynamo {
     //Invalidate previous entries
     ++eventCount[part.getID()];
     sorter->clearPEL(part.getID());
+
+    if (!_eagerInvalidation || (part.getID() >= _eventOwners.size())) return;
+
+    //Remove the events the other particles hold with this particle
+    std::vector<std::pair<size_t, size_t> >& owners = _eventOwners[part.getID()];
+    for (const std::pair<size_t, size_t>& owner : owners)
+      if ((owner.first != part.getID()) && (eventCount[owner.first] == owner.second))
+	{
+	  sorter->removeInteractionEvents(owner.first, part.getID());
+	  sorter->update(owner.first);
+	  ++_eagerRemovals;
+	}
+    owners.clear();
+  }
+
+  void
+  Scheduler::pushInteractionEvent(const IntEvent& eevent, const size_t& ownerID) const
+  {
+    const size_t p2 = eevent.getParticle2ID();
+    sorter->push(Event(eevent, eventCount[p2]), ownerID);
+
+    if (_eagerInvalidation)
+      {
+	//Only record each owner once per generation
+	std::vector<std::pair<size_t, size_t> >& owners = _eventOwners[p2];
+	const std::pair<size_t, size_t> owner(ownerID, eventCount[ownerID]);
+	if (owners.empty() || (owners.back() != owner))
+	  owners.push_back(owner);
+      }
   }
 
   void
   Scheduler::runNextEvent()
   {
+    EventProfiler::Event profile(_profiler);
+
     sorter->sort();
 
 #ifdef DYNAMO_DEBUG
@@ -266,8 +607,12 @@ namespace dynamo {
 	  lazyDeletionCleanup();
 
 	  //Now recalculate the FEL event
-	  Sim->dynamics->updateParticlePair(p1, p2);
-	  IntEvent Event(Sim->getEvent(p1, p2));
+	  IntEvent Event;
+	  {
+	    EventProfiler::Phase phase(_profiler, EventProfiler::RECALCULATION);
+	    Sim->dynamics->updateParticlePair(p1, p2);
+	    Event = Sim->getEvent(p1, p2);
+	  }
 	
 #ifdef DYNAMO_DEBUG
 	  if (sorter->empty())
@@ -277,6 +622,8 @@ namespace dynamo {
 
 	  if ((Event.getType() == NONE) || ((Event.getdt() > next_event.second.dt) && (++_interactionRejectionCounter < rejectionLimit)))
 	    {
+	      profile.set(EventTypeTracking::classKey(Sim->getInteractionID(p1, p2), INTERACTION), RECALCULATE);
+	      ++_recalculatedEvents;
 	      this->fullUpdate(p1, p2);
 	      return;
 	    }
@@ -307,13 +654,19 @@ namespace dynamo {
 	       << std::endl;
 #endif
 
-	  Sim->systemTime += Event.getdt();
+	  profile.set(EventTypeTracking::getClassKey(Event), Event.getType());
+
+	  {
+	    EventProfiler::Phase phase(_profiler, EventProfiler::STREAM);
+	    Sim->systemTime += Event.getdt();
 	
-	  stream(Event.getdt());
+	    stream(Event.getdt());
 	
-	  //dynamics must be updated first
-	  Sim->stream(Event.getdt());
+	    //dynamics must be updated first
+	    Sim->stream(Event.getdt());
+	  }
 	
+	  EventProfiler::Phase phase(_profiler, EventProfiler::EXECUTION);
 	  Sim->interactions[Event.getInteractionID()]->runEvent(p1,p2,Event);
 
 	  break;
@@ -324,6 +677,8 @@ namespace dynamo {
 	  //optimise this (they dont need it).  We also don't recheck
 	  //Global events! (Check, some events might rely on this
 	  //behavior)
+	  profile.set(EventTypeTracking::classKey(next_event.second.globalID, GLOBAL), GLOBAL);
+	  EventProfiler::Phase phase(_profiler, EventProfiler::EXECUTION);
 	  Sim->globals[next_event.second.globalID]->runEvent(Sim->particles[next_event.first], next_event.second.dt);
 	  break;	           
 	}
@@ -338,14 +693,18 @@ namespace dynamo {
 	  sorter->sort();
 	  lazyDeletionCleanup();
 
+	  EventProfiler::Phase recalculation(_profiler, EventProfiler::RECALCULATION);
 	  Sim->dynamics->updateParticle(part);
 	  LocalEvent iEvent(Sim->locals[localID]->getEvent(part));
+	  recalculation.end();
 
 	  next_event = sorter->next();
 	  //Check the recalculated event is valid and not later than
 	  //the next event in the queue
 	  if ((iEvent.getType() == NONE) || ((iEvent.getdt() > next_event.second.dt) && (++_localRejectionCounter < rejectionLimit)))
 	    {
+	      profile.set(EventTypeTracking::classKey(localID, LOCAL), RECALCULATE);
+	      ++_recalculatedEvents;
 	      this->fullUpdate(part);
 	      return;
 	    }
@@ -362,20 +721,29 @@ namespace dynamo {
 		      << iEvent.stringData(Sim);
 #endif
 	
-	  Sim->systemTime += iEvent.getdt();
+	  profile.set(EventTypeTracking::getClassKey(iEvent), iEvent.getType());
+
+	  {
+	    EventProfiler::Phase phase(_profiler, EventProfiler::STREAM);
+	    Sim->systemTime += iEvent.getdt();
 	
-	  stream(iEvent.getdt());
+	    stream(iEvent.getdt());
 	
-	  //dynamics must be updated first
-	  Sim->stream(iEvent.getdt());
+	    //dynamics must be updated first
+	    Sim->stream(iEvent.getdt());
+	  }
 	
+	  EventProfiler::Phase phase(_profiler, EventProfiler::EXECUTION);
 	  Sim->locals[localID]->runEvent(part, iEvent);	  
 	  break;
 	}
       case SYSTEM:
 	{
+	  profile.set(EventTypeTracking::classKey(next_event.second.systemID, SYSTEM), SYSTEM);
+	  EventProfiler::Phase phase(_profiler, EventProfiler::EXECUTION);
 	  Sim->systems[next_event.second.systemID]->runEvent();
 	  //This saves the system events rebuilding themselves
+	  EventProfiler::Phase prediction(_profiler, EventProfiler::PREDICTION);
 	  rebuildSystemEvents();
 	  break;
 	}
@@ -383,6 +751,7 @@ namespace dynamo {
 	{
 	  //This is a special event type which requires that the
 	  // events for this particle recalculated.
+	  profile.set(EventTypeTracking::classKey(0, RECALCULATE), RECALCULATE);
 	  this->fullUpdate(Sim->particles[next_event.first]);
 	  break;
 	}
@@ -410,7 +779,40 @@ namespace dynamo {
     const IntEvent& eevent(Sim->getEvent(part1, part2));
 
     if (eevent.getType() != NONE)
-      sorter->push(Event(eevent, eventCount[id]), part1.getID());
+      pushInteractionEvent(eevent, part1.getID());
+  }
+
+  void 
+  Scheduler::groupNeighbours(const Particle& part, const IDRange& ids, std::vector<std::vector<size_t> >& batchIDs) const
+  {
+    const size_t NInteractions = Sim->interactions.size();
+    batchIDs.resize(NInteractions);
+    for (std::vector<size_t>& batch : batchIDs)
+      batch.clear();
+
+    for (const size_t id2 : ids)
+      {
+	if (part.getID() == id2) continue;
+	Particle& part2(Sim->particles[id2]);
+	Sim->dynamics->updateParticle(part2);
+	batchIDs[Sim->getInteractionID(part, part2)].push_back(id2);
+      }
+  }
+
+  void 
+  Scheduler::addInteractionEvents(const Particle& part, const IDRange& ids) const
+  {
+    const size_t NInteractions = Sim->interactions.size();
+    groupNeighbours(part, ids, _batchIDs);
+
+    _batchEvents.clear();
+    for (size_t intID(0); intID < NInteractions; ++intID)
+      if (!_batchIDs[intID].empty())
+	Sim->interactions[intID]->getEvents(part, _batchIDs[intID], _batchEvents);
+
+    for (const IntEvent& eevent : _batchEvents)
+      if (eevent.getType() != NONE)
+	pushInteractionEvent(eevent, part.getID());
   }
 
   void 
@@ -424,10 +826,12 @@ namespace dynamo {
   void 
   Scheduler::lazyDeletionCleanup()
   {
+    EventProfiler::Phase phase(_profiler, EventProfiler::LAZY_DELETION);
     std::pair<size_t, Event> next_event = sorter->next();
     while ((next_event.second.type == INTERACTION) && (next_event.second.collCounter2 != eventCount[next_event.second.particle2ID]))
       {
 	//Not valid, update the list
+	++_staleEvents;
 	sorter->popNextEvent();
 	sorter->update(next_event.first);
 	sorter->sort();      
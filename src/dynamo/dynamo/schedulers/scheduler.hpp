@@ -22,14 +22,16 @@
 #include <dynamo/globals/globEvent.hpp>
 #include <magnet/function/delegate.hpp>
 #include <dynamo/ranges/IDRange.hpp>
+#include <dynamo/schedulers/profiler.hpp>
 #include <memory>
 #include <vector>
 
-namespace magnet { namespace xml { class Node; } }
+namespace magnet { namespace xml { class Node; } namespace thread { class ThreadPool; } }
 
 namespace dynamo {
   class Particle;
   class Event;
+  class Local;
 
   class Scheduler: public dynamo::SimBase
   {
@@ -41,11 +43,54 @@ namespace dynamo {
     virtual void initialise();
 
     void rebuildList();
+
+    /*! \brief Update the event lists after the velocities of all
+      particles have been multiplied by a factor (e.g., by
+      Dynamics::rescaleSystemKineticEnergy).
+
+      If the Dynamics, the BoundaryCondition and every Local are
+      invariant to a rescaling of time (see
+      Dynamics::timeScaleInvariant), the time until each queued event
+      is divided by the factor in place and only the System events
+      are rebuilt. Otherwise, every event is predicted again using
+      rebuildList.
+
+      \param factor The factor the velocities were multiplied by.
+     */
+    void velocitiesRescaled(const double factor);
+
+    /*! \brief Predict the events of a Local with every particle
+      again, after the state of the Local has changed (e.g., a moving
+      plate has been perturbed).
+
+      The other events of the particles are not affected, so only
+      the Local is tested. The previous events of the Local are
+      removed from the sorter first. Sorters which cannot remove
+      events (PELSingleEvent) may keep an out of date event, but
+      the events of Local-s are always recalculated before they are
+      run (see runNextEvent) so it is then discarded.
+     */
+    void updateLocalEvents(const Local&);
+
+    /*! \brief Writes the event counters and the sorter to a
+        checkpoint (see Simulation::writeCheckpoint).
+     */
+    void saveCheckpoint(CheckpointWriter&) const;
+
+    /*! \brief Restores the Scheduler from a checkpoint, in place of
+        initialise().
+
+	The configuration is not validated and no events are
+	predicted, the event lists are restored exactly as they were
+	written by saveCheckpoint.
+     */
+    virtual void loadCheckpoint(CheckpointReader&);
   
     /*! \brief Retest for events for a single particle.
      */
     inline void fullUpdate(Particle& part)
     {
+      EventProfiler::Phase phase(_profiler, EventProfiler::PREDICTION);
       invalidateEvents(part);
       addEvents(part);
       sort(part);
@@ -67,10 +112,37 @@ namespace dynamo {
     */
     inline void fullUpdate(Particle& p1, Particle& p2)
     {
+      EventProfiler::Phase phase(_profiler, EventProfiler::PREDICTION);
+      if (_threads) 
+	{
+	  parallelFullUpdate(p1, p2);
+	  return;
+	}
+
       fullUpdate(p1);
       fullUpdate(p2);
     }
 
+    /*! \brief Spread the event prediction of fullUpdate(Particle&,
+      Particle&) over the threads of a pool.
+
+      Once set, the interaction events of both particles are
+      predicted concurrently by the worker threads (see
+      parallelFullUpdate). This only pays off for interactions whose
+      event tests are expensive (e.g., ILines or IDumbbells), as the
+      tasks are dispatched for every event.
+
+      \param threads The pool to use, or NULL to predict serially.
+    */
+    void setThreadPool(magnet::thread::ThreadPool* threads) { _threads = threads; }
+
+    /*! \brief Set the profiler which times the phases of the event
+        loop (see OPProfile), or NULL to disable profiling.
+     */
+    void setProfiler(EventProfiler* profiler) { _profiler = profiler; }
+
+    EventProfiler* getProfiler() const { return _profiler; }
+
     void invalidateEvents(const Particle&);
 
     void addEvents(Particle&);
@@ -96,9 +168,31 @@ namespace dynamo {
 
     const shared_ptr<FEL>& getSorter() const { return sorter; }
 
+    /*! \brief Replace the sorter. Only valid before the Scheduler
+        is initialised.
+    */
+    void setSorter(const shared_ptr<FEL>& newSorter) { sorter = newSorter; }
+
     void rebuildSystemEvents() const;
 
     void addInteractionEvent(const Particle&, const size_t&) const;
+
+    /*! \brief Adds the interaction events of a particle with a range
+      of other particles.
+      
+      The particles are first grouped by their Interaction so that
+      each Interaction may predict its events in a single batch (see
+      Interaction::getEvents).
+     */
+    void addInteractionEvents(const Particle&, const IDRange&) const;
+
+    /*! \brief Brings the particles in a range up to date and groups
+      them by the Interaction they have with a particle.
+      
+      \param batchIDs Filled with the IDs of the particles for each
+      Interaction, indexed by the Interaction ID.
+     */
+    void groupNeighbours(const Particle&, const IDRange&, std::vector<std::vector<size_t> >& batchIDs) const;
     
     void addLocalEvent(const Particle&, const size_t&) const;
 
@@ -108,6 +202,18 @@ namespace dynamo {
     
     const std::vector<size_t>& getEventCounts() const { return eventCount; }
 
+    //! \brief True if invalidated interaction events are removed from the sorter straight away.
+    bool eagerInvalidation() const { return _eagerInvalidation; }
+
+    //! \brief The number of invalid interaction events popped by lazyDeletionCleanup.
+    size_t getStaleEventCount() const { return _staleEvents; }
+
+    //! \brief The number of invalid interaction events removed by eager invalidation.
+    size_t getEagerRemovalCount() const { return _eagerRemovals; }
+
+    //! \brief The number of events rejected and recalculated in runNextEvent.
+    size_t getRecalculatedEventCount() const { return _recalculatedEvents; }
+
   protected:
     /*! \brief Performs the lazy deletion algorithm to find the next
      * valid event in the queue.
@@ -118,8 +224,101 @@ namespace dynamo {
      */
     void lazyDeletionCleanup();
 
+    /*! \brief The threaded form of fullUpdate(Particle&, Particle&).
+
+      The particles and their neighbours are brought up to date and
+      the neighbours grouped serially. The interaction event
+      predictions are then split into chunks which the thread pool
+      evaluates into separate buffers, so no locking is
+      needed. Finally, the buffers are pushed into the sorter in the
+      same order as the serial algorithm, including invalidating p2
+      only after p1's events are pushed, so the event sequence is
+      identical.
+    */
+    void parallelFullUpdate(Particle& p1, Particle& p2);
+
+    /*! \brief Tests the state of every pair of neighbouring
+      particles and of every particle with its Local-s.
+
+      If the Simulation has a thread pool, the tests are split into chunks
+      of particles which are tested concurrently without any
+      output. The failed tests are then repeated serially in the
+      order of the serial algorithm to print the warnings, so the
+      output does not depend on the number of threads.
+
+      \param warnings The number of warnings already printed.
+      \return The total number of warnings.
+    */
+    size_t validateParticles(size_t warnings) const;
+
+    /*! \brief The threaded form of adding the events of every
+      particle in rebuildList.
+
+      All particles are first brought up to date, so the worker
+      threads only read the particle data. The particles are then
+      processed in blocks, the interaction events of the chunks of
+      each block are predicted concurrently into separate buffers,
+      which are then pushed into the sorter (along with the global and
+      local events) in particle order. The event lists are therefore
+      identical to the serial build, and the buffered events are
+      bounded by the size of a block.
+    */
+    void parallelAddEvents();
+
+    //! \brief Pushes the global and local events of a particle.
+    void addGlobalLocalEvents(Particle&) const;
+
+    /*! \brief Pushes an interaction event into the PEL of a
+      particle, noting the owner of the event if eager invalidation
+      is enabled.
+    */
+    void pushInteractionEvent(const IntEvent&, const size_t& ownerID) const;
+
+    /*! \brief If true, invalidateEvents also removes the interaction
+      events other particles hold with the invalidated particle.
+
+      Lazy deletion (the default) leaves these events in the sorter
+      until they reach the top of the queue, where
+      lazyDeletionCleanup discards them. In dense systems most of the
+      events in the sorter may be stale, which inflates the PELs and
+      the cost of each sorter operation. Eager invalidation keeps a
+      list of the owners of the events with each particle (see
+      _eventOwners) and removes them when the particle is
+      invalidated. The generation counters are still checked as a
+      safety net, but should never find a stale event.
+    */
+    bool _eagerInvalidation;
+
+    /*! \brief For each particle, the (ID, event count) of the
+      particles which have pushed interaction events with it since it
+      was last invalidated.
+
+      An entry is only valid if the owner has not itself been
+      invalidated since (its eventCount still matches), otherwise its
+      PEL has already been cleared.
+    */
+    mutable std::vector<std::vector<std::pair<size_t, size_t> > > _eventOwners;
+
+    size_t _staleEvents;
+    size_t _eagerRemovals;
+    size_t _recalculatedEvents;
+
+    //! \brief The thread pool used by parallelFullUpdate (if any).
+    magnet::thread::ThreadPool* _threads;
+    //! \brief The profiler of the event loop (if any).
+    EventProfiler* _profiler;
+    //! \brief Scratch space for parallelFullUpdate, the IDs of each particle's neighbours grouped by Interaction.
+    std::vector<std::vector<size_t> > _parallelIDs[2];
+    //! \brief Scratch space for parallelFullUpdate, the output buffer of each task.
+    std::vector<std::vector<IntEvent> > _taskEvents;
+
     mutable shared_ptr<FEL> sorter;
     mutable std::vector<size_t> eventCount;
+
+    //! \brief Scratch space for addInteractionEvents, holding the IDs grouped by Interaction.
+    mutable std::vector<std::vector<size_t> > _batchIDs;
+    //! \brief Scratch space for the events calculated by addInteractionEvents.
+    mutable std::vector<IntEvent> _batchEvents;
   
     size_t _interactionRejectionCounter;
     size_t _localRejectionCounter;
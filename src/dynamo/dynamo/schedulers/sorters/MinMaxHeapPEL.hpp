@@ -81,9 +81,39 @@ namespace dynamo {
 	dat.dt *= scale;
     }
 
+    /*! \brief Remove the interaction events with a particle.
+
+      Any RECALCULATE marker (from events lost when the heap was
+      full) is kept.
+     */
+    inline void removeInteractions(const size_t p2) {
+      removeIf([=](const Event& event) { return (event.type == INTERACTION) && (event.particle2ID == p2); });
+    }
+
+    //! \brief Remove the events with a Local, keeping any RECALCULATE marker.
+    inline void removeLocals(const size_t localID) {
+      removeIf([=](const Event& event) { return (event.type == LOCAL) && (event.localID == localID); });
+    }
+
     inline void swap(PELMinMax& rhs) {
       Base::swap(rhs);
     }
+
+  private:
+    template<class Pred>
+    inline void removeIf(const Pred& pred) {
+      std::array<Event, Size> kept;
+      size_t N(0);
+      for (const Event& event : *this)
+	if (!pred(event))
+	  kept[N++] = event;
+
+      if (N == Base::size()) return;
+      
+      clear();
+      for (size_t i(0); i < N; ++i)
+	Base::insert(kept[i]);
+    }
   };
 }
 
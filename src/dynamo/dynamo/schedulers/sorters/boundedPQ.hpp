@@ -35,6 +35,9 @@ namespace dynamo {
   template<size_t Size>
   class PELMinMax;
 
+  template<size_t Arity>
+  class PELDHeap;
+
   class PELSingleEvent;
 
   template<class T> struct FELBoundedPQName;
@@ -51,6 +54,12 @@ namespace dynamo {
     inline static std::string name() { return std::string("BoundedPQMinMax") + boost::lexical_cast<std::string>(I); }
   };
 
+  template<size_t I>
+  struct FELBoundedPQName<PELDHeap<I> >
+  {
+    inline static std::string name() { return std::string("BoundedPQDHeap") + boost::lexical_cast<std::string>(I); }
+  };
+
   template<>
   struct FELBoundedPQName<PELSingleEvent>
   {
@@ -243,6 +252,8 @@ namespace dynamo {
     inline void clearPEL(const size_t& ID) { Min[ID+1].data.clear(); }
     inline void popNextPELEvent(const size_t& ID) { Min[ID+1].data.pop(); }
     inline void popNextEvent() { Min[CBT[1]].data.pop(); }
+    inline void removeInteractionEvents(const size_t& ID, const size_t& p2) { Min[ID+1].data.removeInteractions(p2); }
+    inline void removeLocalEvents(const size_t& ID, const size_t& localID) { Min[ID+1].data.removeLocals(localID); }
     virtual bool empty() const { return Min[CBT[1]].data.empty(); }
 
     virtual std::pair<size_t, Event> next() const
@@ -273,6 +284,56 @@ namespace dynamo {
 
     }
 
+    void saveCheckpoint(CheckpointWriter& out) const
+    {
+      out.section(FELBoundedPQName<T>::name());
+      out.write(N);
+      out.write(NP);
+      out.write(exceptionCount);
+      out.write(currentIndex);
+      out.write(scale);
+      out.write(pecTime);
+      out.write(listWidth);
+      out.write(nlists);
+      out.write(linearLists);
+      out.write(CBT);
+      out.write(Leaf);
+      for (const eventQEntry& entry : Min)
+	{
+	  out.write(entry.next);
+	  out.write(entry.previous);
+	  out.write(entry.qIndex);
+	  detail::saveCheckpointPEL(out, entry.data);
+	}
+    }
+
+    void loadCheckpoint(CheckpointReader& in)
+    {
+      in.section(FELBoundedPQName<T>::name());
+      size_t storedN;
+      in.read(storedN);
+      if (storedN != N)
+	M_throw() << "The checkpoint holds " << storedN << " event lists, but the sorter has " << N;
+
+      in.read(NP);
+      in.read(exceptionCount);
+      in.read(currentIndex);
+      in.read(scale);
+      in.read(pecTime);
+      in.read(listWidth);
+      in.read(nlists);
+      in.read(linearLists);
+      in.read(CBT);
+      in.read(Leaf);
+      for (eventQEntry& entry : Min)
+	{
+	  in.read(entry.next);
+	  in.read(entry.previous);
+	  in.read(entry.qIndex);
+	  detail::loadCheckpointPEL(in, entry.data);
+	}
+    }
+
   private:
     ///////////////////////////BOUNDED QUEUE IMPLEMENTATION
     inline void insertInEventQ(int p)
@@ -0,0 +1,530 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/schedulers/sorters/event.hpp>
+#include <dynamo/schedulers/sorters/sorter.hpp>
+#include <dynamo/schedulers/sorters/heapPEL.hpp>
+#include <magnet/exception.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <boost/lexical_cast.hpp>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cmath>
+
+#ifdef DYNAMO_DEBUG
+#include <boost/math/special_functions/fpclassify.hpp>
+#endif
+
+namespace dynamo {
+  template<size_t Size>
+  class PELMinMax;
+
+  template<size_t Arity>
+  class PELDHeap;
+
+  class PELSingleEvent;
+
+  template<class T> struct FELCalendarQueueName;
+
+  template<>
+  struct FELCalendarQueueName<PELHeap>
+  {
+    inline static std::string name() { return "CalendarQueue"; }
+  };
+
+  template<size_t I>
+  struct FELCalendarQueueName<PELMinMax<I> >
+  {
+    inline static std::string name() { return std::string("CalendarQueueMinMax") + boost::lexical_cast<std::string>(I); }
+  };
+
+  template<size_t I>
+  struct FELCalendarQueueName<PELDHeap<I> >
+  {
+    inline static std::string name() { return std::string("CalendarQueueDHeap") + boost::lexical_cast<std::string>(I); }
+  };
+
+  template<>
+  struct FELCalendarQueueName<PELSingleEvent>
+  {
+    inline static std::string name() { return "CalendarQueueSingleEvent"; }
+  };
+
+  /*! \brief A calendar queue which adapts its bucket width to the
+      event rate of the simulation.
+
+      Like \ref FELBoundedPQ, the particle event lists are binned by
+      the time of their next event into a "year" of equal-width
+      buckets ("days"), plus an overflow list for the events beyond
+      the end of the year. Only the current day is kept sorted, here
+      in an indexed binary heap.
+
+      The difference is that \ref FELBoundedPQ sizes its buckets once
+      from a snapshot of the event times. If the collision rate then
+      changes (e.g., during compression, a quench, or gravitational
+      settling) the days either become crowded or most of the events
+      end up in the overflow list. This queue measures the mean time
+      between events as the simulation is streamed and, when the
+      bucket width drifts by more than a factor of two from
+      EventsPerBucket times this mean, or when half the events are
+      found in the overflow list at the end of a year, it rebuilds the
+      calendar with a new width. Each rebuild is O(N) and happens at
+      most once every N events, so all operations stay O(1)
+      amortised.
+   */
+  template<typename T = PELHeap>
+  class FELCalendarQueue: public FEL
+  {
+    struct Entry
+    {
+      T data;
+      int next;
+      int previous;
+      int bucket;
+      size_t heapIndex;
+    };
+
+    //! \brief The target mean number of events per bucket.
+    static constexpr double EventsPerBucket = 3;
+
+  public:
+    FELCalendarQueue() { clear(); }
+
+    void resize(const size_t& a)
+    {
+      clear();
+      _entries.resize(a);
+    }
+
+    void clear()
+    {
+      _entries.clear();
+      _buckets.clear();
+      _heap.clear();
+      _nbuckets = 0;
+      _currentBucket = 0;
+      _width = 1;
+      _pecTime = 0;
+      resetStatistics();
+    }
+
+    void init() { instrument(); }
+
+    void rebuild() { instrument(); }
+
+    virtual bool empty() const { return _heap.empty() || _entries[_heap.front()].data.empty(); }
+
+    inline void stream(const double& dt)
+    {
+      _pecTime += dt;
+      _elapsedTime += dt;
+      ++_streamedEvents;
+    }
+
+    inline void push(const Event& tmpVal, const size_t& pID)
+    {
+#ifdef DYNAMO_DEBUG
+      if (boost::math::isnan(tmpVal.dt))
+	M_throw() << "NaN value pushed into the sorter! Should be Inf I guess?";
+#endif
+
+      tmpVal.dt += _pecTime;
+      _entries[pID].data.push(tmpVal);
+    }
+
+    inline void update(const size_t& pID)
+    {
+      erase(pID);
+      insert(pID);
+    }
+
+    virtual std::pair<size_t, Event> next() const
+    {
+      Event nextevent = _entries[_heap.front()].data.top();
+      nextevent.dt -= _pecTime;
+      return std::pair<size_t, Event>(_heap.front(), nextevent);
+    }
+
+    inline void sort() { orderNextEvent(); }
+
+    inline void rescaleTimes(const double& factor)
+    {
+      for (Entry& entry : _entries)
+	entry.data.rescaleTimes(factor);
+
+      _pecTime *= factor;
+      _width *= factor;
+      _elapsedTime *= factor;
+    }
+
+    inline void clearPEL(const size_t& ID) { _entries[ID].data.clear(); }
+    inline void popNextPELEvent(const size_t& ID) { _entries[ID].data.pop(); }
+    inline void popNextEvent() { _entries[_heap.front()].data.pop(); }
+    inline void removeInteractionEvents(const size_t& ID, const size_t& p2) { _entries[ID].data.removeInteractions(p2); }
+    inline void removeLocalEvents(const size_t& ID, const size_t& localID) { _entries[ID].data.removeLocals(localID); }
+
+    void saveCheckpoint(CheckpointWriter& out) const
+    {
+      out.section(FELCalendarQueueName<T>::name());
+      out.write(_entries.size());
+      out.write(_buckets);
+      out.write(_heap);
+      out.write(_nbuckets);
+      out.write(_currentBucket);
+      out.write(_width);
+      out.write(_pecTime);
+      out.write(_elapsedTime);
+      out.write(_streamedEvents);
+      for (const Entry& entry : _entries)
+	{
+	  out.write(entry.next);
+	  out.write(entry.previous);
+	  out.write(entry.bucket);
+	  out.write(entry.heapIndex);
+	  detail::saveCheckpointPEL(out, entry.data);
+	}
+    }
+
+    void loadCheckpoint(CheckpointReader& in)
+    {
+      in.section(FELCalendarQueueName<T>::name());
+      size_t storedN;
+      in.read(storedN);
+      if (storedN != _entries.size())
+	M_throw() << "The checkpoint holds " << storedN << " event lists, but the sorter has " << _entries.size();
+
+      in.read(_buckets);
+      in.read(_heap);
+      in.read(_nbuckets);
+      in.read(_currentBucket);
+      in.read(_width);
+      in.read(_pecTime);
+      in.read(_elapsedTime);
+      in.read(_streamedEvents);
+      for (Entry& entry : _entries)
+	{
+	  in.read(entry.next);
+	  in.read(entry.previous);
+	  in.read(entry.bucket);
+	  in.read(entry.heapIndex);
+	  detail::loadCheckpointPEL(in, entry.data);
+	}
+    }
+
+  private:
+    virtual void outputXML(magnet::xml::XmlStream& XML) const
+    { XML << magnet::xml::attr("Type") << FELCalendarQueueName<T>::name(); }
+
+    void resetStatistics()
+    {
+      _elapsedTime = 0;
+      _streamedEvents = 0;
+    }
+
+    /*! \brief Sizes the calendar from the current contents of the
+        event lists.
+
+	The mean separation of the (finite) event times is an estimate
+	of the mean time between events.
+     */
+    void instrument()
+    {
+      if (_entries.empty()) return;
+
+      double minVal(HUGE_VAL), maxVal(-HUGE_VAL);
+      size_t counter(0);
+      //Some events use the largest double, not infinity, to mark
+      //events which never occur
+      for (const Entry& entry : _entries)
+	if (entry.data.getdt() < std::numeric_limits<double>::max())
+	  {
+	    minVal = std::min(minVal, entry.data.getdt());
+	    maxVal = std::max(maxVal, entry.data.getdt());
+	    ++counter;
+	  }
+
+      //Fall back to a unit separation if there are too few events or
+      //they're spread over a range larger than a double can hold
+      double width = EventsPerBucket * (maxVal - minVal) / counter;
+      if ((counter < 2) || !(width > 0) || std::isinf(width))
+	width = 1;
+
+      resetStatistics();
+      rebuildCalendar(width);
+    }
+
+    /*! \brief Redistribute every event list into a calendar with the
+        passed bucket width.
+
+	The stored times are first shifted so that the current day
+	becomes the first day of the new calendar.
+     */
+    void rebuildCalendar(const double width)
+    {
+      if (!(width > 0) || std::isinf(width))
+	M_throw() << "Invalid bucket width (" << width << ") for the calendar queue. May be caused by only having zero time collisions.";
+
+      const double offset = _currentBucket * _width;
+      if (offset != 0)
+	{
+	  for (Entry& entry : _entries)
+	    entry.data.stream(offset);
+	  _pecTime -= offset;
+	}
+
+      _width = width;
+      _currentBucket = 0;
+      _nbuckets = std::max(_entries.size(), size_t(16));
+      _buckets.clear();
+      _buckets.resize(_nbuckets + 1, -1); //+1 for the overflow list
+      _heap.clear();
+
+      for (size_t id(0); id < _entries.size(); ++id)
+	insert(id);
+
+      orderNextEvent();
+    }
+
+    /*! \brief Check the measured time between events against the
+        bucket width, rebuilding the calendar if they have drifted
+        apart.
+
+	Only called from orderNextEvent when the current day is
+	exhausted and at least N events have been streamed.
+     */
+    void checkWidth()
+    {
+      if (!_streamedEvents || !(_elapsedTime > 0) || std::isinf(_elapsedTime))
+	{
+	  resetStatistics();
+	  return;
+	}
+
+      const double targetWidth = EventsPerBucket * _elapsedTime / _streamedEvents;
+      resetStatistics();
+      if (std::isinf(targetWidth))
+	return;
+
+      if ((_width > 2 * targetWidth) || (_width < 0.5 * targetWidth))
+	rebuildCalendar(targetWidth);
+    }
+
+    inline void insert(const size_t id)
+    {
+      Entry& entry = _entries[id];
+      const double box = entry.data.getdt() / _width;
+
+      int i;
+      if (!(box < std::numeric_limits<int>::max()))
+	i = 2 * _nbuckets; //Put this in the overflow list
+      else if (box < _currentBucket)
+	i = _currentBucket; //Events in the past (e.g., negative times) go into the current day
+      else
+	i = static_cast<int>(box);
+
+      if (i > int(_nbuckets - 1)) //Wrap into next year
+	{
+	  i -= _nbuckets;
+	  if (i >= _currentBucket - 1)
+	    i = _nbuckets; //Overflow list
+	}
+
+      entry.bucket = i;
+
+      if (i == _currentBucket)
+	heapInsert(id);
+      else
+	{
+	  entry.previous = -1;
+	  entry.next = _buckets[i];
+	  if (_buckets[i] != -1)
+	    _entries[_buckets[i]].previous = id;
+	  _buckets[i] = id;
+	}
+    }
+
+    inline void erase(const size_t id)
+    {
+      Entry& entry = _entries[id];
+      if (entry.bucket == _currentBucket)
+	heapErase(id);
+      else
+	{
+	  if (entry.previous == -1)
+	    _buckets[entry.bucket] = entry.next;
+	  else
+	    _entries[entry.previous].next = entry.next;
+
+	  if (entry.next != -1)
+	    _entries[entry.next].previous = entry.previous;
+	}
+    }
+
+    //! \brief Advance through the days until one holds an event.
+    inline void orderNextEvent()
+    {
+      while (_heap.empty())
+	{
+	  if (_streamedEvents >= _entries.size())
+	    {
+	      checkWidth();
+	      if (!_heap.empty()) return;
+	    }
+
+	  if (++_currentBucket == int(_nbuckets))
+	    {
+	      //The year is over, shift all of the times back a year
+	      _currentBucket = 0;
+	      const double yearLength = _nbuckets * _width;
+	      for (Entry& entry : _entries)
+		entry.data.stream(yearLength);
+	      _pecTime -= yearLength;
+
+	      if (processOverflowList())
+		return;
+	    }
+
+	  for (int e = _buckets[_currentBucket]; e != -1; e = _entries[e].next)
+	    heapInsert(e);
+	  _buckets[_currentBucket] = -1;
+	}
+    }
+
+    /*! \brief Redistributes the overflow list at the end of a year.
+
+        \returns true if the calendar was rebuilt or the heap
+        populated.
+     */
+    inline bool processOverflowList()
+    {
+      int e = _buckets[_nbuckets];
+      _buckets[_nbuckets] = -1;
+
+      size_t overflowEvents(0);
+      while (e != -1)
+	{
+	  ++overflowEvents;
+	  const int eNext = _entries[e].next;
+	  insert(e);
+	  e = eNext;
+	}
+
+      size_t remaining(0);
+      for (e = _buckets[_nbuckets]; e != -1; e = _entries[e].next)
+	++remaining;
+
+      if (remaining && (remaining == _entries.size()))
+	{
+	  //Every event is at infinity or more than a year away. As
+	  //the heap then holds every entry it is safe to move them
+	  //straight into the current day.
+	  for (e = _buckets[_nbuckets]; e != -1; e = _entries[e].next)
+	    {
+	      _entries[e].bucket = _currentBucket;
+	      heapInsert(e);
+	    }
+	  _buckets[_nbuckets] = -1;
+
+	  //If any of these are finite the width is far too small
+	  if (!std::isinf(_entries[_heap.front()].data.getdt()))
+	    instrument();
+	  return true;
+	}
+
+      //The overflow list contained more than half the events, the
+      //year is too short.
+      if (overflowEvents > _entries.size() / 2)
+	{
+	  instrument();
+	  return true;
+	}
+
+      return false;
+    }
+
+    ///////////////////////////INDEXED BINARY HEAP IMPLEMENTATION
+    inline bool earlier(const size_t a, const size_t b) const
+    { return _entries[b].data > _entries[a].data; }
+
+    inline void heapSet(const size_t index, const size_t id)
+    {
+      _heap[index] = id;
+      _entries[id].heapIndex = index;
+    }
+
+    inline void heapInsert(const size_t id)
+    {
+      _heap.push_back(id);
+      siftUp(_heap.size() - 1);
+    }
+
+    inline void heapErase(const size_t id)
+    {
+      const size_t index = _entries[id].heapIndex;
+      const size_t last = _heap.back();
+      _heap.pop_back();
+      if (index == _heap.size()) return;
+      heapSet(index, last);
+      siftUp(index);
+      siftDown(_entries[last].heapIndex);
+    }
+
+    inline void siftUp(size_t index)
+    {
+      const size_t id = _heap[index];
+      while (index)
+	{
+	  const size_t parent = (index - 1) / 2;
+	  if (!earlier(id, _heap[parent])) break;
+	  heapSet(index, _heap[parent]);
+	  index = parent;
+	}
+      heapSet(index, id);
+    }
+
+    inline void siftDown(size_t index)
+    {
+      const size_t id = _heap[index];
+      for (;;)
+	{
+	  size_t child = 2 * index + 1;
+	  if (child >= _heap.size()) break;
+	  if ((child + 1 < _heap.size()) && earlier(_heap[child + 1], _heap[child]))
+	    ++child;
+	  if (!earlier(_heap[child], id)) break;
+	  heapSet(index, _heap[child]);
+	  index = child;
+	}
+      heapSet(index, id);
+    }
+
+    std::vector<Entry> _entries;
+    std::vector<int> _buckets;
+    std::vector<size_t> _heap;
+    size_t _nbuckets;
+    int _currentBucket;
+    double _width;
+    double _pecTime;
+
+    //! \brief The simulation time streamed since the width was last checked.
+    double _elapsedTime;
+    //! \brief The number of events streamed since the width was last checked.
+    size_t _streamedEvents;
+  };
+}
@@ -22,23 +22,74 @@
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <magnet/exception.hpp>
 #include <magnet/xmlwriter.hpp>
+#include <boost/lexical_cast.hpp>
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 
 namespace dynamo {
+  template<size_t Size>
+  class PELMinMax;
+
+  template<size_t Arity>
+  class PELDHeap;
+
+  class PELSingleEvent;
+
+  template<class T> struct FELCBTName;
+
+  template<>
+  struct FELCBTName<PELHeap>
+  {
+    inline static std::string name() { return "CBT"; }
+  };
+
+  template<size_t I>
+  struct FELCBTName<PELMinMax<I> >
+  {
+    inline static std::string name() { return std::string("CBTMinMax") + boost::lexical_cast<std::string>(I); }
+  };
+
+  template<size_t I>
+  struct FELCBTName<PELDHeap<I> >
+  {
+    inline static std::string name() { return std::string("CBTDHeap") + boost::lexical_cast<std::string>(I); }
+  };
+
+  template<>
+  struct FELCBTName<PELSingleEvent>
+  {
+    inline static std::string name() { return "CBTSingleEvent"; }
+  };
+
+  /*! \brief A complete binary (tournament) tree over the Particle
+      Event Lists.
+
+      The tree and leaf indices are 32 bit, which halves the size of
+      the tree compared to size_t indices (and so more of it stays in
+      cache), but limits the sorter to 2^31 PELs.
+
+      \tparam T The type of the Particle Event Lists.
+   */
+  template<typename T = PELHeap>
   class FELCBT: public FEL
   {
   private:
-    std::vector<unsigned long> CBT;
-    std::vector<unsigned long> Leaf;
-    std::vector<PELHeap> Min;
-    unsigned long NP, N, streamFreq, nUpdate;
+    typedef uint32_t Index;
+    std::vector<Index> CBT;
+    std::vector<Index> Leaf;
+    std::vector<T> Min;
+    size_t NP, N, streamFreq, nUpdate;
 
     double pecTime;
 
   public:
     void resize(const size_t& a)
     {
+      if (2 * a >= std::numeric_limits<Index>::max())
+	M_throw() << "Too many particle event lists (" << a << ") for the 32 bit CBT indices";
+
       clear();
       streamFreq = N = a;
       CBT.resize(2 * N);
@@ -76,7 +127,7 @@ namespace dynamo {
 
       if (!(nUpdate % streamFreq))
 	{
-	  for (PELHeap& pDat : Min)
+	  for (T& pDat : Min)
 	    pDat.stream(pecTime);
 	  pecTime = 0.0;
 	}
@@ -85,6 +136,8 @@ namespace dynamo {
     inline void clearPEL(const size_t& ID) { Min[ID+1].clear(); }
     inline void popNextPELEvent(const size_t& ID) { Min[ID+1].pop(); }
     inline void popNextEvent() { Min[CBT[1]].pop(); }
+    inline void removeInteractionEvents(const size_t& ID, const size_t& p2) { Min[ID+1].removeInteractions(p2); }
+    inline void removeLocalEvents(const size_t& ID, const size_t& localID) { Min[ID+1].removeLocals(localID); }
     inline bool empty() const { return Min[CBT[1]].empty(); }
 
     inline void push(const Event& tmpVal, const size_t& pID)
@@ -111,17 +164,49 @@ namespace dynamo {
 
     inline void rescaleTimes(const double& factor)
     {
-      for (PELHeap& pDat : Min)
+      for (T& pDat : Min)
 	pDat.rescaleTimes(factor);
       pecTime *= factor;
     }
 
     inline void sort() {}
 
+    void saveCheckpoint(CheckpointWriter& out) const
+    {
+      out.section(FELCBTName<T>::name());
+      out.write(N);
+      out.write(NP);
+      out.write(streamFreq);
+      out.write(nUpdate);
+      out.write(pecTime);
+      out.write(CBT);
+      out.write(Leaf);
+      for (const T& pel : Min)
+	detail::saveCheckpointPEL(out, pel);
+    }
+
+    void loadCheckpoint(CheckpointReader& in)
+    {
+      in.section(FELCBTName<T>::name());
+      size_t storedN;
+      in.read(storedN);
+      if (storedN != N)
+	M_throw() << "The checkpoint holds " << storedN << " event lists, but the sorter has " << N;
+
+      in.read(NP);
+      in.read(streamFreq);
+      in.read(nUpdate);
+      in.read(pecTime);
+      in.read(CBT);
+      in.read(Leaf);
+      for (T& pel : Min)
+	detail::loadCheckpointPEL(in, pel);
+    }
+
   private:
-    inline void UpdateCBT(unsigned int i)
+    inline void UpdateCBT(Index i)
     {
-      unsigned int f = Leaf[i]/2,l,r,w;
+      Index f = Leaf[i]/2,l,r,w;
 
       //While i is at the top we must keep walking up, cause i could win
       //or could not
@@ -150,10 +235,10 @@ namespace dynamo {
 	}
     }
 
-    inline void Insert(unsigned int i)
+    inline void Insert(Index i)
     {
       if (NP == 0) {CBT[1]=i; NP++; return;}
-      int j = CBT[NP];
+      Index j = CBT[NP];
       CBT [NP*2] = j;
       CBT [NP*2+1] = i;
       Leaf[j] = NP*2;
@@ -162,10 +247,10 @@ namespace dynamo {
       UpdateCBT (j);
     }
   
-    inline void Delete(unsigned int i)
+    inline void Delete(Index i)
     {
       if (NP < 2) { CBT[1]=0; Leaf[0]=1; --NP; return; }
-      int l = NP * 2 - 1;
+      Index l = NP * 2 - 1;
       if (CBT[l-1] != i)
 	{
 	  Leaf[CBT[l-1]] = l/2;
@@ -192,7 +277,7 @@ namespace dynamo {
     }
 
     virtual void outputXML(magnet::xml::XmlStream& XML) const
-    { XML << magnet::xml::attr("Type") << "CBT"; }
+    { XML << magnet::xml::attr("Type") << FELCBTName<T>::name(); }
 
   };
 }
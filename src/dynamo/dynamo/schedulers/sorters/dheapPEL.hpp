@@ -0,0 +1,82 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <dynamo/schedulers/sorters/event.hpp>
+#include <magnet/containers/DaryHeap.hpp>
+
+namespace dynamo {
+  /*! \brief A Particle Event List stored in a d-ary heap.
+
+    This is an unbounded PEL like \ref PELHeap, but with the children
+    of each node stored together in cache-aligned blocks (four Events
+    fill two cache lines). Which of the PELs is fastest depends on the
+    number of events per particle, so use the sorter benchmark to
+    choose.
+  */
+  template<size_t Arity>
+  class PELDHeap: public magnet::containers::DaryHeap<Event, Arity>
+  {
+    typedef magnet::containers::DaryHeap<Event, Arity> Base;
+  public:
+    inline bool operator> (const PELDHeap& ip) const {
+      //If the other is empty this can never be longer
+      //If this is empty and the other isn't its always longer
+      //Otherwise compare
+      return (ip.empty()) ?  false : (Base::empty() || (Base::top().dt > ip.top().dt));
+    }
+
+    inline bool operator< (const PELDHeap& ip) const {
+      return (ip > *this);
+    }
+
+    inline double getdt() const {
+      return (Base::empty()) ? HUGE_VAL : Base::top().dt;
+    }
+
+    inline void stream(const double& ndt) {
+      for (Event& dat : *this)
+	dat.dt -= ndt;
+    }
+
+    inline void rescaleTimes(const double& scale) {
+      for (Event& dat : *this)
+	dat.dt *= scale;
+    }
+
+    //! \brief Remove the interaction events with a particle.
+    inline void removeInteractions(const size_t p2) {
+      Base::remove_if([=](const Event& event) { return (event.type == INTERACTION) && (event.particle2ID == p2); });
+    }
+
+    //! \brief Remove the events with a Local.
+    inline void removeLocals(const size_t localID) {
+      Base::remove_if([=](const Event& event) { return (event.type == LOCAL) && (event.localID == localID); });
+    }
+  };
+}
+
+namespace std
+{
+  /*! \brief Template specialisation of the std::swap function for PELDHeap*/
+  template<size_t Arity>
+  void swap(dynamo::PELDHeap<Arity>& lhs, dynamo::PELDHeap<Arity>& rhs)
+  {
+    lhs.swap(rhs);
+  }
+}
@@ -18,6 +18,7 @@
 #pragma once
 #include <dynamo/schedulers/sorters/event.hpp>
 #include <queue>
+#include <algorithm>
 
 namespace dynamo {
   class PELHeap: public std::priority_queue<Event, std::vector<Event>, std::greater<Event> >
@@ -34,6 +35,10 @@ namespace dynamo {
     inline void clear() {
       c.clear();
     }
+
+    //! \brief The events in the order they are stored in the heap.
+    inline std::vector<Event>::const_iterator begin() const { return c.begin(); }
+    inline std::vector<Event>::const_iterator end() const { return c.end(); }
     
     inline bool operator< (const PELHeap& ip) const {
       return (ip > *this);
@@ -53,6 +58,18 @@ namespace dynamo {
 	dat.dt *= scale;
     }
 
+    //! \brief Remove the interaction events with a particle.
+    inline void removeInteractions(const size_t p2) {
+      c.erase(std::remove_if(c.begin(), c.end(), [=](const Event& event) { return (event.type == INTERACTION) && (event.particle2ID == p2); }), c.end());
+      std::make_heap(c.begin(), c.end(), comp);
+    }
+
+    //! \brief Remove the events with a Local.
+    inline void removeLocals(const size_t localID) {
+      c.erase(std::remove_if(c.begin(), c.end(), [=](const Event& event) { return (event.type == LOCAL) && (event.localID == localID); }), c.end());
+      std::make_heap(c.begin(), c.end(), comp);
+    }
+
     inline void swap(PELHeap& rhs) {
       std::swap(c, rhs.c);
     }
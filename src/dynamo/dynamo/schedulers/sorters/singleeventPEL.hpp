@@ -37,6 +37,9 @@ namespace dynamo {
     inline const Event& front() const { return _event; }
     inline const Event& top() const { return _event; }  
 
+    inline const Event* begin() const { return &_event; }
+    inline const Event* end() const { return &_event + size(); }
+
     inline void pop()
     { 
       if (empty()) return;
@@ -69,6 +72,21 @@ namespace dynamo {
       _event = std::min(__x, _event); 
     }
 
+    /*! \brief Eager removal of interaction events is not performed.
+
+      Other events may have been discarded to keep this one, so
+      removing it would require a recalculation of the particle's
+      events. Recalculating invalidates the particle, which can
+      trigger the same removal in its partner's PEL and loop
+      forever. The stale event is instead left for the lazy deletion
+      in the Scheduler, which recalculates when it reaches the top of
+      the queue.
+     */
+    inline void removeInteractions(const size_t) {}
+
+    //! \brief Local events are not removed, for the same reason as removeInteractions.
+    inline void removeLocals(const size_t) {}
+
     inline void rescaleTimes(const double& scale) throw()
     { _event.dt *= scale; }
 
@@ -24,28 +24,56 @@ namespace dynamo {
   shared_ptr<FEL>
   FEL::getClass(const magnet::xml::Node& XML)
   {
-    if (std::string(XML.getAttribute("Type")) == FELBoundedPQName<PELHeap>::name())
+    return getClass(std::string(XML.getAttribute("Type")));
+  }
+
+  shared_ptr<FEL>
+  FEL::getClass(const std::string& type)
+  {
+    if (type == FELBoundedPQName<PELHeap>::name())
       return shared_ptr<FEL>(new FELBoundedPQ<>());
-    if (std::string(XML.getAttribute("Type")) == FELBoundedPQName<PELSingleEvent>::name())
+    if (type == FELBoundedPQName<PELSingleEvent>::name())
       return shared_ptr<FEL>(new FELBoundedPQ<PELSingleEvent>());
-    if (std::string(XML.getAttribute("Type")) == FELBoundedPQName<PELMinMax<2> >::name())
+    if (type == FELBoundedPQName<PELMinMax<2> >::name())
       return shared_ptr<FEL>(new FELBoundedPQ<PELMinMax<2> >());
-    if (std::string(XML.getAttribute("Type")) == FELBoundedPQName<PELMinMax<3> >::name())
+    if (type == FELBoundedPQName<PELMinMax<3> >::name())
       return shared_ptr<FEL>(new FELBoundedPQ<PELMinMax<3> >());
-    if (std::string(XML.getAttribute("Type")) == FELBoundedPQName<PELMinMax<4> >::name())
+    if (type == FELBoundedPQName<PELMinMax<4> >::name())
       return shared_ptr<FEL>(new FELBoundedPQ<PELMinMax<4> >());
-    if (std::string(XML.getAttribute("Type")) == FELBoundedPQName<PELMinMax<5> >::name())
+    if (type == FELBoundedPQName<PELMinMax<5> >::name())
       return shared_ptr<FEL>(new FELBoundedPQ<PELMinMax<5> >());
-    if (std::string(XML.getAttribute("Type")) == FELBoundedPQName<PELMinMax<6> >::name())
+    if (type == FELBoundedPQName<PELMinMax<6> >::name())
       return shared_ptr<FEL>(new FELBoundedPQ<PELMinMax<6> >());
-    if (std::string(XML.getAttribute("Type")) == FELBoundedPQName<PELMinMax<7> >::name())
+    if (type == FELBoundedPQName<PELMinMax<7> >::name())
       return shared_ptr<FEL>(new FELBoundedPQ<PELMinMax<7> >());
-    if (std::string(XML.getAttribute("Type")) == FELBoundedPQName<PELMinMax<8> >::name())
+    if (type == FELBoundedPQName<PELMinMax<8> >::name())
       return shared_ptr<FEL>(new FELBoundedPQ<PELMinMax<8> >());
-    else if (std::string(XML.getAttribute("Type")) == std::string("CBT"))
-      return shared_ptr<FEL>(new FELCBT());
+    if (type == FELBoundedPQName<PELDHeap<4> >::name())
+      return shared_ptr<FEL>(new FELBoundedPQ<PELDHeap<4> >());
+    if (type == FELBoundedPQName<PELDHeap<8> >::name())
+      return shared_ptr<FEL>(new FELBoundedPQ<PELDHeap<8> >());
+    if (type == FELCalendarQueueName<PELHeap>::name())
+      return shared_ptr<FEL>(new FELCalendarQueue<>());
+    if (type == FELCalendarQueueName<PELSingleEvent>::name())
+      return shared_ptr<FEL>(new FELCalendarQueue<PELSingleEvent>());
+    if (type == FELCalendarQueueName<PELMinMax<3> >::name())
+      return shared_ptr<FEL>(new FELCalendarQueue<PELMinMax<3> >());
+    if (type == FELCalendarQueueName<PELDHeap<4> >::name())
+      return shared_ptr<FEL>(new FELCalendarQueue<PELDHeap<4> >());
+    if (type == FELCalendarQueueName<PELDHeap<8> >::name())
+      return shared_ptr<FEL>(new FELCalendarQueue<PELDHeap<8> >());
+    if (type == FELCBTName<PELHeap>::name())
+      return shared_ptr<FEL>(new FELCBT<>());
+    if (type == FELCBTName<PELSingleEvent>::name())
+      return shared_ptr<FEL>(new FELCBT<PELSingleEvent>());
+    if (type == FELCBTName<PELMinMax<3> >::name())
+      return shared_ptr<FEL>(new FELCBT<PELMinMax<3> >());
+    if (type == FELCBTName<PELDHeap<4> >::name())
+      return shared_ptr<FEL>(new FELCBT<PELDHeap<4> >());
+    if (type == FELCBTName<PELDHeap<8> >::name())
+      return shared_ptr<FEL>(new FELCBT<PELDHeap<8> >());
     else 
-      M_throw() << "Unknown type of Sorter encountered";
+      M_throw() << "Unknown type of Sorter encountered (" << type << ")";
   }
 
   magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const FEL& srtr)
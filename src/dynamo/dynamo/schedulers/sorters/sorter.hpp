@@ -19,6 +19,8 @@
 #include <dynamo/schedulers/sorters/event.hpp>
 #include <dynamo/base.hpp>
 #include <dynamo/eventtypes.hpp>
+#include <dynamo/checkpoint.hpp>
+#include <string>
 
 namespace magnet { namespace xml { class Node; } } 
 namespace xml { class XmlStream; } 
@@ -49,13 +51,67 @@ namespace dynamo {
     virtual void   clearPEL(const size_t&) = 0;
     virtual void   popNextPELEvent(const size_t&) = 0;
     virtual void   popNextEvent() = 0;
+    //! \brief Remove any interaction events with particle2ID from a PEL (update must be called afterwards).
+    virtual void   removeInteractionEvents(const size_t& ID, const size_t& particle2ID) = 0;
+    //! \brief Remove any events with the Local localID from a PEL (update must be called afterwards).
+    virtual void   removeLocalEvents(const size_t& ID, const size_t& localID) = 0;
+
+    /*! \brief Writes the complete state of the sorter to a
+        checkpoint, including the PEL contents and any internal
+        bookkeeping (e.g., the current bucket and its width).
+
+	Restoring this state with loadCheckpoint, instead of pushing
+	the events and calling init(), keeps the floating point history
+	of the stored event times, so a continued run is identical to
+	one which was never interrupted.
+     */
+    virtual void   saveCheckpoint(CheckpointWriter&) const = 0;
+    //! \brief Restores the state written by saveCheckpoint, resize must already have been called.
+    virtual void   loadCheckpoint(CheckpointReader&) = 0;
 
     static shared_ptr<FEL> getClass(const magnet::xml::Node&);
 
+    /*! \brief Construct a sorter from the name of its type, as
+        written in the Type attribute of the Sorter tag.
+    */
+    static shared_ptr<FEL> getClass(const std::string&);
+
     friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream&, const FEL&);
 
   private:
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
   
   };
+
+  namespace detail {
+    //! \brief Writes the events of a PEL in the order they are stored.
+    template<class PEL>
+    void saveCheckpointPEL(CheckpointWriter& out, const PEL& pel)
+    {
+      out.write(uint64_t(pel.size()));
+      for (const Event& event : pel)
+	out.write(event);
+    }
+
+    /*! \brief Restores the events of a PEL written by
+        saveCheckpointPEL.
+
+	The heap based PELs only move an inserted event if it
+	strictly violates the heap order, so pushing the events of a
+	valid heap in storage order rebuilds exactly the same heap.
+     */
+    template<class PEL>
+    void loadCheckpointPEL(CheckpointReader& in, PEL& pel)
+    {
+      pel.clear();
+      uint64_t size;
+      in.read(size);
+      for (uint64_t i(0); i < size; ++i)
+	{
+	  Event event;
+	  in.read(event);
+	  pel.push(event);
+	}
+    }
+  }
 }
@@ -0,0 +1,192 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/schedulers/sorters/sorter.hpp>
+#include <dynamo/schedulers/sorters/event.hpp>
+#include <magnet/exception.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+namespace dynamo {
+  /*! \brief A single call on a FEL, as stored in a sorter trace.
+
+    Traces are a raw dump of these records, so they are only portable
+    between machines of the same endianness.
+   */
+  struct SorterTraceRecord
+  {
+    enum Operation
+      {
+	RESIZE, CLEAR, INIT, REBUILD, STREAM, PUSH, UPDATE, NEXT, SORT,
+	RESCALE, CLEARPEL, POPNEXTPEL, POPNEXT, REMOVEINTERACTIONS,
+	REMOVELOCALS
+      };
+
+    uint32_t op;
+    //! \brief The PEL/particle ID, or the size for RESIZE.
+    uint32_t id;
+    //! \brief The time of the event or stream, or the rescale factor.
+    double value;
+    //! \brief The collision counter of a pushed event.
+    uint64_t collCounter2;
+    //! \brief The extra ID of a pushed event, the partner particle of REMOVEINTERACTIONS, or the Local of REMOVELOCALS.
+    uint64_t extraID;
+    //! \brief The type of a pushed event.
+    uint32_t type;
+    uint32_t padding;
+  };
+
+  /*! \brief A FEL which passes every call onto another FEL, while
+      writing them to a trace file.
+
+      The trace can then be replayed into each type of sorter (see
+      replaySorterTrace and the dynasortbench program) to benchmark
+      them on exactly the workload of a real simulation.
+   */
+  class FELTrace: public FEL
+  {
+  public:
+    FELTrace(shared_ptr<FEL> sorter, const std::string& fileName):
+      _sorter(sorter),
+      _file(fileName.c_str(), std::ios::binary | std::ios::out | std::ios::trunc)
+    {
+      if (!_file)
+	M_throw() << "Failed to open the sorter trace file " << fileName;
+    }
+
+    virtual void resize(const size_t& n) { record(SorterTraceRecord::RESIZE, n); _sorter->resize(n); }
+    virtual void clear() { record(SorterTraceRecord::CLEAR); _sorter->clear(); }
+    virtual void init() { record(SorterTraceRecord::INIT); _sorter->init(); }
+    virtual bool empty() const { return _sorter->empty(); }
+    virtual void rebuild() { record(SorterTraceRecord::REBUILD); _sorter->rebuild(); }
+    virtual void stream(const double& dt) { record(SorterTraceRecord::STREAM, 0, dt); _sorter->stream(dt); }
+
+    virtual void push(const Event& event, const size_t& id)
+    {
+      //The sorters may modify the time of the passed event
+      record(SorterTraceRecord::PUSH, id, event.dt, event.collCounter2, event.extraID, event.type);
+      _sorter->push(event, id);
+    }
+
+    virtual void update(const size_t& id) { record(SorterTraceRecord::UPDATE, id); _sorter->update(id); }
+
+    virtual std::pair<size_t, Event> next() const
+    {
+      const std::pair<size_t, Event> retval = _sorter->next();
+      record(SorterTraceRecord::NEXT, retval.first, retval.second.dt);
+      return retval;
+    }
+
+    virtual void sort() { record(SorterTraceRecord::SORT); _sorter->sort(); }
+    virtual void rescaleTimes(const double& factor) { record(SorterTraceRecord::RESCALE, 0, factor); _sorter->rescaleTimes(factor); }
+    virtual void clearPEL(const size_t& id) { record(SorterTraceRecord::CLEARPEL, id); _sorter->clearPEL(id); }
+    virtual void popNextPELEvent(const size_t& id) { record(SorterTraceRecord::POPNEXTPEL, id); _sorter->popNextPELEvent(id); }
+    virtual void popNextEvent() { record(SorterTraceRecord::POPNEXT); _sorter->popNextEvent(); }
+
+    virtual void saveCheckpoint(CheckpointWriter& out) const { _sorter->saveCheckpoint(out); }
+    virtual void loadCheckpoint(CheckpointReader& in) { _sorter->loadCheckpoint(in); }
+
+    virtual void removeInteractionEvents(const size_t& id, const size_t& p2)
+    {
+      record(SorterTraceRecord::REMOVEINTERACTIONS, id, 0, 0, p2);
+      _sorter->removeInteractionEvents(id, p2);
+    }
+
+    virtual void removeLocalEvents(const size_t& id, const size_t& localID)
+    {
+      record(SorterTraceRecord::REMOVELOCALS, id, 0, 0, localID);
+      _sorter->removeLocalEvents(id, localID);
+    }
+
+  private:
+    virtual void outputXML(magnet::xml::XmlStream& XML) const { XML << *_sorter; }
+
+    inline void record(uint32_t op, size_t id = 0, double value = 0, uint64_t collCounter2 = 0, uint64_t extraID = 0, uint32_t type = 0) const
+    {
+      const SorterTraceRecord rec = {op, uint32_t(id), value, collCounter2, extraID, type, 0};
+      _file.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    }
+
+    shared_ptr<FEL> _sorter;
+    mutable std::ofstream _file;
+  };
+
+  //! \brief Load every record of a sorter trace.
+  inline std::vector<SorterTraceRecord> loadSorterTrace(std::istream& in)
+  {
+    std::vector<SorterTraceRecord> trace;
+    SorterTraceRecord rec;
+    while (in.read(reinterpret_cast<char*>(&rec), sizeof(rec)))
+      trace.push_back(rec);
+    return trace;
+  }
+
+  /*! \brief Replays a trace into a sorter.
+
+    Sorters may break ties between equal event times differently
+    (every pair event is stored in the PELs of both particles, so ties
+    are common). To keep the sorter in the same state as the recorded
+    one, popNextEvent is replayed as a pop of the PEL returned by the
+    last recorded call to next.
+
+    \returns The number of calls to next which returned an event at
+    a different time to the recorded one. This should be zero.
+   */
+  inline size_t replaySorterTrace(const std::vector<SorterTraceRecord>& trace, FEL& sorter)
+  {
+    size_t mismatches(0);
+    size_t lastNextID(0);
+    for (const SorterTraceRecord& rec : trace)
+      switch (rec.op)
+	{
+	case SorterTraceRecord::RESIZE: sorter.resize(rec.id); break;
+	case SorterTraceRecord::CLEAR: sorter.clear(); break;
+	case SorterTraceRecord::INIT: sorter.init(); break;
+	case SorterTraceRecord::REBUILD: sorter.rebuild(); break;
+	case SorterTraceRecord::STREAM: sorter.stream(rec.value); break;
+	case SorterTraceRecord::PUSH:
+	  sorter.push(Event(rec.value, EEventType(rec.type), rec.extraID, rec.collCounter2), rec.id);
+	  break;
+	case SorterTraceRecord::UPDATE: sorter.update(rec.id); break;
+	case SorterTraceRecord::NEXT:
+	  {
+	    const std::pair<size_t, Event> next = sorter.next();
+	    lastNextID = rec.id;
+	    if ((next.first != rec.id) && (std::abs(next.second.dt - rec.value) > 1e-10 * std::max(1.0, std::abs(rec.value))))
+	      ++mismatches;
+	    break;
+	  }
+	case SorterTraceRecord::SORT: sorter.sort(); break;
+	case SorterTraceRecord::RESCALE: sorter.rescaleTimes(rec.value); break;
+	case SorterTraceRecord::CLEARPEL: sorter.clearPEL(rec.id); break;
+	case SorterTraceRecord::POPNEXTPEL: sorter.popNextPELEvent(rec.id); break;
+	case SorterTraceRecord::POPNEXT: sorter.popNextPELEvent(lastNextID); break;
+	case SorterTraceRecord::REMOVEINTERACTIONS: sorter.removeInteractionEvents(rec.id, rec.extraID); break;
+	case SorterTraceRecord::REMOVELOCALS: sorter.removeLocalEvents(rec.id, rec.extraID); break;
+	default:
+	  M_throw() << "Unknown operation (" << rec.op << ") in sorter trace";
+	}
+    return mismatches;
+  }
+}
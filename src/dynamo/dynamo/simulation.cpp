@@ -28,6 +28,7 @@
 #include <dynamo/globals/global.hpp>
 #include <dynamo/interactions/interaction.hpp>
 #include <dynamo/outputplugins/misc.hpp>
+#include <dynamo/outputplugins/eventbuffer.hpp>
 #include <dynamo/globals/PBCSentinel.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/iostreams/device/file.hpp>
@@ -37,7 +38,21 @@
 #include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/copy.hpp>
 #include <dynamo/BC/BC.hpp>
+#include <dynamo/ranges/IDRangeAll.hpp>
+#include <dynamo/ranges/IDRangeNone.hpp>
+#include <dynamo/ranges/IDPairRangeAll.hpp>
+#include <dynamo/ranges/IDPairRangeNone.hpp>
+#include <dynamo/systems/andersenThermostat.hpp>
+#include <dynamo/systems/DSMCspheres.hpp>
+#include <dynamo/systems/sleep.hpp>
+#include <dynamo/systems/umbrella.hpp>
+#include <magnet/math/morton_number.hpp>
+#include <map>
+#include <fstream>
+#include <sstream>
 #include <iomanip>
+#include <cmath>
+#include <algorithm>
 
 //! The configuration file version, a version mismatch prevents an XML file load.
 static const std::string configFileVersion("1.5.0");
@@ -54,11 +69,16 @@ namespace dynamo
     N(0),
     primaryCellSize(1,1,1),
     ranGenerator(std::random_device()()),
+    outputBufferSize(4096),
+    threadedOutput(false),
+    threads(NULL),
     lastRunMFT(0.0),
     simID(0),
     replexExchangeNumber(0),
     status(START),
-    _sigParticleUpdate(new magnet::Signal<void(const NEventData&)>)
+    _sigParticleUpdate(new magnet::Signal<void(const NEventData&)>),
+    _checkpointParticles(0),
+    _classCount(0)
   {}
 
   namespace {
@@ -117,6 +137,8 @@ namespace dynamo
 	count = 0;
       }
     
+    species.buildLookup(particles);
+
     //Now confirm that there are not more counts from each species
     //than there are particles
     {
@@ -143,6 +165,8 @@ namespace dynamo
       for (shared_ptr<Interaction>& ptr : interactions)
 	ptr->initialise(ID++);
 
+      buildDispatchTables();
+
       if (std::dynamic_pointer_cast<BCPeriodic>(BCs))
 	{
 	  double max_interaction_dist = getLongestInteraction();
@@ -187,25 +211,212 @@ namespace dynamo
     if (ptrScheduler == NULL)
       M_throw() << "The scheduler has not been set!";      
 
-    if (endEventCount) 
-      //Only initialise the scheduler if we're simulating
+    if (endEventCount && !_checkpoint)
+      //Only initialise the scheduler if we're simulating, a
+      //checkpoint restores it in restoreCheckpoint instead
       ptrScheduler->initialise();
 
     for (shared_ptr<OutputPlugin> & Ptr : outputPlugins)
       Ptr->initialise();
 
+    _outputBuffer.reset();
+    if (outputBufferSize)
+      for (const shared_ptr<OutputPlugin>& Ptr : outputPlugins)
+	if (Ptr->bufferedEvents())
+	  {
+	    _outputBuffer.reset(new OutputEventBuffer(this, outputBufferSize, threadedOutput));
+	    break;
+	  }
+
     _nextPrint = eventCount + eventPrintInterval;
+
+    if (_checkpoint)
+      restoreCheckpoint();
+
     status = INITIALISED;
   }
 
+  void
+  Simulation::writeCheckpoint(std::string fileName)
+  {
+    if (status < INITIALISED)
+      M_throw() << "Cannot write a checkpoint of a simulation which has not been initialised";
+
+    flushOutputEvents();
+
+    CheckpointWriter out(fileName, N);
+
+    out.section("Simulation");
+    out.write(systemTime);
+    out.write(eventCount);
+    out.write(_renumberedIDs);
+
+    out.section("Particles");
+    out.writeArray(particles.data(), particles.size());
+
+    dynamics->saveCheckpoint(out);
+
+    out.section("BC");
+    BCs->saveCheckpoint(out);
+
+    for (const shared_ptr<Interaction>& ptr : interactions)
+      {
+	out.section(ptr->getName());
+	ptr->saveCheckpoint(out);
+      }
+
+    for (const shared_ptr<Local>& ptr : locals)
+      {
+	out.section(ptr->getName());
+	ptr->saveCheckpoint(out);
+      }
+
+    for (const shared_ptr<Global>& ptr : globals)
+      {
+	out.section(ptr->getName());
+	ptr->saveCheckpoint(out);
+      }
+
+    for (const shared_ptr<System>& ptr : systems)
+      {
+	out.section(ptr->getName());
+	ptr->saveCheckpoint(out);
+      }
+
+    ptrScheduler->saveCheckpoint(out);
+
+    out.section("State");
+    out.write(_nextPrint);
+    std::ostringstream rngState;
+    rngState << ranGenerator;
+    out.write(rngState.str());
+
+    //The plugins are last, as a continued run may load different
+    //plugins, and then their state is not read
+    out.section("OutputPlugins");
+    out.write(uint64_t(outputPlugins.size()));
+    for (const shared_ptr<OutputPlugin>& ptr : outputPlugins)
+      out.write(ptr->getPluginName());
+
+    for (const shared_ptr<OutputPlugin>& ptr : outputPlugins)
+      {
+	out.section(ptr->getPluginName());
+	ptr->saveCheckpoint(out);
+      }
+
+    out.commit();
+
+    dout << "Checkpoint written to " << fileName << " at event " << eventCount << std::endl;
+  }
+
+  void
+  Simulation::loadCheckpoint(std::string fileName)
+  {
+    if (status != CONFIG_LOADED)
+      M_throw() << "A checkpoint can only be loaded once the configuration is loaded and before the simulation is initialised";
+
+    _checkpoint.reset(new CheckpointReader(fileName));
+    CheckpointReader& in = *_checkpoint;
+
+    if (in.getHeader().N != N)
+      M_throw() << "The checkpoint " << fileName << " holds " << in.getHeader().N << " particles, but the configuration has " << N;
+
+    in.section("Simulation");
+    in.read(systemTime);
+    in.read(eventCount);
+
+    std::vector<size_t> renumberedIDs;
+    in.read(renumberedIDs);
+    if (renumberedIDs != _renumberedIDs)
+      M_throw() << "The particles of the checkpoint " << fileName << " were numbered differently to the loaded configuration"
+		<< "\nThe particles must be renumbered (or not) in the same way as the run which wrote the checkpoint";
+
+    //The particles are restored now so that the Simulation is
+    //initialised with them, and again once it is initialised (see
+    //restoreCheckpoint).
+    _checkpointParticles = in.tell();
+    in.section("Particles");
+    in.readArray(particles.data(), particles.size());
+
+    dout << "Continuing from the checkpoint " << fileName << " at event " << eventCount << std::endl;
+  }
+
+  void
+  Simulation::restoreCheckpoint()
+  {
+    CheckpointReader& in = *_checkpoint;
+
+    //Initialising the plugins and neighbour lists may bring the
+    //particles up to date, which changes the rounding of their
+    //positions, so they are restored again
+    in.seek(_checkpointParticles);
+    in.section("Particles");
+    in.readArray(particles.data(), particles.size());
+
+    dynamics->loadCheckpoint(in);
+
+    in.section("BC");
+    BCs->loadCheckpoint(in);
+
+    for (const shared_ptr<Interaction>& ptr : interactions)
+      {
+	in.section(ptr->getName());
+	ptr->loadCheckpoint(in);
+      }
+
+    for (const shared_ptr<Local>& ptr : locals)
+      {
+	in.section(ptr->getName());
+	ptr->loadCheckpoint(in);
+      }
+
+    for (const shared_ptr<Global>& ptr : globals)
+      {
+	in.section(ptr->getName());
+	ptr->loadCheckpoint(in);
+      }
+
+    for (const shared_ptr<System>& ptr : systems)
+      {
+	in.section(ptr->getName());
+	ptr->loadCheckpoint(in);
+      }
+
+    ptrScheduler->loadCheckpoint(in);
+
+    in.section("State");
+    in.read(_nextPrint);
+    std::string rngState;
+    in.read(rngState);
+    std::istringstream(rngState) >> ranGenerator;
+
+    in.section("OutputPlugins");
+    uint64_t pluginCount;
+    in.read(pluginCount);
+    std::vector<std::string> pluginNames(pluginCount);
+    for (std::string& name : pluginNames)
+      in.read(name);
+
+    bool samePlugins = (pluginNames.size() == outputPlugins.size());
+    for (size_t i(0); samePlugins && (i < pluginNames.size()); ++i)
+      samePlugins = (pluginNames[i] == outputPlugins[i]->getPluginName());
+
+    if (samePlugins)
+      for (const shared_ptr<OutputPlugin>& ptr : outputPlugins)
+	{
+	  in.section(ptr->getPluginName());
+	  ptr->loadCheckpoint(in);
+	}
+    else
+      derr << "The output plugins differ from those of the run which wrote the checkpoint, so they begin new averages" << std::endl;
+
+    _checkpoint.reset();
+  }
+
   IntEvent 
   Simulation::getEvent(const Particle& p1, const Particle& p2) const
   {
-    for (const shared_ptr<Interaction>& ptr : interactions)
-      if (ptr->isInteraction(p1,p2))
-	return ptr->getEvent(p1,p2);
-    
-    M_throw() << "Could not find the right interaction to test for";
+    return interactions[getInteractionID(p1, p2)]->getEvent(p1, p2);
   }
 
   void 
@@ -234,16 +445,114 @@ namespace dynamo
   const shared_ptr<Interaction>&
   Simulation::getInteraction(const Particle& p1, const Particle& p2) const 
   {
-    for (const shared_ptr<Interaction>& ptr : interactions)
-      if (ptr->isInteraction(p1,p2))
-	return ptr;
+    return interactions[getInteractionID(p1, p2)];
+  }
+
+  size_t
+  Simulation::getInteractionID(const Particle& p1, const Particle& p2) const
+  {
+    if (!_classInteraction.empty())
+      {
+	const size_t tableID = _classInteraction[_particleClass[p1.getID()] * _classCount + _particleClass[p2.getID()]];
+	
+	//Only the irregular interactions before the tabulated one can take precedence
+	for (const size_t ID : _irregularInteractions)
+	  {
+	    if (ID > tableID) break;
+	    if (interactions[ID]->isInteraction(p1, p2)) return ID;
+	  }
+
+	if (tableID < interactions.size()) 
+	  {
+#ifdef DYNAMO_DEBUG
+	    for (size_t ID(0); ID < tableID; ++ID)
+	      if (interactions[ID]->isInteraction(p1, p2))
+		M_throw() << "The Interaction lookup table gave Interaction " << tableID << " for particles " << p1.getID() 
+			  << " and " << p2.getID() << ", but Interaction " << ID << " comes first";
+#endif
+	    return tableID;
+	  }
+      }
+    else
+      for (size_t ID(0); ID < interactions.size(); ++ID)
+	if (interactions[ID]->isInteraction(p1, p2))
+	  return ID;
   
     M_throw() << "Could not find an Interaction between particles " << p1.getID() << " and " << p2.getID() << ". All particle pairings must have a corresponding Interaction defined.";
   }
 
+  void
+  Simulation::buildDispatchTables()
+  {
+    _particleClass.clear();
+    _classInteraction.clear();
+    _irregularInteractions.clear();
+    _classCount = 0;
+
+    //Collect the IDRanges which decide the tabulated interactions
+    std::vector<const IDRange*> ranges;
+    std::vector<bool> tabulated(interactions.size());
+    for (size_t ID(0); ID < interactions.size(); ++ID)
+      {
+	std::vector<const IDRange*> interactionRanges;
+	tabulated[ID] = interactions[ID]->getRange()->getMembershipRanges(interactionRanges);
+	if (tabulated[ID])
+	  ranges.insert(ranges.end(), interactionRanges.begin(), interactionRanges.end());
+	else
+	  _irregularInteractions.push_back(ID);
+      }
+    std::sort(ranges.begin(), ranges.end());
+    ranges.erase(std::unique(ranges.begin(), ranges.end()), ranges.end());
+
+    //Split the particles into classes by their range memberships
+    const size_t maxClasses = 256;
+    std::map<std::vector<bool>, uint32_t> classIDs;
+    std::vector<size_t> representative;
+    _particleClass.resize(N);
+    std::vector<bool> membership(ranges.size());
+    for (const Particle& part : particles)
+      {
+	for (size_t r(0); r < ranges.size(); ++r)
+	  membership[r] = ranges[r]->isInRange(part);
+
+	auto it = classIDs.find(membership);
+	if (it == classIDs.end())
+	  {
+	    if (classIDs.size() == maxClasses)
+	      {
+		dout << "Over " << maxClasses << " classes of particles for the Interaction lookup, falling back to a search of the Interactions" << std::endl;
+		_particleClass.clear();
+		_irregularInteractions.clear();
+		return;
+	      }
+	    it = classIDs.insert(std::make_pair(membership, uint32_t(classIDs.size()))).first;
+	    representative.push_back(part.getID());
+	  }
+	_particleClass[part.getID()] = it->second;
+      }
+    
+    //Tabulate the first interaction for every pair of classes
+    _classCount = classIDs.size();
+    _classInteraction.resize(_classCount * _classCount, interactions.size());
+    for (size_t c1(0); c1 < _classCount; ++c1)
+      for (size_t c2(0); c2 < _classCount; ++c2)
+	for (size_t ID(0); ID < interactions.size(); ++ID)
+	  if (tabulated[ID] && interactions[ID]->isInteraction(particles[representative[c1]], particles[representative[c2]]))
+	    {
+	      _classInteraction[c1 * _classCount + c2] = ID;
+	      break;
+	    }
+
+    dout << "Interaction lookup table built for " << _classCount << " classes of particles, "
+	 << _irregularInteractions.size() << " Interactions are tested directly" << std::endl;
+  }
+
   const shared_ptr<Species>& 
   Simulation::SpeciesContainer::operator[](const Particle& p1) const 
   {
+    if (p1.getID() < _particleSpecies.size())
+      return Base::operator[](_particleSpecies[p1.getID()]);
+
     for (const shared_ptr<Species>& ptr : *this)
       if (ptr->isSpecies(p1)) return ptr;
     
@@ -251,6 +560,25 @@ namespace dynamo
 	      << p1.getID(); 
   }
 
+  void
+  Simulation::SpeciesContainer::buildLookup(const ParticleList& particles)
+  {
+    _particleSpecies.clear();
+    std::vector<uint32_t> lookup(particles.size());
+    for (const Particle& part : particles)
+      {
+	size_t ID(0);
+	while ((ID < size()) && !Base::operator[](ID)->isSpecies(part))
+	  ++ID;
+
+	if (ID == size())
+	  M_throw() << "Particle ID=" << part.getID() << " has no species";
+	
+	lookup[part.getID()] = ID;
+      }
+    _particleSpecies.swap(lookup);
+  }
+
   void Simulation::addSpecies(shared_ptr<Species> sp)
   {
     if (status >= INITIALISED)
@@ -285,6 +613,15 @@ namespace dynamo
     if (!boost::filesystem::exists(fileName))
       M_throw() << "Could not find the XML file named " << fileName
 		<< "\nPlease check the file exists.";
+
+    //Binary configurations are memory mapped, and only the XML header is parsed
+    std::unique_ptr<BinaryConfigReader> binaryConfig;
+    if (isBinaryConfigFile(fileName))
+      {
+	binaryConfig.reset(new BinaryConfigReader(fileName));
+	doc.getStoredXMLData() = binaryConfig->getXML();
+      }
+    else
     { //This scopes out the file objects
       
       //We use the boost iostreams library to load the file into a
@@ -390,7 +727,22 @@ namespace dynamo
 
     ptrScheduler = Scheduler::getClass(simNode.getNode("Scheduler"), this);
 
-    dynamics->loadParticleXMLData(mainNode);
+    if (binaryConfig)
+      {
+	const Node particleNode = mainNode.getNode("ParticleData");
+	if (!particleNode.hasAttribute("Format") || (particleNode.getAttribute("Format").getValue() != "Binary")
+	    || (particleNode.getAttribute("N").as<size_t>() != binaryConfig->getHeader().N))
+	  M_throw() << "The ParticleData of the binary configuration " << fileName << " does not match its header";
+
+	if (binaryConfig->getHeader().columns != _properties.getParticleColumnCount())
+	  M_throw() << "The binary configuration " << fileName << " has " << binaryConfig->getHeader().columns
+		    << " particle property columns but " << _properties.getParticleColumnCount() << " per-particle Properties";
+
+	dynamics->loadParticleBinaryData(*binaryConfig);
+	_properties.loadParticleBinaryData(*binaryConfig, N);
+      }
+    else
+      dynamics->loadParticleXMLData(mainNode);
   
     //Fixes or conversions once system is loaded
     lastRunMFT *= units.unitTime();
@@ -416,12 +768,20 @@ namespace dynamo
     namespace io = boost::iostreams;
     io::filtering_ostream coutputFile;
 
-    if (std::string(fileName.end()-4, fileName.end()) == ".bz2")
-      coutputFile.push(io::bzip2_compressor());
-  
-    coutputFile.push(io::file_sink(fileName));
+    //Binary configurations collect the XML header in memory, the
+    //file is written once the particle data is known.
+    const bool binary = isBinaryConfigFile(fileName);
+    std::ostringstream binaryXML;
+
+    if (!binary)
+      {
+	if (std::string(fileName.end()-4, fileName.end()) == ".bz2")
+	  coutputFile.push(io::bzip2_compressor());
+	
+	coutputFile.push(io::file_sink(fileName));
+      }
   
-    magnet::xml::XmlStream XML(coutputFile);
+    magnet::xml::XmlStream XML(binary ? static_cast<std::ostream&>(binaryXML) : static_cast<std::ostream&>(coutputFile));
     XML.setFormatXML(true);
 
     dynamics->updateAllParticles();
@@ -512,9 +872,35 @@ namespace dynamo
 	<< magnet::xml::endtag("Simulation")
 	<< _properties;
 
-    dynamics->outputParticleXMLData(XML, applyBC);
+    if (binary)
+      {
+	XML << magnet::xml::tag("ParticleData")
+	    << magnet::xml::attr("N") << N
+	    << magnet::xml::attr("Format") << "Binary";
+
+	if (dynamics->hasOrientationData())
+	  XML << magnet::xml::attr("OrientationData") << "Y";
+
+	XML << magnet::xml::endtag("ParticleData")
+	    << magnet::xml::endtag("DynamOconfig");
 
-    XML << magnet::xml::endtag("DynamOconfig");
+	std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+	if (!file)
+	  M_throw() << "Could not open " << fileName << " for writing";
+
+	BinaryConfigWriter writer(file, binaryXML.str(), N, _properties.getParticleColumnCount(), dynamics->hasOrientationData());
+	dynamics->outputParticleBinaryData(writer, applyBC);
+
+	std::vector<size_t> order(N);
+	for (size_t ID(0); ID < N; ++ID)
+	  order[ID] = getRenumberedID(ID);
+	_properties.outputParticleBinaryData(writer, order);
+      }
+    else
+      {
+	dynamics->outputParticleXMLData(XML, applyBC);
+	XML << magnet::xml::endtag("DynamOconfig");
+      }
 
     dout << "Config written to " << fileName << std::endl;
 
@@ -528,10 +914,130 @@ namespace dynamo
     _properties.rescaleUnit(Property::Units::M, 
 			    units.unitMass());
   }
+
+  namespace {
+    bool isAllOrNone(const shared_ptr<IDRange>& range)
+    { return std::dynamic_pointer_cast<IDRangeAll>(range) || std::dynamic_pointer_cast<IDRangeNone>(range); }
+
+    bool isAllOrNone(const shared_ptr<IDPairRange>& range)
+    { return std::dynamic_pointer_cast<IDPairRangeAll>(range) || std::dynamic_pointer_cast<IDPairRangeNone>(range); }
+  }
+
+  bool
+  Simulation::renumberParticles()
+  {
+    if (status != CONFIG_LOADED)
+      M_throw() << "The particles can only be renumbered after the configuration is loaded and before the simulation is initialised";
+
+    //Check that nothing in the configuration refers to particular
+    //particle IDs, as these would all have to be remapped.
+    std::string reason;
+    if (!topology.empty())
+      reason = "a Topology is defined";
+
+    for (const shared_ptr<Species>& ptr : species)
+      if (!isAllOrNone(ptr->getRange()))
+	reason = "the Species \"" + ptr->getName() + "\" does not apply to all particles";
+
+    for (const shared_ptr<Interaction>& ptr : interactions)
+      if (!isAllOrNone(ptr->getRange()))
+	reason = "the Interaction \"" + ptr->getName() + "\" does not apply to all particles";
+
+    for (const shared_ptr<Local>& ptr : locals)
+      if (!isAllOrNone(ptr->getRange()))
+	reason = "the Local \"" + ptr->getName() + "\" does not apply to all particles";
+
+    for (const shared_ptr<Global>& ptr : globals)
+      if (!isAllOrNone(ptr->getRange()))
+	reason = "the Global \"" + ptr->getName() + "\" does not apply to all particles";
+
+    for (const shared_ptr<System>& ptr : systems)
+      if (std::dynamic_pointer_cast<SysAndersen>(ptr) || std::dynamic_pointer_cast<SysDSMCSpheres>(ptr) 
+	  || std::dynamic_pointer_cast<SSleep>(ptr) || std::dynamic_pointer_cast<SysUmbrella>(ptr))
+	reason = "the System \"" + ptr->getName() + "\" acts on a range of particles";
+
+    if (!reason.empty())
+      {
+	dout << "Not renumbering the particles as " << reason << std::endl;
+	return false;
+      }
+
+    //Determine the bounding box of the (wrapped) particle positions
+    std::vector<Vector> positions(N);
+    Vector minpos(HUGE_VAL, HUGE_VAL, HUGE_VAL), maxpos(-HUGE_VAL, -HUGE_VAL, -HUGE_VAL);
+    for (size_t ID(0); ID < N; ++ID)
+      {
+	positions[ID] = particles[ID].getPosition();
+	BCs->applyBC(positions[ID]);
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  {
+	    minpos[iDim] = std::min(minpos[iDim], positions[ID][iDim]);
+	    maxpos[iDim] = std::max(maxpos[iDim], positions[ID][iDim]);
+	  }
+      }
+
+    //Bin the particles into a grid with roughly one particle per
+    //cell (limited by the range of the dilated integers) and sort
+    //them along the Morton curve through the cells.
+    const size_t maxCells = size_t(1) << std::numeric_limits<magnet::math::DilatedInteger<3> >::digits;
+    const size_t cellCount = std::max(size_t(1), std::min(maxCells, size_t(std::ceil(std::cbrt(double(N))))));
+
+    std::vector<std::pair<size_t, size_t> > keys(N);
+    for (size_t ID(0); ID < N; ++ID)
+      {
+	size_t coords[3];
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  {
+	    const double width = maxpos[iDim] - minpos[iDim];
+	    const double frac = (width > 0) ? (positions[ID][iDim] - minpos[iDim]) / width : 0;
+	    coords[iDim] = std::min(cellCount - 1, size_t(frac * cellCount));
+	  }
+	keys[ID] = std::make_pair(magnet::math::MortonNumber<3>(coords[0], coords[1], coords[2]).getMortonNum(), ID);
+      }
+    
+    std::sort(keys.begin(), keys.end());
+
+    //newIDs[oldID] gives the new ID of each particle
+    std::vector<size_t> newIDs(N);
+    for (size_t ID(0); ID < N; ++ID)
+      newIDs[keys[ID].second] = ID;
+
+    {
+      ParticleList newParticles(particles);
+      for (size_t ID(0); ID < N; ++ID)
+	{
+	  newParticles[newIDs[ID]] = particles[ID];
+	  newParticles[newIDs[ID]].setID(newIDs[ID]);
+	}
+      particles.swap(newParticles);
+    }
+
+    _properties.renumberParticles(newIDs);
+    dynamics->renumberParticles(newIDs);
+    for (shared_ptr<Interaction>& ptr : interactions)
+      ptr->renumberParticles(newIDs);
+
+    //Track the original IDs, composing with any earlier renumbering
+    std::vector<size_t> originalIDs(N);
+    for (size_t ID(0); ID < N; ++ID)
+      originalIDs[newIDs[ID]] = getOriginalID(ID);
+    _originalIDs.swap(originalIDs);
+
+    _renumberedIDs.resize(N);
+    for (size_t ID(0); ID < N; ++ID)
+      _renumberedIDs[_originalIDs[ID]] = ID;
+
+    dout << "Renumbered the particles along a " << cellCount << "^3 Morton curve" << std::endl;
+    return true;
+  }
   
   void 
   Simulation::replexerSwap(Simulation& other)
   {
+    //The buffered plugins must have seen all events before they are swapped
+    flushOutputEvents();
+    other.flushOutputEvents();
+
     //Get all particles up to date and zero the pecTimes
     dynamics->updateAllParticles();
     other.dynamics->updateAllParticles();
@@ -682,7 +1188,7 @@ namespace dynamo
   {
     dynamics->updateAllParticles();
 
-    std::vector<Particle>::const_iterator iPtr1, iPtr2;
+    ParticleList::const_iterator iPtr1, iPtr2;
   
     for (const shared_ptr<Interaction>& interaction_ptr : interactions)
       interaction_ptr->validateState();
@@ -716,6 +1222,8 @@ namespace dynamo
     XML << std::setprecision(std::numeric_limits<double>::digits10 + 2)
 	<< magnet::xml::prolog() << magnet::xml::tag("OutputData");
   
+    flushOutputEvents();
+
     //Output the data and delete the outputplugins
     for (shared_ptr<OutputPlugin> & Ptr : outputPlugins)
       Ptr->output(XML);
@@ -763,6 +1271,61 @@ namespace dynamo
     outputPlugins.push_back(tempPlug);
   }
 
+  void
+  Simulation::signalEvent(const IntEvent& event, const PairEventData& data)
+  {
+    EventProfiler::Phase phase(ptrScheduler ? ptrScheduler->getProfiler() : NULL, EventProfiler::OUTPUT);
+    for (const shared_ptr<OutputPlugin>& Ptr : outputPlugins)
+      if (!_outputBuffer || !Ptr->bufferedEvents())
+	Ptr->eventUpdate(event, data);
+
+    if (_outputBuffer)
+      _outputBuffer->push(event, data);
+  }
+
+  void
+  Simulation::signalEvent(const GlobalEvent& event, const NEventData& data)
+  {
+    EventProfiler::Phase phase(ptrScheduler ? ptrScheduler->getProfiler() : NULL, EventProfiler::OUTPUT);
+    for (const shared_ptr<OutputPlugin>& Ptr : outputPlugins)
+      if (!_outputBuffer || !Ptr->bufferedEvents())
+	Ptr->eventUpdate(event, data);
+
+    if (_outputBuffer)
+      _outputBuffer->push(event, data);
+  }
+
+  void
+  Simulation::signalEvent(const LocalEvent& event, const NEventData& data)
+  {
+    EventProfiler::Phase phase(ptrScheduler ? ptrScheduler->getProfiler() : NULL, EventProfiler::OUTPUT);
+    for (const shared_ptr<OutputPlugin>& Ptr : outputPlugins)
+      if (!_outputBuffer || !Ptr->bufferedEvents())
+	Ptr->eventUpdate(event, data);
+
+    if (_outputBuffer)
+      _outputBuffer->push(event, data);
+  }
+
+  void
+  Simulation::signalEvent(const System& event, const NEventData& data, const double& dt)
+  {
+    EventProfiler::Phase phase(ptrScheduler ? ptrScheduler->getProfiler() : NULL, EventProfiler::OUTPUT);
+    for (const shared_ptr<OutputPlugin>& Ptr : outputPlugins)
+      if (!_outputBuffer || !Ptr->bufferedEvents())
+	Ptr->eventUpdate(event, data, dt);
+
+    if (_outputBuffer)
+      _outputBuffer->push(event, data, dt);
+  }
+
+  void
+  Simulation::flushOutputEvents()
+  {
+    if (_outputBuffer)
+      _outputBuffer->flush();
+  }
+
   void 
   Simulation::simShutdown()
   { nextPrintEvent = endEventCount = eventCount; }
@@ -783,6 +1346,8 @@ namespace dynamo
 	if ((eventCount >= _nextPrint) && !silentMode && outputPlugins.size())
 	  {
 	    //Print the screen data plugins
+	    flushOutputEvents();
+
 	    for (shared_ptr<OutputPlugin> & Ptr : outputPlugins)
 	      Ptr->periodicOutput();
 	    
@@ -20,11 +20,14 @@
 #include <dynamo/particle.hpp>
 #include <dynamo/ensemble.hpp>
 #include <dynamo/property.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <dynamo/units/units.hpp>
 #include <magnet/function/delegate.hpp>
 #include <random>
 #include <vector>
 
+namespace magnet { namespace thread { class ThreadPool; } }
+
 namespace dynamo
 {  
   class Scheduler;
@@ -47,6 +50,7 @@ namespace dynamo
 
   class IDRange;
   class IDPairRange;
+  class OutputEventBuffer;
 
 
   //! \brief Holds the different phases of the simulation initialisation
@@ -103,6 +107,15 @@ namespace dynamo
       using Base::operator[];
 
       const shared_ptr<Species>& operator[](const Particle& p1) const;
+
+      /*! \brief Stores the Species of every particle, so that
+          operator[](const Particle&) does not have to search the
+          Species.
+      */
+      void buildLookup(const ParticleList& particles);
+
+      //! \brief The index of the Species of each particle (empty until buildLookup is called).
+      std::vector<uint32_t> _particleSpecies;
     };
 
   public:
@@ -128,6 +141,15 @@ namespace dynamo
 
     Container<Interaction> interactions;
     const shared_ptr<Interaction>& getInteraction(const Particle& p1, const Particle& p2) const;
+
+    /*! \brief Returns the index (in \ref interactions) of the
+        Interaction between two particles.
+
+	Once the Simulation is initialised this uses the tables built
+	by buildDispatchTables, otherwise the Interaction-s are
+	searched in order.
+    */
+    size_t getInteractionID(const Particle& p1, const Particle& p2) const;
     IntEvent getEvent(const Particle& p1, const Particle& p2) const;
     double getLongestInteraction() const;
 
@@ -211,8 +233,9 @@ namespace dynamo
     /*! \brief Loads a Simulation from the passed XML file.
 
       \param filename The path to the XML file to load. The filename
-     must end in either ".xml" for uncompressed xml files or ".bz2"
-     for bzip2 compressed configuration files.
+     must end in either ".xml" for uncompressed xml files, ".bz2"
+     for bzip2 compressed configuration files, or ".dynbin" for
+     binary configuration files (see \ref BinaryConfigHeader).
     */
     void loadXMLfile(std::string filename);
     
@@ -220,8 +243,9 @@ namespace dynamo
 
       \param filename The path to the XML file to write (this file
       will either be created or overwritten). The filename must end in
-      either ".xml" for uncompressed xml files or ".bz2" for bzip2
-      compressed configuration files.
+      either ".xml" for uncompressed xml files, ".bz2" for bzip2
+      compressed configuration files, or ".dynbin" for binary
+      configuration files (see \ref BinaryConfigHeader).
 
       \param round If true, the data in the XML file will be written
       out at 2 s.f. lower precision to round all the values. This is
@@ -230,6 +254,72 @@ namespace dynamo
     */
     void writeXMLfile(std::string filename, bool applyBC = true, bool round = false);
 
+    /*! \brief Writes the complete run-time state of the Simulation
+      to a checkpoint file (see \ref CheckpointHeader).
+
+      Along with the particles (exactly as stored, they are not
+      brought up to date) this holds the event lists of the
+      Scheduler, the contents of the neighbour lists, the state of
+      the Dynamics, Interaction-s, Local-s, Global-s and System-s, the
+      event count, the system time and the random number generator. A
+      run continued from the checkpoint (see loadCheckpoint) follows
+      exactly the same trajectory as if it had never stopped. The
+      accumulated results of the OutputPlugin-s are included, if
+      they support it (see OutputPlugin::saveCheckpoint), and are
+      restored if the continued run loads the same plugins.
+
+      Only the buffered OutputPlugin-s are brought up to date (see
+      flushOutputEvents), so this may be called at any point between
+      events. The file is replaced atomically.
+    */
+    void writeCheckpoint(std::string filename);
+
+    /*! \brief Continues the Simulation from a checkpoint written by
+      writeCheckpoint.
+
+      This must be called once the configuration is loaded and before
+      the Simulation is initialised. The configuration only provides
+      the structure of the Simulation (the species, interactions and
+      so on), which must match that of the simulation which wrote the
+      checkpoint. The run-time state is then restored during
+      initialise(), in place of validating the configuration and
+      rebuilding the event lists.
+    */
+    void loadCheckpoint(std::string filename);
+
+    /*! \brief Renumbers the particles so that their IDs follow a
+      Morton (Z-order) curve through the system.
+
+      Particles which are close in space are then close in memory,
+      which improves the cache hit rate of the neighbour sweeps. This
+      may only be called once the configuration is loaded but before
+      the Simulation is initialised. The particle data, per-particle
+      properties, orientation data and capture maps are all
+      remapped. The configuration is still written out in the
+      original order and with the original IDs (see \ref
+      getOriginalID).
+
+      Renumbering is skipped (and false is returned) if the
+      configuration refers to specific particle IDs, i.e., if it has a
+      Topology or any Species, Interaction, Local, Global or System
+      which does not apply to all (or none) of the particles.
+      
+      \return True if the particles were renumbered.
+    */
+    bool renumberParticles();
+
+    /*! \brief Returns the ID a particle had in the loaded
+        configuration (see \ref renumberParticles).
+     */
+    inline size_t getOriginalID(size_t ID) const
+    { return _originalIDs.empty() ? ID : _originalIDs[ID]; }
+
+    /*! \brief Returns the current ID of the particle which had the
+        passed ID in the loaded configuration.
+     */
+    inline size_t getRenumberedID(size_t originalID) const
+    { return _renumberedIDs.empty() ? originalID : _renumberedIDs[originalID]; }
+
     /*! \brief The Ensemble of the Simulation. */
     shared_ptr<Ensemble> ensemble;
 
@@ -267,6 +357,26 @@ namespace dynamo
      parsed. E.g., "Plugin:OptA=1,OptB=2"
     */
     void addOutputPlugin(std::string pluginDescriptor);
+
+    /*! \brief Passes the data of an event to the OutputPlugin-s.
+
+      This must be called by every event once it has been executed.
+      Plugins which support batched processing (see
+      OutputPlugin::bufferedEvents) receive the event later through
+      the OutputEventBuffer, the others are updated immediately.
+    */
+    void signalEvent(const IntEvent&, const PairEventData&);
+    void signalEvent(const GlobalEvent&, const NEventData&);
+    void signalEvent(const LocalEvent&, const NEventData&);
+    void signalEvent(const System&, const NEventData&, const double&);
+
+    /*! \brief Ensures the buffered OutputPlugin-s have processed all
+        events so far.
+
+      This must be called before the results of the plugins are used,
+      or the plugins are changed.
+    */
+    void flushOutputEvents();
   
     //! Sets the frequency of the SysTicker event.
     void setTickerPeriod(double);
@@ -299,7 +409,15 @@ namespace dynamo
     size_t N;
     
     /*! \brief The Particle's of the system. */
-    std::vector<Particle> particles;  
+    ParticleList particles;
+
+    /*! \brief The ID each particle had in the loaded configuration,
+        or empty if the particles have not been renumbered.
+     */
+    std::vector<size_t> _originalIDs;
+
+    //! \brief The inverse of \ref _originalIDs.
+    std::vector<size_t> _renumberedIDs;
     
     /*! \brief A ptr to the Scheduler of the system. */
     shared_ptr<Scheduler> ptrScheduler;
@@ -317,6 +435,27 @@ namespace dynamo
      */
     std::vector<shared_ptr<OutputPlugin> > outputPlugins; 
 
+    /*! \brief The number of events held for the buffered
+        OutputPlugin-s before they are processed (0 to disable
+        buffering).
+     */
+    size_t outputBufferSize;
+
+    /*! \brief If the buffered OutputPlugin-s are run on their own
+        thread.
+     */
+    bool threadedOutput;
+
+    /*! \brief The pool of worker threads given by --n-threads (or
+        NULL).
+
+	This is used to spread the expensive set up and sampling work
+	(e.g., building the event lists or sampling the radial
+	distribution function) over several threads. The pool may be
+	shared by several Simulation-s.
+     */
+    magnet::thread::ThreadPool* threads;
+
     /*! \brief The mean free time of the previous simulation run
      
       This is zero in the case that there is no previous simulation
@@ -357,6 +496,39 @@ namespace dynamo
 
   private:
     size_t _nextPrint;
+
+    //! \brief The checkpoint being restored during initialise (see loadCheckpoint).
+    shared_ptr<CheckpointReader> _checkpoint;
+    //! \brief The offset of the particle data in the checkpoint.
+    size_t _checkpointParticles;
+
+    //! \brief Restores the run-time state from the checkpoint, at the end of initialise.
+    void restoreCheckpoint();
+
+    //! \brief The buffer for batched OutputPlugin-s, if any are loaded.
+    shared_ptr<OutputEventBuffer> _outputBuffer;
+
+    /*! \brief Builds the tables used by getInteractionID.
+
+      The first Interaction in range of a pair is usually decided by
+      which IDRange-s (e.g., species) each particle is in. The
+      particles are split into classes with identical memberships of
+      all the IDRange-s used by these Interaction-s, and the first
+      matching Interaction is tabulated for each pair of classes. The
+      Interaction-s with ranges which depend on the particular pair
+      (e.g., chains or lists of pairs) are still tested directly, but
+      only those which come before the tabulated Interaction.
+     */
+    void buildDispatchTables();
+
+    //! \brief The class of each particle used in the Interaction table.
+    std::vector<uint32_t> _particleClass;
+    //! \brief The number of particle classes.
+    size_t _classCount;
+    //! \brief The first (tabulated) Interaction for each pair of classes, or interactions.size() for none.
+    std::vector<uint32_t> _classInteraction;
+    //! \brief The IDs of the Interaction-s which are tested directly, in order.
+    std::vector<size_t> _irregularInteractions;
   };
 
 }
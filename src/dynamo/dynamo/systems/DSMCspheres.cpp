@@ -89,8 +89,7 @@ namespace dynamo {
  
     size_t nmax = static_cast<size_t>(Event);
   
-    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(*this, NEventData(), locdt);
+    Sim->signalEvent(*this, NEventData(), locdt);
 
     if (uniform_sampler(Sim->ranGenerator) < fracpart)
       ++nmax;
@@ -126,13 +125,26 @@ namespace dynamo {
   
 	    Sim->ptrScheduler->fullUpdate(p1, p2);
 	  
-	    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-	      Ptr->eventUpdate(*this, SDat, 0.0);
+	    Sim->signalEvent(*this, SDat, 0.0);
 	  }
       }
 
   }
 
+  void
+  SysDSMCSpheres::saveCheckpoint(CheckpointWriter& out) const
+  {
+    System::saveCheckpoint(out);
+    out.write(maxprob);
+  }
+
+  void
+  SysDSMCSpheres::loadCheckpoint(CheckpointReader& in)
+  {
+    System::loadCheckpoint(in);
+    in.read(maxprob);
+  }
+
   void
   SysDSMCSpheres::initialise(size_t nID)
   {
@@ -111,8 +111,25 @@ namespace dynamo {
 
     Sim->ptrScheduler->fullUpdate(part);
   
-    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(*this, SDat, locdt);
+    Sim->signalEvent(*this, SDat, locdt);
+  }
+
+  void
+  SysAndersen::saveCheckpoint(CheckpointWriter& out) const
+  {
+    System::saveCheckpoint(out);
+    out.write(meanFreeTime);
+    out.write(eventCount);
+    out.write(lastlNColl);
+  }
+
+  void
+  SysAndersen::loadCheckpoint(CheckpointReader& in)
+  {
+    System::loadCheckpoint(in);
+    in.read(meanFreeTime);
+    in.read(eventCount);
+    in.read(lastlNColl);
   }
 
   void 
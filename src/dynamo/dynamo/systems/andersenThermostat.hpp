@@ -32,6 +32,9 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+    virtual void loadCheckpoint(CheckpointReader&);
+
     virtual void operator<<(const magnet::xml::Node&);
 
     double getTemperature() const { return Temp; }
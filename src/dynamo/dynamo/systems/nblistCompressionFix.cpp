@@ -102,8 +102,7 @@ namespace dynamo {
 
     (*Sim->_sigParticleUpdate)(SDat);
     
-    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(*this, SDat, locdt); 
+    Sim->signalEvent(*this, SDat, locdt);
   }
 
   void 
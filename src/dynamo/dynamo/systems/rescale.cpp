@@ -50,6 +50,7 @@ namespace dynamo {
     System(tmp),
     _frequency(frequency),
     _kT(kT),
+    _timestep(HUGE_VAL),
     scaleFactor(0),
     LastTime(0),
     RealTime(0)
@@ -87,6 +88,10 @@ namespace dynamo {
     double currentkT(Sim->dynamics->getkT()
 		     / Sim->units.unitEnergy());
 
+    //The factor the kinetic energy is scaled by (_kT is in
+    //simulation units)
+    const double scale = _kT / Sim->dynamics->getkT();
+
     dout << "Rescaling kT " << currentkT 
 	 << " To " << _kT / Sim->units.unitEnergy() <<  std::endl;
 
@@ -97,29 +102,42 @@ namespace dynamo {
       SDat.L1partChanges.push_back(ParticleEventData(Sim->particles[partID], *species, RESCALE));
 
     Sim->dynamics->updateAllParticles();
-    Sim->dynamics->rescaleSystemKineticEnergy(_kT / currentkT);
+    Sim->dynamics->rescaleSystemKineticEnergy(scale);
 
     RealTime += (Sim->systemTime - LastTime) / std::exp(0.5 * scaleFactor);
     
     LastTime = Sim->systemTime;
 
-    scaleFactor += std::log(currentkT);
+    scaleFactor -= std::log(scale);
 
     (*Sim->_sigParticleUpdate)(SDat);
   
-    //Only 1ParticleEvents occur
-    for (const ParticleEventData& PDat : SDat.L1partChanges)
-      Sim->ptrScheduler->fullUpdate(Sim->particles[PDat.getParticleID()]);
-  
-    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(*this, SDat, locdt); 
-
-    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-      Ptr->temperatureRescale(1.0/currentkT);
+    //The output plugins see the change in the kinetic energy through
+    //the particle changes of the event, so temperatureRescale is
+    //not called
+    Sim->signalEvent(*this, SDat, locdt);
 
     dt = _timestep;
   
-    Sim->ptrScheduler->rebuildList();
+    Sim->ptrScheduler->velocitiesRescaled(std::sqrt(scale));
+  }
+
+  void
+  SysRescale::saveCheckpoint(CheckpointWriter& out) const
+  {
+    System::saveCheckpoint(out);
+    out.write(scaleFactor);
+    out.write(LastTime);
+    out.write(RealTime);
+  }
+
+  void
+  SysRescale::loadCheckpoint(CheckpointReader& in)
+  {
+    System::loadCheckpoint(in);
+    in.read(scaleFactor);
+    in.read(LastTime);
+    in.read(RealTime);
   }
 
   void 
@@ -40,6 +40,9 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+    virtual void loadCheckpoint(CheckpointReader&);
+
     virtual void operator<<(const magnet::xml::Node&);
 
     void checker(const NEventData&);
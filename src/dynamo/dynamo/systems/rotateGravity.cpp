@@ -76,13 +76,11 @@ namespace dynamo {
     Vector newg = magnet::math::Quaternion::fromAngleAxis(_angularvel * _timestep, _rotationaxis) *  dynamics->getGravityVector();
     dynamics->setGravityVector(newg.normal() * g);
 
-    for (const ParticleEventData& PDat : SDat.L1partChanges)
-      Sim->ptrScheduler->fullUpdate(Sim->particles[PDat.getParticleID()]);
-  
-    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(*this, SDat, locdt); 
+    Sim->signalEvent(*this, SDat, locdt);
 
     dt = _timestep;
+    //Every trajectory is changed, so all events are rebuilt (there
+    //is no need to update the particles individually first)
     Sim->ptrScheduler->rebuildList();
   }
 
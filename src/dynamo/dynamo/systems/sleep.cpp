@@ -27,6 +27,7 @@
 #include <dynamo/dynamics/gravity.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 #include <boost/lexical_cast.hpp>
@@ -53,6 +54,49 @@ namespace dynamo {
     type = SLEEP;
   }
 
+  void
+  SSleep::saveCheckpoint(CheckpointWriter& out) const
+  {
+    System::saveCheckpoint(out);
+
+    out.write(uint64_t(stateChange.size()));
+    for (const auto& change : stateChange)
+      {
+	out.write(change.first);
+	out.write(change.second);
+      }
+
+    for (const auto& data : _lastData)
+      {
+	out.write(data.first);
+	out.write(data.second);
+      }
+  }
+
+  void
+  SSleep::loadCheckpoint(CheckpointReader& in)
+  {
+    System::loadCheckpoint(in);
+
+    uint64_t changes;
+    in.read(changes);
+    stateChange.clear();
+    for (uint64_t i(0); i < changes; ++i)
+      {
+	size_t id;
+	in.read(id);
+	in.read(stateChange[id]);
+      }
+    type = (stateChange.empty()) ? NONE : SLEEP;
+
+    //initialise has sized _lastData
+    for (auto& data : _lastData)
+      {
+	in.read(data.first);
+	in.read(data.second);
+      }
+  }
+
   void
   SSleep::initialise(size_t nID)
   {
@@ -77,7 +121,7 @@ namespace dynamo {
     _sleepVelocity = XML.getAttribute("SleepV").as<double>() * Sim->units.unitVelocity();
     _sleepDistance = Sim->units.unitLength() * 0.01;
     _sleepTime = Sim->units.unitTime() * 0.0001;
-    _range = shared_ptr<IDRange>(IDRange::getClass(XML, Sim));
+    _range = shared_ptr<IDRange>(IDRange::getClass(XML.getNode("IDRange"), Sim));
   }
 
   void 
@@ -300,7 +344,6 @@ namespace dynamo {
     for (const ParticleEventData& PDat : SDat.L1partChanges)
       Sim->ptrScheduler->fullUpdate(Sim->particles[PDat.getParticleID()]);
     
-    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(*this, SDat, locdt); 
+    Sim->signalEvent(*this, SDat, locdt);
   }
 }
@@ -35,6 +35,10 @@ namespace dynamo {
 
     virtual void initialise(size_t);
 
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+
+    virtual void loadCheckpoint(CheckpointReader&);
+
     virtual void operator<<(const magnet::xml::Node&);
 
   protected:
@@ -71,8 +71,7 @@ namespace dynamo {
     //This is done here as most ticker properties require it
     Sim->dynamics->updateAllParticles();
 
-    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(*this, NEventData(), locdt);
+    Sim->signalEvent(*this, NEventData(), locdt);
   
     std::string filename = magnet::string::search_replace("Snapshot."+_format+".xml.bz2", "%COUNT", boost::lexical_cast<std::string>(_saveCounter));
     filename = magnet::string::search_replace(filename, "%ID", boost::lexical_cast<std::string>(Sim->simID));
@@ -85,6 +84,20 @@ namespace dynamo {
     Sim->outputData(filename);
   }
 
+  void
+  SSnapshot::saveCheckpoint(CheckpointWriter& out) const
+  {
+    System::saveCheckpoint(out);
+    out.write(_saveCounter);
+  }
+
+  void
+  SSnapshot::loadCheckpoint(CheckpointReader& in)
+  {
+    System::loadCheckpoint(in);
+    in.read(_saveCounter);
+  }
+
   void 
   SSnapshot::initialise(size_t nID)
   { ID = nID; }
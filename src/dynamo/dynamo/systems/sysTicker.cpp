@@ -72,14 +72,27 @@ namespace dynamo {
 	if (ptr) ptr->ticker();
       }
 
-    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(*this, NEventData(), locdt);
+    Sim->signalEvent(*this, NEventData(), locdt);
   }
 
   void 
   SysTicker::initialise(size_t nID)
   { ID = nID; }
 
+  void
+  SysTicker::saveCheckpoint(CheckpointWriter& out) const
+  {
+    System::saveCheckpoint(out);
+    out.write(period);
+  }
+
+  void
+  SysTicker::loadCheckpoint(CheckpointReader& in)
+  {
+    System::loadCheckpoint(in);
+    in.read(period);
+  }
+
   void 
   SysTicker::setdt(double ndt)
   { 
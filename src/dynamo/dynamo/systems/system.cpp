@@ -28,6 +28,7 @@
 #include <dynamo/globals/globEvent.hpp>
 #include <dynamo/ranges/IDRangeAll.hpp>
 #include <magnet/xmlwriter.hpp>
+#include <dynamo/checkpoint.hpp>
 #include <magnet/xmlreader.hpp>
 #include <cstring>
 
@@ -51,6 +52,18 @@ namespace dynamo {
   }
 
 
+  void
+  System::saveCheckpoint(CheckpointWriter& out) const
+  {
+    out.write(dt);
+  }
+
+  void
+  System::loadCheckpoint(CheckpointReader& in)
+  {
+    in.read(dt);
+  }
+
   System::System(dynamo::Simulation* tmp):
     SimBase(tmp, "SystemInteraction"),
     dt(HUGE_VAL)
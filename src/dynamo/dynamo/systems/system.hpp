@@ -21,6 +21,8 @@
 
 namespace magnet { namespace xml { class Node; class XmlStream; } }
 namespace dynamo {
+  class CheckpointWriter;
+  class CheckpointReader;
   class IntEvent;
   class GlobalEvent;
   class NEventData;
@@ -38,6 +40,15 @@ namespace dynamo {
 
     virtual void initialise(size_t) = 0;
 
+    /*! \brief Writes the time of the next event of the System, and
+        any other run-time state of derived classes, to a checkpoint
+        (see Simulation::writeCheckpoint).
+     */
+    virtual void saveCheckpoint(CheckpointWriter&) const;
+
+    //! \brief Restores the state written by saveCheckpoint, after initialise is called.
+    virtual void loadCheckpoint(CheckpointReader&);
+
     virtual void operator<<(const magnet::xml::Node&) = 0;
 
     bool operator<(const IntEvent&) const;
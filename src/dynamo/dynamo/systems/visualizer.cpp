@@ -94,8 +94,7 @@ namespace dynamo {
     if (_window->dynamoParticleSync())
       Sim->dynamics->updateAllParticles();
 
-    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(*this, NEventData(), dt);
+    Sim->signalEvent(*this, NEventData(), dt);
   
     for (shared_ptr<System>& system : Sim->systems)
       {
@@ -0,0 +1,333 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*! \file dynabench.cpp
+
+  \brief Times the event loop on a fixed set of canonical systems,
+  generated by the IPPacker modes.
+
+  Each workload is packed with a fixed random seed, equilibrated for a
+  number of warm-up events and then run for a fixed number of events.
+  Every run takes place in its own child process, so that the peak
+  resident set size reported is that of the workload alone. The
+  results are written as a whitespace separated table (comment lines
+  start with #) for comparison between builds.
+ */
+
+#include <dynamo/simulation.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/schedulers/profiler.hpp>
+#include <magnet/memUsage.hpp>
+#include <magnet/exception.hpp>
+#include <boost/program_options.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+using namespace dynamo;
+namespace po = boost::program_options;
+
+namespace {
+  struct Workload
+  {
+    const char* name;
+    const char* description;
+    //! \brief The packer options, the number of cells is appended.
+    const char* packerArgs;
+  };
+
+  const Workload workloads[] =
+    {
+      {"hs-dilute", "Hard spheres at a density of 0.1", "-m 0 -d 0.1"},
+      {"hs-dense", "Hard spheres at a density of 0.9", "-m 0 -d 0.9"},
+      {"sw-fluid", "Square-well fluid (lambda=1.5) at a density of 0.5", "-m 1 -d 0.5"},
+      {"polymer", "Hard spheres mixed with stiff ISquareBond chains of 10 monomers", "-m 14 -d 0.5"},
+      {"lebc-shear", "Hard spheres under Lees-Edwards shear at a density of 0.5", "-m 4 -d 0.5"},
+      {"gravity", "Hard spheres falling onto a plate under gravity (with the ParabolaSentinel)", "-m 22 -d 0.5"}
+    };
+
+  const size_t workloadCount = sizeof(workloads) / sizeof(workloads[0]);
+
+  //! \brief The measurements of a single run, passed back from the child process.
+  struct Result
+  {
+    size_t N;
+    size_t events;
+    double seconds;
+    double peakRSS;
+    double phaseFraction[EventProfiler::PHASE_COUNT];
+  };
+
+  Result runWorkload(const Workload& workload, size_t cells, size_t warmup, size_t events, unsigned int seed)
+  {
+    std::vector<std::string> args;
+    std::istringstream packerArgs(workload.packerArgs);
+    for (std::string arg; packerArgs >> arg;)
+      args.push_back(arg);
+    args.push_back("-C");
+    args.push_back(boost::lexical_cast<std::string>(cells));
+
+    po::options_description opts;
+    opts.add(IPPacker::getOptions());
+    opts.add(IPPacker::getHiddenOptions());
+    po::variables_map vm;
+    po::store(po::command_line_parser(args).options(opts).run(), vm);
+    po::notify(vm);
+
+    Simulation sim;
+    sim.ranGenerator.seed(seed);
+
+    IPPacker packer(vm, &sim);
+    packer.initialise();
+    InputPlugin(&sim, "Rescaler").zeroMomentum();
+    InputPlugin(&sim, "Rescaler").rescaleVels(1.0);
+
+    sim.status = CONFIG_LOADED;
+    sim.endEventCount = warmup;
+    sim.initialise();
+
+    if (warmup)
+      sim.runSimulation(true);
+
+    EventProfiler profiler;
+    sim.ptrScheduler->setProfiler(&profiler);
+    sim.endEventCount = sim.eventCount + events;
+    const size_t startEvents = sim.eventCount;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    sim.runSimulation(true);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    sim.ptrScheduler->setProfiler(NULL);
+
+    Result result;
+    result.N = sim.N;
+    result.events = sim.eventCount - startEvents;
+    result.seconds = elapsed.count();
+    result.peakRSS = magnet::process_mem_usage();
+
+    uint64_t cycles[EventProfiler::PHASE_COUNT] = {0};
+    uint64_t totalCycles(0);
+    typedef std::pair<const EventProfiler::EventKey, EventProfiler::Counters> Entry;
+    for (const Entry& entry : profiler.getCounters())
+      for (size_t i(0); i < EventProfiler::PHASE_COUNT; ++i)
+	{
+	  cycles[i] += entry.second.cycles[i];
+	  totalCycles += entry.second.cycles[i];
+	}
+
+    for (size_t i(0); i < EventProfiler::PHASE_COUNT; ++i)
+      result.phaseFraction[i] = double(cycles[i]) / std::max(totalCycles, uint64_t(1));
+
+    return result;
+  }
+
+  /*! \brief Runs a workload in a child process and reads back its
+      Result.
+   */
+  Result forkWorkload(const Workload& workload, size_t cells, size_t warmup, size_t events, unsigned int seed, bool verbose)
+  {
+    int fds[2];
+    if (pipe(fds))
+      M_throw() << "Failed to create a pipe for the benchmark process";
+
+    std::cout.flush();
+    std::cerr.flush();
+
+    const pid_t pid = fork();
+    if (pid < 0)
+      M_throw() << "Failed to fork the benchmark process";
+
+    if (pid == 0)
+      {
+	close(fds[0]);
+	if (!verbose)
+	  {
+	    const int devnull = open("/dev/null", O_WRONLY);
+	    if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+	  }
+
+	int status = 0;
+	try {
+	  const Result result = runWorkload(workload, cells, warmup, events, seed);
+	  if (write(fds[1], &result, sizeof(result)) != ssize_t(sizeof(result)))
+	    status = 1;
+	} catch (std::exception& err) {
+	  std::cerr << "Workload " << workload.name << " failed:\n" << err.what() << std::endl;
+	  status = 1;
+	}
+	std::cout.flush();
+	close(fds[1]);
+	_exit(status);
+      }
+
+    close(fds[1]);
+    Result result;
+    const ssize_t bytes = read(fds[0], &result, sizeof(result));
+    close(fds[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+    if ((bytes != ssize_t(sizeof(result))) || !WIFEXITED(status) || WEXITSTATUS(status))
+      M_throw() << "The benchmark of the " << workload.name << " workload failed";
+
+    return result;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  po::options_description opts("Options");
+  opts.add_options()
+    ("help,h", "Produces this message")
+    ("list,l", "Lists the available workloads")
+    ("workload,w", po::value<std::vector<std::string> >(), "A workload to run (may be given multiple times). Defaults to all workloads.")
+    ("NCells,C", po::value<size_t>()->default_value(10), "The number of unit cells in each dimension of the packed systems.")
+    ("events,c", po::value<size_t>()->default_value(1000000), "The number of events timed for each workload.")
+    ("warmup", po::value<size_t>()->default_value(100000), "The number of events run before the timing starts.")
+    ("repeats,r", po::value<size_t>()->default_value(1), "The number of times each workload is run, the fastest run is reported.")
+    ("random-seed,s", po::value<unsigned int>()->default_value(1), "Seed value for the random number generator.")
+    ("out-file,o", po::value<std::string>(), "Also write the results table to this file.")
+    ("verbose,v", "Show the output of the simulations.")
+    ;
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(opts).run(), vm);
+  po::notify(vm);
+
+  if (vm.count("help"))
+    {
+      std::cout << "Usage : dynabench <OPTIONS>...\n"
+		<< "Times the event loop on a set of canonical systems, generated\n"
+		<< "by the packer modes of dynamod, and reports the event rate,\n"
+		<< "peak memory use and the time spent in each phase of the event\n"
+		<< "loop.\n"
+		<< opts << std::endl;
+      return 1;
+    }
+
+  if (vm.count("list"))
+    {
+      for (const Workload& workload : workloads)
+	std::cout << std::setw(12) << std::left << workload.name
+		  << workload.description << " (dynamod " << workload.packerArgs << ")\n";
+      return 0;
+    }
+
+  try {
+    std::vector<const Workload*> selected;
+    if (vm.count("workload"))
+      for (const std::string& name : vm["workload"].as<std::vector<std::string> >())
+	{
+	  const Workload* found = NULL;
+	  for (const Workload& workload : workloads)
+	    if (name == workload.name)
+	      found = &workload;
+
+	  if (!found)
+	    M_throw() << "Unknown workload \"" << name << "\", use --list to see the available workloads";
+
+	  selected.push_back(found);
+	}
+    else
+      for (size_t i(0); i < workloadCount; ++i)
+	selected.push_back(&workloads[i]);
+
+    const size_t cells = vm["NCells"].as<size_t>();
+    const size_t events = vm["events"].as<size_t>();
+    const size_t warmup = vm["warmup"].as<size_t>();
+    const unsigned int seed = vm["random-seed"].as<unsigned int>();
+
+    std::ostringstream table;
+    table << "# dynabench NCells=" << cells << " Events=" << events
+	  << " Warmup=" << warmup << " Repeats=" << vm["repeats"].as<size_t>()
+	  << " Seed=" << seed << "\n"
+	  << "# The phase columns are the mean nanoseconds per event spent in each phase of the event loop\n"
+	  << "# Workload N Events Seconds EventsPerSec NsPerEvent PeakRSSkB";
+    for (size_t i(0); i < EventProfiler::PHASE_COUNT; ++i)
+      table << " " << EventProfiler::getPhaseName(i);
+    table << "\n";
+
+    for (const Workload* workload : selected)
+      {
+	std::cerr << "Running the " << workload->name << " workload" << std::endl;
+
+	//A failed repeat is reported and skipped, the fastest of the
+	//successful repeats is reported
+	Result best{};
+	size_t successes(0);
+	double peakRSS(0);
+	for (size_t i(0); i < std::max(vm["repeats"].as<size_t>(), size_t(1)); ++i)
+	  {
+	    Result result;
+	    try {
+	      result = forkWorkload(*workload, cells, warmup, events, seed, vm.count("verbose"));
+	    } catch (std::exception& err) {
+	      std::cerr << "Repeat " << i + 1 << " of the " << workload->name << " workload failed:\n" << err.what() << std::endl;
+	      continue;
+	    }
+
+	    peakRSS = std::max(peakRSS, result.peakRSS);
+	    if (!successes || (result.seconds < best.seconds))
+	      best = result;
+	    ++successes;
+	  }
+
+	if (!successes)
+	  M_throw() << "Every repeat of the " << workload->name << " workload failed";
+
+	const double nsPerEvent = best.seconds * 1e9 / std::max(best.events, size_t(1));
+	table << workload->name
+	      << " " << best.N
+	      << " " << best.events
+	      << " " << best.seconds
+	      << " " << best.events / best.seconds
+	      << " " << nsPerEvent
+	      << " " << peakRSS;
+	for (size_t i(0); i < EventProfiler::PHASE_COUNT; ++i)
+	  table << " " << best.phaseFraction[i] * nsPerEvent;
+	table << "\n";
+      }
+
+    std::cout << table.str() << std::flush;
+
+    if (vm.count("out-file"))
+      {
+	std::ofstream file(vm["out-file"].as<std::string>().c_str());
+	if (!file)
+	  M_throw() << "Could not open the output file " << vm["out-file"].as<std::string>();
+	file << table.str();
+      }
+  } catch (std::exception& err) {
+    std::cerr << "\nReached Main Error Loop"
+	      << "\nError=" << err.what()
+	      << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
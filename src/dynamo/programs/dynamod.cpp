@@ -42,12 +42,11 @@ main(int argc, char *argv[])
   try 
     {
       po::options_description allopts("General Options"), loadopts("Load Config File Options"),
-	hiddenopts,
 	helpOpts;
 
       allopts.add_options()
 	("help,h", "Produces this message OR if --pack-mode/-m is set, it lists the specific options available for that packer mode.")
-	("out-config-file,o", po::value<string>()->default_value("config.out.xml.bz2"), "Configuration output file.")
+	("out-config-file,o", po::value<string>()->default_value("config.out.xml.bz2"), "Configuration output file (.xml, .xml.bz2 or the binary .dynbin format).")
 	("random-seed,s", po::value<unsigned int>(), "Seed value for the random number generator.")
 	("rescale-T,r", po::value<double>(), "Rescales the kinetic temperature of the input/generated config to this value.")
 	("thermostat,T", po::value<double>(), "Change the thermostat temperature (will add a thermostat and set the Ensemble to NVT if needed).")
@@ -72,38 +71,7 @@ main(int argc, char *argv[])
       allopts.add(loadopts);
       allopts.add(dynamo::IPPacker::getOptions());
       
-      hiddenopts.add_options()
-	("b1", "boolean option one.")
-	("b2", "boolean option two.")
-	("i1", po::value<size_t>(), "integer option one.")
-	("i2", po::value<size_t>(), "integer option two.")
-	("s1", po::value<std::string>(), "string option one.")
-	("s2", po::value<std::string>(), "string option two.")
-	("f1", po::value<double>(), "double option one.")
-	("f2", po::value<double>(), "double option two.")
-	("f3", po::value<double>(), "double option three.")
-	("f4", po::value<double>(), "double option four.")
-	("f5", po::value<double>(), "double option five.")
-	("f6", po::value<double>(), "double option six.")
-	("f7", po::value<double>(), "double option seven.")
-	("f8", po::value<double>(), "double option eight.")
-	("f9", po::value<double>(), "double option nine.")
-	("f10", po::value<double>(), "double option ten.")
-	("NCells,C", po::value<unsigned long>()->default_value(7),
-	 "Default number of unit cells per dimension, used for crystal packing of particles.")
-	("xcell,x", po::value<unsigned long>(),
-	 "Number of unit cells in the x dimension.")
-	("ycell,y", po::value<unsigned long>(),
-	 "Number of unit cells in the y dimension.")
-	("zcell,z", po::value<unsigned long>(),
-	 "Number of unit cells in the z dimension.")
-	("rectangular-box", "Force the simulation box to be deformed so "
-	 "that the x,y,z cells also specify the box aspect ratio.")
-	("density,d", po::value<double>()->default_value(0.5),
-	 "System number density.")
-	;
-
-      allopts.add(hiddenopts);
+      allopts.add(dynamo::IPPacker::getHiddenOptions());
 
       po::positional_options_description p;
       p.add("config-file", 1);
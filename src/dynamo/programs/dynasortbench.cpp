@@ -0,0 +1,118 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*! \file dynasortbench.cpp
+
+  \brief Replays a sorter trace (recorded by dynarun with the
+  --sorter-trace option) into each type of sorter and reports how long
+  each one takes.
+ */
+
+#include <dynamo/schedulers/sorters/include.hpp>
+#include <dynamo/schedulers/sorters/trace.hpp>
+#include <magnet/exception.hpp>
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <limits>
+
+using namespace dynamo;
+
+int main(int argc, char *argv[])
+{
+  namespace po = boost::program_options;
+
+  const char* defaultSorters[] =
+    {"CBT", "CBTMinMax3", "CBTDHeap4", "CBTDHeap8", "CBTSingleEvent",
+     "BoundedPQ", "BoundedPQMinMax3", "BoundedPQDHeap4", "BoundedPQDHeap8", "BoundedPQSingleEvent",
+     "CalendarQueue", "CalendarQueueMinMax3", "CalendarQueueDHeap4", "CalendarQueueDHeap8", "CalendarQueueSingleEvent"};
+
+  po::options_description opts("Options");
+  opts.add_options()
+    ("help,h", "Produces this message")
+    ("trace-file", po::value<std::string>(), "The sorter trace to replay")
+    ("sorter,S", po::value<std::vector<std::string> >(), "A sorter type to benchmark (may be given multiple times). Defaults to all types.")
+    ("repeats,r", po::value<size_t>()->default_value(3), "The number of times each trace is replayed, the fastest time is reported.")
+    ;
+
+  po::positional_options_description p;
+  p.add("trace-file", 1);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(opts).positional(p).run(), vm);
+  po::notify(vm);
+
+  if (vm.count("help") || !vm.count("trace-file"))
+    {
+      std::cout << "Usage : dynasortbench <OPTIONS>...[TRACE FILE]\n"
+		<< "Replays a sorter trace, recorded by dynarun --sorter-trace, into\n"
+		<< "each type of sorter to find the fastest for that simulation.\n"
+		<< "Sorters that store fewer events per particle than the one used\n"
+		<< "to record the trace (e.g., the SingleEvent sorters) cannot follow\n"
+		<< "it, and will report mismatched events.\n"
+		<< opts << std::endl;
+      return 1;
+    }
+
+  try {
+    std::ifstream file(vm["trace-file"].as<std::string>().c_str(), std::ios::binary);
+    if (!file)
+      M_throw() << "Could not open the trace file " << vm["trace-file"].as<std::string>();
+
+    const std::vector<SorterTraceRecord> trace = loadSorterTrace(file);
+    std::cout << "Loaded " << trace.size() << " sorter operations" << std::endl;
+
+    std::vector<std::string> sorters(defaultSorters, defaultSorters + sizeof(defaultSorters) / sizeof(defaultSorters[0]));
+    if (vm.count("sorter"))
+      sorters = vm["sorter"].as<std::vector<std::string> >();
+
+    std::cout << std::setw(26) << std::left << "Sorter"
+	      << std::setw(14) << "Time (s)"
+	      << std::setw(14) << "ns/operation"
+	      << "Mismatched events" << std::endl;
+
+    for (const std::string& type : sorters)
+      {
+	double best = std::numeric_limits<double>::max();
+	size_t mismatches(0);
+	for (size_t i(0); i < vm["repeats"].as<size_t>(); ++i)
+	  {
+	    shared_ptr<FEL> sorter = FEL::getClass(type);
+	    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	    mismatches = replaySorterTrace(trace, *sorter);
+	    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	    best = std::min(best, elapsed.count());
+	  }
+
+	std::cout << std::setw(26) << std::left << type
+		  << std::setw(14) << best
+		  << std::setw(14) << best * 1e9 / std::max(trace.size(), size_t(1))
+		  << mismatches << std::endl;
+      }
+  } catch (std::exception& err) {
+    std::cerr << "\nReached Main Error Loop"
+	      << "\nError=" << err.what()
+	      << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
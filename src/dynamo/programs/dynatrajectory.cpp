@@ -0,0 +1,135 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*! \file dynatrajectory.cpp
+
+  \brief Converts an event log (recorded by the Trajectory output
+  plugin) to text, one line per record.
+ */
+
+#include <dynamo/eventlog.hpp>
+#include <dynamo/eventtypes.hpp>
+#include <magnet/exception.hpp>
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <fstream>
+#include <limits>
+#include <string>
+
+using namespace dynamo;
+
+namespace {
+  void printType(std::ostream& os, uint32_t type)
+  {
+    if (type < FINAL_ENUM_TO_CATCH_THE_COMMA)
+      os << EEventType(type);
+    else
+      os << "UNKNOWN(" << type << ")";
+  }
+
+  void printParticle(std::ostream& os, uint32_t id)
+  {
+    if (id == eventLogNoParticle)
+      os << "-";
+    else
+      os << id;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  namespace po = boost::program_options;
+
+  po::options_description opts("Options");
+  opts.add_options()
+    ("help,h", "Produces this message")
+    ("log-file", po::value<std::string>(), "The event log to convert")
+    ("out-file,o", po::value<std::string>(), "The file to write the text to (defaults to the standard output)")
+    ("particle,p", po::value<size_t>(), "Only output the records which involve this particle")
+    ("start-time", po::value<double>(), "Only output the records at or after this time")
+    ("end-time", po::value<double>(), "Only output the records at or before this time")
+    ;
+
+  po::positional_options_description p;
+  p.add("log-file", 1);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(opts).positional(p).run(), vm);
+  po::notify(vm);
+
+  if (vm.count("help") || !vm.count("log-file"))
+    {
+      std::cout << "Usage : dynatrajectory <OPTIONS>...[LOG FILE]\n"
+		<< "Converts an event log, recorded by the Trajectory output plugin,\n"
+		<< "to text. Each line is a change to one particle (or a pair of\n"
+		<< "particles) by an event, in the columns given by the first line.\n"
+		<< opts << std::endl;
+      return 1;
+    }
+
+  try {
+    EventLogReader reader(vm["log-file"].as<std::string>());
+
+    std::ofstream outFile;
+    if (vm.count("out-file"))
+      {
+	outFile.open(vm["out-file"].as<std::string>().c_str());
+	if (!outFile)
+	  M_throw() << "Could not open " << vm["out-file"].as<std::string>() << " for writing";
+      }
+    std::ostream& out = vm.count("out-file") ? outFile : std::cout;
+    out.precision(std::numeric_limits<double>::max_digits10);
+
+    const bool filterParticle = vm.count("particle");
+    const uint32_t particle = filterParticle ? vm["particle"].as<size_t>() : 0;
+    const double startTime = vm.count("start-time") ? vm["start-time"].as<double>() : -std::numeric_limits<double>::infinity();
+    const double endTime = vm.count("end-time") ? vm["end-time"].as<double>() : std::numeric_limits<double>::infinity();
+
+    out << "# event time source sourceID type p1 p2 deltaPx deltaPy deltaPz deltaKE deltaU\n";
+
+    EventLogRecord record;
+    while (reader.next(record))
+      {
+	if (filterParticle && (record.particle1 != particle) && (record.particle2 != particle))
+	  continue;
+
+	if ((record.time < startTime) || (record.time > endTime))
+	  continue;
+
+	out << record.eventCount << " " << record.time << " ";
+	printType(out, record.sourceClass);
+	out << " " << record.sourceID << " ";
+	printType(out, record.type);
+	out << " ";
+	printParticle(out, record.particle1);
+	out << " ";
+	printParticle(out, record.particle2);
+	out << " " << record.deltaP[0] << " " << record.deltaP[1] << " " << record.deltaP[2]
+	    << " " << record.deltaKE << " " << record.deltaU << "\n";
+      }
+
+    if (!out)
+      M_throw() << "Failed while writing the text output";
+  } catch (std::exception& err) {
+    std::cerr << "\nReached Main Error Loop"
+	      << "\nError=" << err.what()
+	      << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
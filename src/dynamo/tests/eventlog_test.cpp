@@ -0,0 +1,218 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/eventlog.hpp>
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+using namespace dynamo;
+
+namespace {
+  const size_t N = 5;
+  const size_t chunkSize = 7;
+  //Two full chunks and a partial one, written by the destructor
+  const size_t recordCount = 20;
+
+  EventLogRecord makeRecord(size_t i)
+  {
+    EventLogRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.eventCount = i / 2;
+    record.time = 0.125 * i;
+    record.sourceClass = i % 4;
+    record.sourceID = i % 3;
+    record.type = i % 11;
+    record.particle1 = i % N;
+    record.particle2 = (i % 3) ? (i + 1) % N : eventLogNoParticle;
+    record.deltaP[0] = 1.0 / (i + 1);
+    record.deltaP[1] = -2.5 * i;
+    record.deltaP[2] = 1e-300 * i;
+    record.deltaKE = 3.0 * i;
+    record.deltaU = -1.0 * i;
+    return record;
+  }
+
+  bool sameRecord(const EventLogRecord& a, const EventLogRecord& b)
+  { return !std::memcmp(&a, &b, sizeof(EventLogRecord)); }
+
+  void writeLog(const std::string& fileName, EventLogHeader::Compression compression)
+  {
+    EventLogWriter writer(fileName, N, compression, chunkSize);
+    for (size_t i(0); i < recordCount; ++i)
+      writer.push(makeRecord(i));
+  }
+
+  //Reads every record of the log, returning false and storing the
+  //error if it throws.
+  bool readLog(const std::string& fileName, std::vector<EventLogRecord>& records, std::string& error)
+  {
+    records.clear();
+    try {
+      EventLogReader reader(fileName);
+      EventLogRecord record;
+      while (reader.next(record))
+	records.push_back(record);
+    } catch (std::exception& err) {
+      error = err.what();
+      return false;
+    }
+    return true;
+  }
+
+  //Cuts the file down by the given number of bytes
+  void truncateFile(const std::string& fileName, size_t bytes)
+  {
+    std::string data;
+    {
+      std::ifstream in(fileName.c_str(), std::ios::binary);
+      data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::ofstream out(fileName.c_str(), std::ios::binary | std::ios::trunc);
+    out.write(data.data(), data.size() - bytes);
+  }
+
+  //The size of the last chunk of the log, including its header
+  size_t lastChunkBytes(const std::string& fileName)
+  {
+    std::ifstream in(fileName.c_str(), std::ios::binary);
+    in.seekg(sizeof(EventLogHeader));
+    EventLogChunkHeader header;
+    size_t bytes = 0;
+    while (in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+      {
+	bytes = sizeof(header) + header.storedBytes;
+	in.seekg(header.storedBytes, std::ios::cur);
+      }
+    return bytes;
+  }
+
+  int testCompression(EventLogHeader::Compression compression, const std::string& name)
+  {
+    const std::string fileName = "eventlog_test_" + name + ".dyntraj";
+    writeLog(fileName, compression);
+
+    {
+      EventLogReader reader(fileName);
+      if ((reader.getHeader().N != N) || (reader.getHeader().compression != uint32_t(compression)))
+	{
+	  std::cerr << name << ": The header does not hold the values it was written with" << std::endl;
+	  return 1;
+	}
+
+      //The chunks must come back as they were pushed
+      std::vector<EventLogRecord> chunk;
+      size_t chunks = 0, read = 0;
+      while (reader.readChunk(chunk))
+	{
+	  const size_t expected = std::min(chunkSize, recordCount - read);
+	  if (chunk.size() != expected)
+	    {
+	      std::cerr << name << ": Chunk " << chunks << " has " << chunk.size() << " records, expected " << expected << std::endl;
+	      return 1;
+	    }
+	  read += chunk.size();
+	  ++chunks;
+	}
+
+      if (chunks != 3)
+	{
+	  std::cerr << name << ": Read " << chunks << " chunks, expected 3" << std::endl;
+	  return 1;
+	}
+    }
+
+    std::vector<EventLogRecord> records;
+    std::string error;
+    if (!readLog(fileName, records, error))
+      {
+	std::cerr << name << ": Failed to read the log back, " << error << std::endl;
+	return 1;
+      }
+
+    if (records.size() != recordCount)
+      {
+	std::cerr << name << ": Read " << records.size() << " records, expected " << recordCount << std::endl;
+	return 1;
+      }
+
+    for (size_t i(0); i < recordCount; ++i)
+      if (!sameRecord(records[i], makeRecord(i)))
+	{
+	  std::cerr << name << ": Record " << i << " does not match the one written" << std::endl;
+	  return 1;
+	}
+
+    //A log cut short within its last chunk must give every record of
+    //the complete chunks, then report the truncation. The last chunk
+    //is cut first in its data, then in its header.
+    const size_t cuts[] = {1, lastChunkBytes(fileName) - sizeof(EventLogChunkHeader) / 2};
+    for (size_t cut : cuts)
+      {
+	writeLog(fileName, compression);
+	truncateFile(fileName, cut);
+
+	if (readLog(fileName, records, error))
+	  {
+	    std::cerr << name << ": Reading a truncated log did not throw" << std::endl;
+	    return 1;
+	  }
+
+	if (error.find("is truncated") == std::string::npos)
+	  {
+	    std::cerr << name << ": Reading a truncated log gave the wrong error, " << error << std::endl;
+	    return 1;
+	  }
+
+	if (records.size() != 2 * chunkSize)
+	  {
+	    std::cerr << name << ": Read " << records.size() << " records of a truncated log, expected " << 2 * chunkSize << std::endl;
+	    return 1;
+	  }
+
+	for (size_t i(0); i < records.size(); ++i)
+	  if (!sameRecord(records[i], makeRecord(i)))
+	    {
+	      std::cerr << name << ": Record " << i << " of a truncated log does not match the one written" << std::endl;
+	      return 1;
+	    }
+      }
+
+    std::remove(fileName.c_str());
+    return 0;
+  }
+}
+
+int main()
+{
+  try {
+    if (testCompression(EventLogHeader::NONE, "None")
+	|| testCompression(EventLogHeader::ZLIB, "Zlib")
+	|| testCompression(EventLogHeader::BZIP2, "BZip2"))
+      return 1;
+  } catch (std::exception& err) {
+    std::cerr << "Unexpected error: " << err.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,164 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <magnet/exception.hpp>
+#include <magnet/memory/aligned_allocator.hpp>
+#include <functional>
+#include <algorithm>
+#include <vector>
+
+namespace magnet {
+  namespace containers {
+    /*! \brief A d-ary min-heap laid out so that each family of
+      children shares a cache-aligned block.
+
+      Compared to a binary heap, a d-ary heap is shallower
+      (log_d(N) levels) and a sift down compares all d children of a
+      node, which are contiguous in memory. The storage is prefixed
+      with d-1 unused elements so that the children of every node
+      start on a multiple of d elements from the (cache line
+      aligned) start of the storage. If d*sizeof(T) is a multiple of
+      the cache line size, each family then occupies whole lines.
+
+      The padding is only allocated on the first push, so empty heaps
+      stay small.
+
+      \tparam T The stored type.
+      \tparam Arity The number of children of each node (d).
+      \tparam Compare The ordering, top() returns an element for which
+      no other element x has Compare()(x, top()).
+    */
+    template<class T, std::size_t Arity = 4, class Compare = std::less<T> >
+    class DaryHeap
+    {
+      static_assert(Arity >= 2, "A heap must have at least two children per node");
+      static const std::size_t Padding = Arity - 1;
+
+      typedef std::vector<T, magnet::memory::AlignedAllocator<T, 64> > Container;
+      Container _c;
+      Compare _comp;
+
+    public:
+      typedef typename Container::iterator iterator;
+      typedef typename Container::const_iterator const_iterator;
+
+      inline std::size_t size() const { return _c.empty() ? 0 : _c.size() - Padding; }
+      inline bool empty() const { return _c.size() <= Padding; }
+
+      inline iterator begin() { return _c.empty() ? _c.end() : _c.begin() + Padding; }
+      inline const_iterator begin() const { return _c.empty() ? _c.end() : _c.begin() + Padding; }
+      inline iterator end() { return _c.end(); }
+      inline const_iterator end() const { return _c.end(); }
+
+      inline const T& top() const
+      {
+#ifdef MAGNET_DEBUG
+	if (empty())
+	  M_throw() << "Heap is empty";
+#endif
+	return _c[Padding];
+      }
+
+      inline void clear()
+      {
+	if (!_c.empty())
+	  _c.resize(Padding);
+      }
+
+      inline void push(const T& val)
+      {
+	if (_c.empty())
+	  _c.resize(Padding);
+
+	_c.push_back(val);
+	siftUp(size() - 1);
+      }
+
+      inline void pop()
+      {
+#ifdef MAGNET_DEBUG
+	if (empty())
+	  M_throw() << "Heap is empty";
+#endif
+	if (size() > 1)
+	  {
+	    _c[Padding] = _c.back();
+	    _c.pop_back();
+	    siftDown(0);
+	  }
+	else
+	  _c.pop_back();
+      }
+
+      inline void swap(DaryHeap& rhs) { _c.swap(rhs._c); }
+
+      /*! \brief Remove every element for which the predicate is
+        true, then restore the heap order in O(N).
+      */
+      template<class Predicate>
+      inline void remove_if(Predicate pred)
+      {
+	if (empty()) return;
+	_c.erase(std::remove_if(begin(), end(), pred), end());
+
+	for (std::size_t i = (size() + Arity - 2) / Arity; i-- > 0;)
+	  siftDown(i);
+      }
+
+    private:
+      //! \brief Access to a heap element by its index in the heap.
+      inline T& at(const std::size_t i) { return _c[i + Padding]; }
+
+      inline void siftUp(std::size_t i)
+      {
+	T val = at(i);
+	while (i)
+	  {
+	    const std::size_t parent = (i - 1) / Arity;
+	    if (!_comp(val, at(parent))) break;
+	    at(i) = at(parent);
+	    i = parent;
+	  }
+	at(i) = val;
+      }
+
+      inline void siftDown(std::size_t i)
+      {
+	const std::size_t N = size();
+	T val = at(i);
+	for (;;)
+	  {
+	    const std::size_t first = Arity * i + 1;
+	    if (first >= N) break;
+	    const std::size_t last = std::min(first + Arity, N);
+
+	    std::size_t best = first;
+	    for (std::size_t child = first + 1; child < last; ++child)
+	      if (_comp(at(child), at(best)))
+		best = child;
+
+	    if (!_comp(at(best), val)) break;
+	    at(i) = at(best);
+	    i = best;
+	  }
+	at(i) = val;
+      }
+    };
+  }
+}
@@ -0,0 +1,118 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+namespace magnet {
+  namespace containers {
+    /*! \brief An array which only grows at its end, and whose
+      elements never move once they are added.
+
+      A std::vector moves its elements when it reallocates, so it
+      cannot be read by one thread while another appends to it. This
+      array stores its elements in blocks which double in size
+      (firstBlock, 2*firstBlock, 4*firstBlock...), so appending never
+      moves the existing elements. This allows a lazily calculated
+      cache to be extended by one thread while other threads read the
+      elements already in it, provided that:
+
+      - Only one thread appends at a time (e.g., under a mutex).
+      - Readers only access elements with an index below a value of
+        size() they have read. The size is published after the
+        element is written, so these elements are complete.
+
+      clear() must not be called while other threads use the array.
+
+      \tparam T The type of the elements.
+      \tparam firstBlock The number of elements in the first block.
+     */
+    template<class T, std::size_t firstBlock = 64>
+    class AppendOnlyArray
+    {
+    public:
+      AppendOnlyArray(): _size(0) {}
+
+      std::size_t size() const { return _size.load(std::memory_order_acquire); }
+
+      bool empty() const { return size() == 0; }
+
+      T& operator[](std::size_t i) { return element(i); }
+
+      const T& operator[](std::size_t i) const { return element(i); }
+
+      T& front() { return element(0); }
+      const T& front() const { return element(0); }
+
+      T& back() { return element(size() - 1); }
+      const T& back() const { return element(size() - 1); }
+
+      void push_back(const T& val)
+      {
+	const std::size_t i = _size.load(std::memory_order_relaxed);
+	std::size_t block, offset;
+	locate(i, block, offset);
+
+	if (!_blocks[block])
+	  _blocks[block].reset(new T[firstBlock << block]);
+
+	_blocks[block][offset] = val;
+	_size.store(i + 1, std::memory_order_release);
+      }
+
+      void clear()
+      {
+	for (std::unique_ptr<T[]>& block : _blocks)
+	  block.reset();
+	_size.store(0, std::memory_order_release);
+      }
+
+    private:
+      AppendOnlyArray(const AppendOnlyArray&);
+      AppendOnlyArray& operator=(const AppendOnlyArray&);
+
+      /*! \brief Finds the block holding element i, and the offset of
+          the element in it.
+
+	  Block b holds the elements from firstBlock * (2^b - 1) up to
+	  firstBlock * (2^(b+1) - 1).
+       */
+      static void locate(std::size_t i, std::size_t& block, std::size_t& offset)
+      {
+	std::size_t j = i / firstBlock + 1;
+	block = 0;
+	while (j >>= 1) ++block;
+	offset = i - firstBlock * ((std::size_t(1) << block) - 1);
+      }
+
+      T& element(std::size_t i) const
+      {
+	std::size_t block, offset;
+	locate(i, block, offset);
+	return _blocks[block][offset];
+      }
+
+      //! \brief Enough blocks for any array which fits in memory.
+      static const std::size_t maxBlocks = 48;
+
+      std::unique_ptr<T[]> _blocks[maxBlocks];
+      std::atomic<std::size_t> _size;
+    };
+  }
+}
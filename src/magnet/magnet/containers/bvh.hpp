@@ -0,0 +1,212 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/math/vector.hpp>
+#include <magnet/exception.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <cmath>
+
+namespace magnet {
+  namespace containers {
+    /*! \brief A bounding volume hierarchy of axis-aligned boxes, for
+        finding the first of a set of objects hit by a moving body.
+
+	The tree is built top down by splitting the objects at the
+	median of their centres along the longest axis of the node,
+	until at most LeafSize objects remain. The nodes are stored in
+	depth-first order, so the left child of an internal node
+	immediately follows it.
+
+	The tree is searched using search(), which visits the nodes in
+	the order they are entered by the moving body and skips every
+	node which cannot be entered before the earliest event found so
+	far.
+     */
+    class BVH
+    {
+    public:
+      //! \brief The maximum number of objects in a leaf node.
+      static const size_t LeafSize = 4;
+
+      struct Node
+      {
+	math::Vector min, max;
+	//! \brief The first object (for leaves) or the right child (for internal nodes).
+	size_t first;
+	//! \brief The number of objects, zero for internal nodes.
+	size_t count;
+      };
+
+      /*! \brief Builds the tree.
+
+	  \param N The number of objects.
+	  \param bounds A functor taking the index of an object and
+	  returning a std::pair of the minimum and maximum corners of
+	  its bounding box.
+       */
+      template<class BoundsFunc>
+      void build(size_t N, const BoundsFunc& bounds)
+      {
+	_nodes.clear();
+	_objects.resize(N);
+	_boxes.resize(N);
+	for (size_t i(0); i < N; ++i)
+	  {
+	    _objects[i] = i;
+	    _boxes[i] = bounds(i);
+	  }
+
+	if (N)
+	  {
+	    _nodes.reserve(2 * (N / LeafSize + 1));
+	    buildNode(0, N, 0);
+	  }
+
+	//The boxes are only needed during the build
+	std::vector<std::pair<math::Vector, math::Vector> >().swap(_boxes);
+      }
+
+      /*! \brief Visits the objects which may be hit before a time
+          limit, in roughly the order they are reached.
+
+	  \param entry A functor taking the minimum and maximum corners
+	  of a node's box, and returning a lower bound on the time
+	  until the body enters the box (HUGE_VAL if it never does).
+
+	  \param visit A functor taking the index of an object, which
+	  tests the object and may reduce the limit.
+
+	  \param limit The time after which objects are not needed.
+	  This is taken by reference, so reductions made by the visit
+	  functor immediately prune the remaining search.
+       */
+      template<class EntryFunc, class VisitFunc>
+      void search(const EntryFunc& entry, const VisitFunc& visit, const double& limit) const
+      {
+	if (_nodes.empty()) return;
+
+	std::pair<double, size_t> stack[MaxDepth + 1];
+	size_t stackSize(0);
+
+	const double rootEntry = entry(_nodes[0].min, _nodes[0].max);
+	if (rootEntry == HUGE_VAL) return;
+	stack[stackSize++] = std::make_pair(rootEntry, size_t(0));
+
+	while (stackSize)
+	  {
+	    const std::pair<double, size_t> current = stack[--stackSize];
+	    if (current.first > limit) continue;
+
+	    const Node& node = _nodes[current.second];
+	    if (node.count)
+	      {
+		for (size_t i(node.first); i < node.first + node.count; ++i)
+		  visit(_objects[i]);
+		continue;
+	      }
+
+	    const size_t left = current.second + 1, right = node.first;
+	    const double tLeft = entry(_nodes[left].min, _nodes[left].max);
+	    const double tRight = entry(_nodes[right].min, _nodes[right].max);
+
+	    //Push the nearer child last, so it is searched first
+	    if (tLeft < tRight)
+	      {
+		if (tRight != HUGE_VAL) stack[stackSize++] = std::make_pair(tRight, right);
+		stack[stackSize++] = std::make_pair(tLeft, left);
+	      }
+	    else
+	      {
+		if (tLeft != HUGE_VAL) stack[stackSize++] = std::make_pair(tLeft, left);
+		if (tRight != HUGE_VAL) stack[stackSize++] = std::make_pair(tRight, right);
+	      }
+	  }
+      }
+
+      const std::vector<Node>& getNodes() const { return _nodes; }
+
+      bool empty() const { return _nodes.empty(); }
+
+    private:
+      //! \brief The maximum depth of the tree, bounding the size of the search stack.
+      static const size_t MaxDepth = 64;
+
+      size_t buildNode(size_t begin, size_t end, size_t depth)
+      {
+	if (depth >= MaxDepth)
+	  M_throw() << "The bounding volume hierarchy is too deep";
+
+	const size_t nodeID = _nodes.size();
+	_nodes.push_back(Node());
+
+	//The bounds of the objects, and of their centres
+	math::Vector min(HUGE_VAL, HUGE_VAL, HUGE_VAL), max(-HUGE_VAL, -HUGE_VAL, -HUGE_VAL);
+	math::Vector cmin = min, cmax = max;
+	for (size_t i(begin); i < end; ++i)
+	  {
+	    const std::pair<math::Vector, math::Vector>& box = _boxes[_objects[i]];
+	    const math::Vector centre = 0.5 * (box.first + box.second);
+	    for (size_t iDim(0); iDim < 3; ++iDim)
+	      {
+		min[iDim] = std::min(min[iDim], box.first[iDim]);
+		max[iDim] = std::max(max[iDim], box.second[iDim]);
+		cmin[iDim] = std::min(cmin[iDim], centre[iDim]);
+		cmax[iDim] = std::max(cmax[iDim], centre[iDim]);
+	      }
+	  }
+
+	_nodes[nodeID].min = min;
+	_nodes[nodeID].max = max;
+
+	if (end - begin <= LeafSize)
+	  {
+	    _nodes[nodeID].first = begin;
+	    _nodes[nodeID].count = end - begin;
+	    return nodeID;
+	  }
+
+	size_t axis(0);
+	for (size_t iDim(1); iDim < 3; ++iDim)
+	  if (cmax[iDim] - cmin[iDim] > cmax[axis] - cmin[axis])
+	    axis = iDim;
+
+	const size_t mid = begin + (end - begin) / 2;
+	std::nth_element(_objects.begin() + begin, _objects.begin() + mid, _objects.begin() + end,
+			 [&](size_t a, size_t b)
+			 {
+			   return (_boxes[a].first[axis] + _boxes[a].second[axis])
+			     < (_boxes[b].first[axis] + _boxes[b].second[axis]);
+			 });
+
+	buildNode(begin, mid, depth + 1);
+	const size_t right = buildNode(mid, end, depth + 1);
+	_nodes[nodeID].first = right;
+	_nodes[nodeID].count = 0;
+	return nodeID;
+      }
+
+      std::vector<Node> _nodes;
+      //! \brief The object indices, ordered so each leaf holds a contiguous range.
+      std::vector<size_t> _objects;
+      //! \brief The bounding boxes of the objects, during the build.
+      std::vector<std::pair<math::Vector, math::Vector> > _boxes;
+    };
+  }
+}
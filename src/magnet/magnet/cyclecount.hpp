@@ -0,0 +1,44 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <cstdint>
+#if defined(__i386__) || defined(__x86_64__)
+# include <x86intrin.h>
+#else
+# include <chrono>
+#endif
+
+namespace magnet {
+  /*! \brief A cheap, monotonic counter for timing short sections of
+      code.
+
+      On x86 processors this is the time stamp counter (CPU cycles at
+      the nominal clock rate), elsewhere it falls back to the
+      nanoseconds of std::chrono::steady_clock. Only differences
+      between two counts on the same thread are meaningful.
+   */
+  inline uint64_t cycle_count()
+  {
+#if defined(__i386__) || defined(__x86_64__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>
+      (std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+}
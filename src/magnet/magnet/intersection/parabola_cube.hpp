@@ -0,0 +1,151 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/math/vector.hpp>
+#include <algorithm>
+#include <initializer_list>
+#include <cmath>
+
+namespace magnet {
+  namespace intersection {
+    namespace detail {
+      /*! \brief Finds the time intervals, in \f$[0,\infty)\f$, in
+          which a one dimensional parabola \f$x(t)=T+D\,t+G\,t^2/2\f$
+          lies within \f$[-h,h]\f$.
+
+	  \param start The starts of the disjoint intervals, in
+	  ascending order (must have space for 5 values).
+	  \param end The ends of the intervals.
+	  \return The number of intervals (at most 2, barring rounding).
+       */
+      inline size_t parabola_slab_intervals(double T, double D, double G, double h,
+					    double* start, double* end)
+      {
+	//The times where the parabola crosses either face of the slab
+	double breaks[5];
+	size_t count(0);
+	breaks[count++] = 0;
+
+	const double a = 0.5 * G;
+	for (double face : {-h, h})
+	  {
+	    const double c = T - face;
+	    if (a == 0)
+	      {
+		if (D != 0)
+		  breaks[count++] = -c / D;
+		continue;
+	      }
+
+	    const double discriminant = D * D - 4 * a * c;
+	    if (discriminant < 0) continue;
+	    const double q = -0.5 * (D + std::copysign(std::sqrt(discriminant), D));
+	    breaks[count++] = q / a;
+	    if (q != 0) breaks[count++] = c / q;
+	  }
+
+	//Insertion sort the (at most 5) breaks
+	for (size_t i(1); i < count; ++i)
+	  for (size_t j(i); (j > 0) && (breaks[j] < breaks[j - 1]); --j)
+	    std::swap(breaks[j], breaks[j - 1]);
+
+	//Discard the negative times (the first break is zero)
+	size_t first(0);
+	while (breaks[first] < 0) ++first;
+
+	//Test a point within each interval between the breaks, the
+	//last interval extends to infinity
+	size_t intervals(0);
+	for (size_t i(first); i < count; ++i)
+	  {
+	    const double next = (i + 1 < count) ? breaks[i + 1] : HUGE_VAL;
+	    if (next <= breaks[i]) continue;
+	    const double t = (i + 1 < count) ? 0.5 * (breaks[i] + next) : breaks[i] + 1;
+	    if (std::abs(T + t * (D + a * t)) > h) continue;
+
+	    if (intervals && (end[intervals - 1] == breaks[i]))
+	      end[intervals - 1] = next;
+	    else
+	      {
+		start[intervals] = breaks[i];
+		end[intervals] = next;
+		++intervals;
+	      }
+	  }
+
+	return intervals;
+      }
+    }
+
+    /*! \brief The earliest time at which a parabola lies within an
+        axis-aligned cube.
+
+      If the parabola origin is already inside the cube, zero is
+      returned. This is intended for conservative culling tests
+      (e.g., when searching a bounding volume hierarchy).
+      
+      \param T The origin of the parabola relative to the cube center.
+      \param D The initial velocity of the parabola.
+      \param G The acceleration of the parabola.
+      \param C The dimensions of the cube.
+      \return The time until the parabola enters the cube, zero if it
+      is inside, or HUGE_VAL if it never enters.
+    */
+    inline double parabola_AAcube_entry(const math::Vector& T,
+					const math::Vector& D,
+					const math::Vector& G,
+					const math::Vector& C)
+    {
+      //The set of times when the parabola is inside all of the
+      //slabs processed so far. A slab has at most 2 intervals (5
+      //allows for any rounding), and the intersection of two sorted
+      //lists of n and m intervals has at most n+m-1.
+      double start[16], end[16];
+      size_t count = detail::parabola_slab_intervals(T[0], D[0], G[0], 0.5 * C[0], start, end);
+
+      for (size_t i(1); (i < 3) && count; ++i)
+	{
+	  double slabStart[5], slabEnd[5];
+	  const size_t slabCount = detail::parabola_slab_intervals(T[i], D[i], G[i], 0.5 * C[i], slabStart, slabEnd);
+
+	  double newStart[16], newEnd[16];
+	  size_t newCount(0);
+	  for (size_t j(0), k(0); (j < count) && (k < slabCount);)
+	    {
+	      const double s = std::max(start[j], slabStart[k]);
+	      const double e = std::min(end[j], slabEnd[k]);
+	      if (s <= e)
+		{
+		  newStart[newCount] = s;
+		  newEnd[newCount] = e;
+		  ++newCount;
+		}
+
+	      if (end[j] < slabEnd[k]) ++j; else ++k;
+	    }
+
+	  count = newCount;
+	  std::copy(newStart, newStart + count, start);
+	  std::copy(newEnd, newEnd + count, end);
+	}
+
+      if (!count) return HUGE_VAL;
+      return start[0];
+    }
+  }
+}
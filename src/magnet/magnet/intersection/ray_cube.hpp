@@ -17,6 +17,8 @@
 
 #pragma once
 #include <magnet/math/vector.hpp>
+#include <algorithm>
+#include <cmath>
 
 namespace magnet {
   namespace intersection {
@@ -83,5 +85,49 @@ namespace magnet {
       //cube.
       return HUGE_VAL;
     }
+
+    /*! \brief The earliest time at which a ray lies within an
+        axis-aligned cube.
+
+      Unlike ray_AAcube_bfc, this does not cull back faces. If the
+      ray origin is already inside the cube, zero is returned. This is
+      intended for conservative culling tests (e.g., when searching a
+      bounding volume hierarchy).
+      
+      \param T The origin of the ray relative to the cube center.
+      \param D The direction/velocity of the ray.
+      \param C The dimensions of the cube.
+      eturn The time until the ray enters the cube, zero if it
+      is inside, or HUGE_VAL if it never enters.
+    */
+    inline double ray_AAcube_entry(const math::Vector& T,
+				   const math::Vector& D,
+				   const math::Vector& C)
+    {
+      double time_in_max = 0;
+      double time_out_min = HUGE_VAL;
+      
+      for (size_t i(0); i < 3; ++i)
+	{
+	  const double half = 0.5 * C[i];
+	  if (D[i] == 0)
+	    {
+	      if (std::abs(T[i]) > half)
+		return HUGE_VAL;
+	    }
+	  else
+	    {
+	      const double invD = 1 / D[i];
+	      double time_in  = (-half - T[i]) * invD;
+	      double time_out = (+half - T[i]) * invD;
+	      if (time_in > time_out) std::swap(time_in, time_out);
+
+	      time_in_max = std::max(time_in_max, time_in);
+	      time_out_min = std::min(time_out_min, time_out);
+	    }
+	}
+
+      return (time_in_max > time_out_min) ? HUGE_VAL : time_in_max;
+    }
   }
 }
@@ -18,6 +18,18 @@
 #pragma once
 #include <magnet/math/vector.hpp>
 #include <math.h>
+#include <cstddef>
+#include <algorithm>
+
+//The vectorised kernels are compiled for their instruction sets using
+//function attributes and selected at run time, so they do not depend
+//on the flags the rest of the code is compiled with. Contraction into
+//fused multiply-adds is disabled in them (AVX-512 implies FMA), as it
+//changes the results from those of the scalar code.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define MAGNET_RAY_SPHERE_SIMD
+# include <immintrin.h>
+#endif
 
 namespace magnet {
   namespace intersection {
@@ -44,6 +56,154 @@ namespace magnet {
       return  std::max(0.0, - c / (TD - std::sqrt(arg)));
     }
 
+    namespace detail {
+      /*! \brief The scalar kernel of the batched ray_sphere_bfc,
+	written in terms of the vector components to match the
+	vectorised versions.
+      */
+      inline double ray_sphere_bfc(double Tx, double Ty, double Tz,
+				   double Dx, double Dy, double Dz,
+				   double r)
+      {
+	const double TD = Tx * Dx + Ty * Dy + Tz * Dz;
+	const double c = (Tx * Tx + Ty * Ty + Tz * Tz) - r * r;
+	const double arg = TD * TD - (Dx * Dx + Dy * Dy + Dz * Dz) * c;
+	
+	if ((TD >= 0) || (arg < 0)) return HUGE_VAL;
+
+	return std::max(0.0, - c / (TD - std::sqrt(arg)));
+      }
+    }
+
+    /*! \brief The instruction sets the batched ray_sphere_bfc can
+        use, in order of preference.
+     */
+    enum RaySphereSIMD { RAY_SPHERE_SCALAR, RAY_SPHERE_AVX, RAY_SPHERE_AVX512 };
+
+    namespace detail {
+#ifdef MAGNET_RAY_SPHERE_SIMD
+      //GCC's AVX-512 intrinsics use deliberately uninitialised
+      //registers (_mm512_undefined_pd), which it then warns about
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+      //! \brief Processes the batch 8 rays at a time, returning the number of rays done.
+      __attribute__((target("avx512f"), optimize("fp-contract=off")))
+      inline size_t ray_sphere_bfc_avx512(const double* Tx, const double* Ty, const double* Tz,
+					  const double* Dx, const double* Dy, const double* Dz,
+					  const double* r, double* t, const size_t N)
+      {
+	const __m512d zero = _mm512_setzero_pd();
+	const __m512d inf = _mm512_set1_pd(HUGE_VAL);
+	const __m512i signbit = _mm512_castpd_si512(_mm512_set1_pd(-0.0));
+	size_t i(0);
+	for (; i + 8 <= N; i += 8)
+	  {
+	    const __m512d tx = _mm512_loadu_pd(Tx + i), ty = _mm512_loadu_pd(Ty + i), tz = _mm512_loadu_pd(Tz + i);
+	    const __m512d dx = _mm512_loadu_pd(Dx + i), dy = _mm512_loadu_pd(Dy + i), dz = _mm512_loadu_pd(Dz + i);
+	    const __m512d R = _mm512_loadu_pd(r + i);
+
+	    const __m512d TD = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(tx, dx), _mm512_mul_pd(ty, dy)), _mm512_mul_pd(tz, dz));
+	    const __m512d T2 = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(tx, tx), _mm512_mul_pd(ty, ty)), _mm512_mul_pd(tz, tz));
+	    const __m512d D2 = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)), _mm512_mul_pd(dz, dz));
+	    const __m512d c = _mm512_sub_pd(T2, _mm512_mul_pd(R, R));
+	    const __m512d arg = _mm512_sub_pd(_mm512_mul_pd(TD, TD), _mm512_mul_pd(D2, c));
+
+	    //Lanes which approach the sphere and have real roots
+	    const __mmask8 hit = _mm512_cmp_pd_mask(TD, zero, _CMP_LT_OQ) & _mm512_cmp_pd_mask(arg, zero, _CMP_GE_OQ);
+	    const __m512d negc = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(c), signbit));
+	    const __m512d root = _mm512_div_pd(negc, _mm512_sub_pd(TD, _mm512_sqrt_pd(_mm512_max_pd(arg, zero))));
+	    _mm512_storeu_pd(t + i, _mm512_mask_blend_pd(hit, inf, _mm512_max_pd(root, zero)));
+	  }
+	return i;
+      }
+# pragma GCC diagnostic pop
+
+      //! \brief Processes the batch 4 rays at a time, returning the number of rays done.
+      __attribute__((target("avx"), optimize("fp-contract=off")))
+      inline size_t ray_sphere_bfc_avx(const double* Tx, const double* Ty, const double* Tz,
+				       const double* Dx, const double* Dy, const double* Dz,
+				       const double* r, double* t, const size_t N)
+      {
+	const __m256d zero = _mm256_setzero_pd();
+	const __m256d inf = _mm256_set1_pd(HUGE_VAL);
+	const __m256d signbit = _mm256_set1_pd(-0.0);
+	size_t i(0);
+	for (; i + 4 <= N; i += 4)
+	  {
+	    const __m256d tx = _mm256_loadu_pd(Tx + i), ty = _mm256_loadu_pd(Ty + i), tz = _mm256_loadu_pd(Tz + i);
+	    const __m256d dx = _mm256_loadu_pd(Dx + i), dy = _mm256_loadu_pd(Dy + i), dz = _mm256_loadu_pd(Dz + i);
+	    const __m256d R = _mm256_loadu_pd(r + i);
+
+	    const __m256d TD = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(tx, dx), _mm256_mul_pd(ty, dy)), _mm256_mul_pd(tz, dz));
+	    const __m256d T2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(tx, tx), _mm256_mul_pd(ty, ty)), _mm256_mul_pd(tz, tz));
+	    const __m256d D2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+	    const __m256d c = _mm256_sub_pd(T2, _mm256_mul_pd(R, R));
+	    const __m256d arg = _mm256_sub_pd(_mm256_mul_pd(TD, TD), _mm256_mul_pd(D2, c));
+
+	    //Lanes which approach the sphere and have real roots
+	    const __m256d hit = _mm256_and_pd(_mm256_cmp_pd(TD, zero, _CMP_LT_OQ), _mm256_cmp_pd(arg, zero, _CMP_GE_OQ));
+	    const __m256d root = _mm256_div_pd(_mm256_xor_pd(c, signbit), _mm256_sub_pd(TD, _mm256_sqrt_pd(_mm256_max_pd(arg, zero))));
+	    _mm256_storeu_pd(t + i, _mm256_blendv_pd(inf, _mm256_max_pd(root, zero), hit));
+	  }
+	return i;
+      }
+#endif
+    }
+
+    //! \brief The best instruction set for the batched ray_sphere_bfc on this machine.
+    inline RaySphereSIMD ray_sphere_bfc_support()
+    {
+#ifdef MAGNET_RAY_SPHERE_SIMD
+      static const RaySphereSIMD level = __builtin_cpu_supports("avx512f") ? RAY_SPHERE_AVX512
+	: (__builtin_cpu_supports("avx") ? RAY_SPHERE_AVX : RAY_SPHERE_SCALAR);
+      return level;
+#else
+      return RAY_SPHERE_SCALAR;
+#endif
+    }
+
+    /*! \brief A batched ray-sphere intersection test with backface
+      culling.
+
+      This performs \ref ray_sphere_bfc on \p N rays at once. The
+      data is supplied in a structure-of-arrays layout so that the
+      test may be performed on several rays per instruction. On x86
+      machines supporting AVX-512 (8 rays) or AVX (4 rays), intrinsics
+      are used for the bulk of the batch and the remainder is handled
+      by the scalar code.
+
+      The same operations are performed in the same order as the
+      scalar function, so the results are identical unless the scalar
+      code is compiled with fused multiply-adds (e.g., -march=native).
+
+      \param Tx,Ty,Tz The origins of the rays relative to the sphere
+      centers.
+      \param Dx,Dy,Dz The directions/velocities of the rays.
+      \param r The radii of the spheres.
+      \param t The output array for the times until the intersections
+      (HUGE_VAL if no intersection).
+      \param N The number of rays to test.
+      \param simd The instruction set to use, which is limited to
+      those supported by the machine (see ray_sphere_bfc_support).
+    */
+    inline void ray_sphere_bfc(const double* Tx, const double* Ty, const double* Tz,
+			       const double* Dx, const double* Dy, const double* Dz,
+			       const double* r, double* t, const size_t N,
+			       RaySphereSIMD simd = RAY_SPHERE_AVX512)
+    {
+      size_t i(0);
+#ifdef MAGNET_RAY_SPHERE_SIMD
+      switch (std::min(simd, ray_sphere_bfc_support()))
+	{
+	case RAY_SPHERE_AVX512: i = detail::ray_sphere_bfc_avx512(Tx, Ty, Tz, Dx, Dy, Dz, r, t, N); break;
+	case RAY_SPHERE_AVX: i = detail::ray_sphere_bfc_avx(Tx, Ty, Tz, Dx, Dy, Dz, r, t, N); break;
+	case RAY_SPHERE_SCALAR: break;
+	}
+#endif
+      for (; i < N; ++i)
+	t[i] = detail::ray_sphere_bfc(Tx[i], Ty[i], Tz[i], Dx[i], Dy[i], Dz[i], r[i]);
+    }
+
     /*! \brief A ray-inverse_sphere intersection test with backface culling.
       
       An inverse sphere means an "enclosing" sphere.
@@ -0,0 +1,202 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/math/vector.hpp>
+#include <magnet/math/wigner3J.hpp>
+#include <algorithm>
+#include <complex>
+#include <vector>
+#include <cmath>
+
+namespace magnet {
+  namespace math {
+    /*! \brief Evaluates the Steinhardt bond-order parameters, \f$Q_l\f$
+        and \f$\hat W_l\f$, for all \f$l<\f$ maxl.
+
+	The bonds of a set of particles are summed into the
+	coefficients \f$q_{lm}=\sum_{bonds} Y_{lm}(\hat r_{ij})\f$, which
+	are stored in a flat array (see index). The spherical harmonics
+	of each bond are evaluated using the recurrence relations of the
+	associated Legendre polynomials, written directly in terms of
+	the Cartesian components of the bond vector (\f$\cos\theta=z\f$
+	and \f$\sin\theta\,e^{i\phi}=x+iy\f$). No trigonometric
+	functions are called. The Condon-Shortley phase is included, so
+	the harmonics match boost::math::spherical_harmonic.
+
+	The Wigner 3j symbols required by \f$\hat W_l\f$ are tabulated
+	on construction. All of the member functions are const, so one
+	instance may be shared between threads.
+     */
+    class BondOrderParameters
+    {
+    public:
+      typedef std::complex<double> complex;
+
+      /*! \param maxl The number of \f$l\f$ values to evaluate,
+          i.e., \f$l=0,1,\ldots,\f$ maxl\f$-1\f$.
+       */
+      BondOrderParameters(size_t maxl = 0):
+	_maxl(maxl)
+      {
+	//The normalisation of the spherical harmonics and the
+	//coefficients of the recurrence relation, for m >= 0
+	_norm.resize(maxl * (maxl + 1) / 2);
+	_recA.resize(_norm.size());
+	_recB.resize(_norm.size());
+	for (size_t l(0); l < maxl; ++l)
+	  for (size_t m(0); m <= l; ++m)
+	    {
+	      double factorialRatio(1);
+	      for (size_t i(l - m + 1); i <= l + m; ++i)
+		factorialRatio /= i;
+
+	      _norm[triIndex(l, m)] = std::sqrt((2.0 * l + 1.0) / (4.0 * M_PI) * factorialRatio);
+	      _recA[triIndex(l, m)] = (l > m) ? (2.0 * l - 1.0) / (l - m) : 0;
+	      _recB[triIndex(l, m)] = (l > m) ? (l + m - 1.0) / (l - m) : 0;
+	    }
+
+	_w3jOffset.resize(maxl);
+	size_t offset(0);
+	for (size_t l(0); l < maxl; ++l)
+	  {
+	    _w3jOffset[l] = offset;
+	    offset += (2 * l + 1) * (2 * l + 1);
+	  }
+
+	_w3j.resize(offset);
+	for (int l(0); l < int(maxl); ++l)
+	  for (int m1(-l); m1 <= l; ++m1)
+	    for (int m2(-l); m2 <= l; ++m2)
+	      {
+		const int m3 = -(m1 + m2);
+		_w3j[_w3jOffset[l] + (m1 + l) * (2 * l + 1) + (m2 + l)]
+		  = (std::abs(m3) <= l) ? wignerThreej(l, l, l, m1, m2, m3) : 0;
+	      }
+      }
+
+      //! \brief The number of \f$l\f$ values evaluated.
+      size_t getMaxL() const { return _maxl; }
+
+      //! \brief The number of \f$q_{lm}\f$ coefficients.
+      size_t size() const { return _maxl * _maxl; }
+
+      //! \brief The offset of the coefficient \f$q_{lm}\f$ in the flat array.
+      static size_t index(int l, int m) { return l * l + l + m; }
+
+      /*! \brief Adds the spherical harmonics of a bond to the
+          coefficients.
+
+	  \param rij The unit vector along the bond.
+	  \param qlm The array of size() coefficients to add to.
+       */
+      void addBond(const Vector& rij, complex* qlm) const
+      {
+	const double z = rij[2];
+	//(x+iy)^m = sin^m(theta) e^{i m phi}
+	complex sinPhase(1, 0);
+	//The Legendre polynomial P_m^m without the sin^m(theta)
+	//factor, including the Condon-Shortley phase
+	double Pmm(1);
+
+	for (int m(0); m < int(_maxl); ++m)
+	  {
+	    //Recur up in l, again without the sin^m(theta) factor
+	    double Plm2(0), Plm1(Pmm);
+	    for (int l(m); l < int(_maxl); ++l)
+	      {
+		double Plm = Plm1;
+		if (l == m + 1)
+		  Plm = (2.0 * m + 1.0) * z * Pmm;
+		else if (l > m + 1)
+		  Plm = _recA[triIndex(l, m)] * z * Plm1 - _recB[triIndex(l, m)] * Plm2;
+
+		const complex Ylm = (_norm[triIndex(l, m)] * Plm) * sinPhase;
+		qlm[index(l, m)] += Ylm;
+		//Y_{l,-m} = (-1)^m conj(Y_{lm})
+		if (m)
+		  qlm[index(l, -m)] += (m % 2) ? -std::conj(Ylm) : std::conj(Ylm);
+
+		Plm2 = Plm1;
+		Plm1 = Plm;
+	      }
+
+	    Pmm *= -(2.0 * m + 1.0);
+	    sinPhase *= complex(rij[0], rij[1]);
+	  }
+      }
+
+      /*! \brief Returns \f$Q_l=\sqrt{\frac{4\pi}{2l+1}\sum_m |s\,q_{lm}|^2}\f$.
+
+          \param scale The factor \f$s\f$ to normalise the
+          coefficients by, typically one over the number of bonds.
+       */
+      double Q(int l, const complex* qlm, double scale = 1) const
+      {
+	double sum(0);
+	for (int m(-l); m <= l; ++m)
+	  sum += std::norm(qlm[index(l, m)]);
+
+	return scale * std::sqrt(sum * 4.0 * M_PI / (2.0 * l + 1.0));
+      }
+
+      /*! \brief Returns \f$\hat
+          W_l=\sum_{m_1+m_2+m_3=0}\left(\begin{smallmatrix}l&l&l\\m_1&m_2&m_3\end{smallmatrix}\right)q_{lm_1}q_{lm_2}q_{lm_3}
+          \left(\sum_m |q_{lm}|^2\right)^{-3/2}\f$.
+
+	  This is independent of the normalisation of the
+	  coefficients. Zero is returned if all of the coefficients
+	  are zero.
+       */
+      double W(int l, const complex* qlm) const
+      {
+	double sum(0);
+	for (int m(-l); m <= l; ++m)
+	  sum += std::norm(qlm[index(l, m)]);
+
+	if (sum == 0) return 0;
+
+	const double* w3j = &_w3j[_w3jOffset[l]];
+	const complex* q = qlm + index(l, 0);
+	complex Wsum(0, 0);
+	for (int m1(-l); m1 <= l; ++m1)
+	  {
+	    complex inner(0, 0);
+	    for (int m2(std::max(-l, -l - m1)); m2 <= std::min(l, l - m1); ++m2)
+	      inner += w3j[(m1 + l) * (2 * l + 1) + (m2 + l)] * q[m2] * q[-(m1 + m2)];
+	    Wsum += q[m1] * inner;
+	  }
+
+	return Wsum.real() * std::pow(sum, -1.5);
+      }
+
+      //! \brief The tabulated Wigner 3j symbol \f$\left(\begin{smallmatrix}l&l&l\\m_1&m_2&-m_1-m_2\end{smallmatrix}\right)\f$.
+      double wigner3j(int l, int m1, int m2) const
+      { return _w3j[_w3jOffset[l] + (m1 + l) * (2 * l + 1) + (m2 + l)]; }
+
+    private:
+      static size_t triIndex(size_t l, size_t m) { return l * (l + 1) / 2 + m; }
+
+      size_t _maxl;
+      std::vector<double> _norm;
+      std::vector<double> _recA;
+      std::vector<double> _recB;
+      std::vector<double> _w3j;
+      std::vector<size_t> _w3jOffset;
+    };
+  }
+}
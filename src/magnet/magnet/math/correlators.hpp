@@ -118,6 +118,44 @@ namespace magnet {
 	return _count - i;
       }
 
+      /*! \brief Writes the collected data to an archive (e.g., a
+          dynamo::CheckpointWriter), which must provide write() for
+          T, size_t and std::vector<T>.
+       */
+      template<class Archive>
+      void saveState(Archive& out) const
+      {
+	out.write(_count);
+	out.write(_length);
+	out.write(size_t(_sample_history.size()));
+	for (const std::pair<T, T>& sample : _sample_history)
+	  {
+	    out.write(sample.first);
+	    out.write(sample.second);
+	  }
+	out.write(_correlator);
+      }
+
+      //! \brief Restores the data written by saveState.
+      template<class Archive>
+      void loadState(Archive& in)
+      {
+	in.read(_count);
+	in.read(_length);
+	_sample_history.clear();
+	_sample_history.set_capacity(_length);
+	size_t samples;
+	in.read(samples);
+	for (size_t i(0); i < samples; ++i)
+	  {
+	    std::pair<T, T> sample;
+	    in.read(sample.first);
+	    in.read(sample.second);
+	    _sample_history.push_back(sample);
+	  }
+	in.read(_correlator);
+      }
+
     protected:
       boost::circular_buffer<std::pair<T, T> > _sample_history;
       std::vector<T> _correlator;
@@ -245,6 +283,32 @@ namespace magnet {
        */
       double getSampleTime() const { return _sample_time; }
 
+      //! \brief See Correlator::saveState().
+      template<class Archive>
+      void saveState(Archive& out) const
+      {
+	Base::saveState(out);
+	out.write(_freestream_values.first);
+	out.write(_freestream_values.second);
+	out.write(_W_sums.first);
+	out.write(_W_sums.second);
+	out.write(_sample_time);
+	out.write(_current_time);
+      }
+
+      //! \brief Restores the data written by saveState.
+      template<class Archive>
+      void loadState(Archive& in)
+      {
+	Base::loadState(in);
+	in.read(_freestream_values.first);
+	in.read(_freestream_values.second);
+	in.read(_W_sums.first);
+	in.read(_W_sums.second);
+	in.read(_sample_time);
+	in.read(_current_time);
+      }
+
     protected:
       std::pair<T,T> _freestream_values;
       std::pair<T,T> _W_sums;
@@ -410,6 +474,50 @@ namespace magnet {
 	return avg_correlator;
       }
 
+      /*! \brief Writes the collected data, including that of every
+          contained TimeCorrelator (see Correlator::saveState()).
+       */
+      template<class Archive>
+      void saveState(Archive& out) const
+      {
+	out.write(_sample_time);
+	out.write(_current_time);
+	out.write(_length);
+	out.write(_scaling);
+	out.write(_freestream_values.first);
+	out.write(_freestream_values.second);
+	out.write(_impulse_sum.first);
+	out.write(_impulse_sum.second);
+	out.write(_freestream_sum.first);
+	out.write(_freestream_sum.second);
+
+	out.write(size_t(_correlators.size()));
+	for (const Correlator& correlator : _correlators)
+	  correlator.saveState(out);
+      }
+
+      //! \brief Restores the data written by saveState.
+      template<class Archive>
+      void loadState(Archive& in)
+      {
+	in.read(_sample_time);
+	in.read(_current_time);
+	in.read(_length);
+	in.read(_scaling);
+	in.read(_freestream_values.first);
+	in.read(_freestream_values.second);
+	in.read(_impulse_sum.first);
+	in.read(_impulse_sum.second);
+	in.read(_freestream_sum.first);
+	in.read(_freestream_sum.second);
+
+	size_t correlators;
+	in.read(correlators);
+	//The sample time and length are overwritten by loadState
+	_correlators.assign(correlators, Correlator(1, 1));
+	for (Correlator& correlator : _correlators)
+	  correlator.loadState(in);
+      }
 
     protected:
       double _sample_time;
@@ -82,6 +82,33 @@ namespace magnet {
       
       T current() const { return _current_value; }
 
+      /*! \brief Writes the averages to an archive (e.g., a
+          dynamo::CheckpointWriter), which must provide write() for T
+          and double.
+       */
+      template<class Archive>
+      void saveState(Archive& out) const
+      {
+	out.write(_current_value);
+	out.write(_zero_moment);
+	out.write(_first_moment);
+	out.write(_second_moment);
+	out.write(_min);
+	out.write(_max);
+      }
+
+      //! \brief Restores the averages written by saveState.
+      template<class Archive>
+      void loadState(Archive& in)
+      {
+	in.read(_current_value);
+	in.read(_zero_moment);
+	in.read(_first_moment);
+	in.read(_second_moment);
+	in.read(_min);
+	in.read(_max);
+      }
+
     protected:
       T _current_value;
       double _zero_moment;
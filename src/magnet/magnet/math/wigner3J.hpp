@@ -21,7 +21,7 @@
 
 namespace magnet {
   namespace math {
-    double wignerThreej(const int & la, const int & lb, 
+    inline double wignerThreej(const int & la, const int & lb, 
 			const int & lc, const int & ma, 
 			const int & mb, const int & mc)
     {
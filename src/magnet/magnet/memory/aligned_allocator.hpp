@@ -0,0 +1,87 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace magnet {
+  namespace memory {
+    /*! \brief An STL allocator which returns memory aligned to a
+      fixed boundary.
+
+      The default allocators only guarantee alignment suitable for the
+      fundamental types (typically 16 bytes). Large allocations
+      (served by mmap in glibc) are then offset from a page boundary
+      by the malloc header, so an array of cache-line sized elements
+      will have every element straddling two cache lines. Using this
+      allocator with \p Alignment set to the cache line size makes
+      each element of such an array occupy exactly one line.
+
+      \tparam T The type being allocated.
+      \tparam Alignment The required alignment in bytes (must be a
+      power of two and a multiple of sizeof(void*)).
+     */
+    template<class T, size_t Alignment = 64>
+    class AlignedAllocator
+    {
+    public:
+      typedef T value_type;
+      typedef T* pointer;
+      typedef const T* const_pointer;
+      typedef T& reference;
+      typedef const T& const_reference;
+      typedef size_t size_type;
+      typedef ptrdiff_t difference_type;
+
+      template<class U> struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+      AlignedAllocator() throw() {}
+
+      template<class U>
+      AlignedAllocator(const AlignedAllocator<U, Alignment>&) throw() {}
+
+      inline pointer allocate(size_type n, const void* = 0)
+      {
+	if (!n) return 0;
+	void* ptr(0);
+	if (posix_memalign(&ptr, Alignment, n * sizeof(T)))
+	  throw std::bad_alloc();
+	return static_cast<pointer>(ptr);
+      }
+
+      inline void deallocate(pointer p, size_type) throw() { free(p); }
+
+      inline size_type max_size() const throw() { return size_type(-1) / sizeof(T); }
+
+      template<class U, class... Args>
+      inline void construct(U* p, Args&&... args)
+      { ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+
+      template<class U>
+      inline void destroy(U* p) { p->~U(); }
+
+      template<class U>
+      inline bool operator==(const AlignedAllocator<U, Alignment>&) const throw() { return true; }
+
+      template<class U>
+      inline bool operator!=(const AlignedAllocator<U, Alignment>&) const throw() { return false; }
+    };
+  }
+}
@@ -0,0 +1,594 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file taskscheduler.hpp
+ * \brief Contains the definition of TaskScheduler, a work-stealing
+ * pool of threads.
+ */
+
+#pragma once
+
+#include <magnet/exception.hpp>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <chrono>
+#ifdef __linux__
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+namespace magnet {
+  namespace thread {
+    class TaskGroup;
+    class TaskScheduler;
+
+    /*! \brief A unit of work which may be run on a TaskScheduler.
+
+      Tasks are owned by the caller (usually they are on the stack)
+      and are run through a TaskGroup. The TaskScheduler only stores
+      pointers to them, so no memory is allocated per task. A task
+      must not be destroyed before the TaskGroup::wait() of its group
+      returns.
+     */
+    class Task
+    {
+    public:
+      Task(): _group(NULL) {}
+      Task(const Task&): _group(NULL) {}
+      virtual ~Task() {}
+
+      virtual void execute() = 0;
+
+    private:
+      friend class TaskScheduler;
+      friend class TaskGroup;
+      TaskGroup* _group;
+    };
+
+    /*! \brief A Task which calls a copy of the passed functor.
+     */
+    template<class F>
+    class FunctorTask: public Task
+    {
+    public:
+      FunctorTask(const F& func): _func(func) {}
+      virtual void execute() { _func(); }
+
+    private:
+      F _func;
+    };
+
+    namespace detail {
+      /*! \brief A fixed capacity, lock-free work-stealing deque
+	  (Chase and Lev, 2005).
+
+	  Only the owning thread may push and pop tasks, at the bottom
+	  of the deque. Any other thread may steal tasks from the top.
+       */
+      class WorkStealingDeque
+      {
+      public:
+	WorkStealingDeque(size_t capacity = 4096):
+	  _top(0), _bottom(0),
+	  _mask(capacity - 1),
+	  _buffer(new std::atomic<Task*>[capacity])
+	{
+	  if (capacity & _mask)
+	    M_throw() << "The capacity of the WorkStealingDeque must be a power of two";
+	}
+
+	//! \brief Push a task, returns false if the deque is full.
+	bool push(Task* task)
+	{
+	  const int64_t b = _bottom.load(std::memory_order_relaxed);
+	  const int64_t t = _top.load(std::memory_order_acquire);
+	  if (b - t > int64_t(_mask))
+	    return false;
+
+	  _buffer[b & _mask].store(task, std::memory_order_relaxed);
+	  _bottom.store(b + 1, std::memory_order_release);
+	  return true;
+	}
+
+	//! \brief Pop the most recently pushed task, or NULL if empty.
+	Task* pop()
+	{
+	  const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+	  _bottom.store(b, std::memory_order_relaxed);
+	  std::atomic_thread_fence(std::memory_order_seq_cst);
+	  int64_t t = _top.load(std::memory_order_relaxed);
+
+	  if (t > b)
+	    {
+	      //Empty
+	      _bottom.store(b + 1, std::memory_order_relaxed);
+	      return NULL;
+	    }
+
+	  Task* task = _buffer[b & _mask].load(std::memory_order_relaxed);
+	  if (t == b)
+	    {
+	      //The last task, race any thieves for it
+	      if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		task = NULL;
+	      _bottom.store(b + 1, std::memory_order_relaxed);
+	    }
+	  return task;
+	}
+
+	//! \brief Steal the oldest task, or NULL if empty or contended.
+	Task* steal()
+	{
+	  int64_t t = _top.load(std::memory_order_acquire);
+	  std::atomic_thread_fence(std::memory_order_seq_cst);
+	  const int64_t b = _bottom.load(std::memory_order_acquire);
+	  if (t >= b) return NULL;
+
+	  Task* task = _buffer[t & _mask].load(std::memory_order_relaxed);
+	  if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+	    return NULL;
+	  return task;
+	}
+
+      private:
+	WorkStealingDeque(const WorkStealingDeque&);
+	WorkStealingDeque& operator=(const WorkStealingDeque&);
+
+	alignas(64) std::atomic<int64_t> _top;
+	alignas(64) std::atomic<int64_t> _bottom;
+	alignas(64) const int64_t _mask;
+	std::unique_ptr<std::atomic<Task*>[]> _buffer;
+      };
+
+      //! \brief Destroys and frees a WorkStealingDeque made by makeWorkStealingDeque.
+      struct WorkStealingDequeDeleter
+      {
+	void operator()(WorkStealingDeque* deque) const
+	{
+	  deque->~WorkStealingDeque();
+	  free(deque);
+	}
+      };
+
+      typedef std::unique_ptr<WorkStealingDeque, WorkStealingDequeDeleter> WorkStealingDequePtr;
+
+      /*! \brief Allocates a WorkStealingDeque on a cache line.
+
+	  Before C++17, new does not respect the alignment of
+	  over-aligned types, so the members of the deque would not be
+	  guaranteed their own cache lines.
+       */
+      inline WorkStealingDequePtr makeWorkStealingDeque()
+      {
+	void* memory = NULL;
+	if (posix_memalign(&memory, alignof(WorkStealingDeque), sizeof(WorkStealingDeque)))
+	  throw std::bad_alloc();
+
+	try {
+	  return WorkStealingDequePtr(new (memory) WorkStealingDeque);
+	} catch (...) {
+	  free(memory);
+	  throw;
+	}
+      }
+
+      //! \brief Identifies the TaskScheduler worker running on a thread.
+      struct WorkerID
+      {
+	const TaskScheduler* scheduler;
+	size_t index;
+	uint32_t random;
+      };
+
+      inline WorkerID& currentWorker()
+      {
+	static thread_local WorkerID id = {NULL, 0, 0x9E3779B9u};
+	return id;
+      }
+    }
+
+    /*! \brief A set of Task-s which are waited on together.
+
+      A worker which waits on the group runs pending tasks (of any
+      group) until all of the tasks of the group are complete, so
+      groups may be nested inside tasks without blocking the
+      workers. The first exception thrown by a task of the group is
+      rethrown by wait().
+     */
+    class TaskGroup
+    {
+    public:
+      TaskGroup(TaskScheduler& scheduler):
+	_scheduler(scheduler),
+	_pending(0)
+      {}
+
+      //! \brief Waits for the outstanding tasks, discarding any exception.
+      ~TaskGroup() { waitPending(); }
+
+      //! \brief Queues a task, which must outlive the call to wait().
+      inline void run(Task& task);
+
+      //! \brief Waits for all tasks of the group.
+      void wait()
+      {
+	waitPending();
+
+	if (_exception)
+	  {
+	    std::exception_ptr error = _exception;
+	    _exception = std::exception_ptr();
+	    std::rethrow_exception(error);
+	  }
+      }
+
+    private:
+      friend class TaskScheduler;
+
+      TaskGroup(const TaskGroup&);
+      TaskGroup& operator=(const TaskGroup&);
+
+      inline void waitPending();
+
+      void setException(std::exception_ptr error)
+      {
+	std::lock_guard<std::mutex> lock(_exceptionMutex);
+	if (!_exception) _exception = error;
+      }
+
+      TaskScheduler& _scheduler;
+      std::atomic<size_t> _pending;
+      std::mutex _exceptionMutex;
+      std::exception_ptr _exception;
+    };
+
+    /*! \brief A pool of worker threads which execute Task-s using work
+      stealing.
+
+      Each worker has its own lock-free deque. Tasks spawned by a
+      worker are pushed onto its own deque and run in last-in
+      first-out order, while idle workers steal the oldest tasks from
+      the other deques. Tasks spawned by threads outside the pool
+      (e.g., the main thread) are placed on a shared, locked queue
+      and the spawning thread only waits for them. Workers which find
+      no work spin briefly and then sleep until more tasks are
+      spawned.
+
+      With no worker threads, tasks are run as soon as they are
+      spawned.
+     */
+    class TaskScheduler
+    {
+    public:
+      TaskScheduler():
+	_injectedCount(0),
+	_epoch(0),
+	_sleepers(0),
+	_stop(false)
+      {}
+
+      ~TaskScheduler() { stop(); }
+
+      /*! \brief Set the number of worker threads.
+
+	All existing workers are stopped before the new ones are
+	started, so this must not be called while tasks are
+	outstanding.
+
+	\param pin If true, worker i is pinned to the i-th logical
+	CPU (modulo the number of CPUs). This is only supported on
+	Linux, elsewhere the flag is ignored.
+       */
+      void setThreadCount(size_t count, bool pin = false)
+      {
+	stop();
+	_stop = false;
+
+	_deques.clear();
+	for (size_t i(0); i < count; ++i)
+	  _deques.push_back(detail::makeWorkStealingDeque());
+
+	for (size_t i(0); i < count; ++i)
+	  _threads.push_back(std::thread(&TaskScheduler::workerLoop, this, i, pin));
+      }
+
+      size_t getThreadCount() const { return _threads.size(); }
+
+      /*! \brief Calls func(b, e) on sub-ranges [b, e) which cover
+	[begin, end), in parallel.
+
+	The range is split recursively in half until the sub-ranges
+	are no longer than grain. Idle workers steal the largest
+	remaining halves, so the load is balanced automatically. A
+	grain of zero picks one which gives roughly eight sub-ranges
+	per worker.
+       */
+      template<class F>
+      void parallel_for(size_t begin, size_t end, const F& func, size_t grain = 0)
+      {
+	if (end <= begin) return;
+
+	if (!grain)
+	  grain = (end - begin) / (8 * std::max(getThreadCount(), size_t(1))) + 1;
+
+	if (_threads.empty() || (end - begin <= grain))
+	  {
+	    func(begin, end);
+	    return;
+	  }
+
+	splitRange(begin, end, grain, func);
+      }
+
+    private:
+      friend class TaskGroup;
+
+      TaskScheduler(const TaskScheduler&);
+      TaskScheduler& operator=(const TaskScheduler&);
+
+      template<class F>
+      class RangeTask: public Task
+      {
+      public:
+	RangeTask(TaskScheduler& scheduler, size_t begin, size_t end, size_t grain, const F& func):
+	  _scheduler(scheduler), _begin(begin), _end(end), _grain(grain), _func(func)
+	{}
+
+	virtual void execute() { _scheduler.splitRange(_begin, _end, _grain, _func); }
+
+      private:
+	TaskScheduler& _scheduler;
+	const size_t _begin, _end, _grain;
+	const F& _func;
+      };
+
+      template<class F>
+      void splitRange(size_t begin, size_t end, size_t grain, const F& func)
+      {
+	if (end - begin <= grain)
+	  {
+	    func(begin, end);
+	    return;
+	  }
+
+	//Offer the upper half to the thieves and carry on with the lower
+	const size_t mid = begin + (end - begin) / 2;
+	TaskGroup group(*this);
+	RangeTask<F> upper(*this, mid, end, grain, func);
+	group.run(upper);
+	splitRange(begin, mid, grain, func);
+	group.wait();
+      }
+
+      void spawn(Task& task)
+      {
+	detail::WorkerID& id = detail::currentWorker();
+	if (id.scheduler == this)
+	  {
+	    if (!_deques[id.index]->push(&task))
+	      {
+		//The deque is full, just run the task now
+		execute(&task);
+		return;
+	      }
+	  }
+	else if (_threads.empty())
+	  {
+	    //No workers, so run the task immediately
+	    execute(&task);
+	    return;
+	  }
+	else
+	  {
+	    std::lock_guard<std::mutex> lock(_injectedMutex);
+	    _injected.push_back(&task);
+	    ++_injectedCount;
+	  }
+
+	notify();
+      }
+
+      /*! \brief Runs pending tasks on the calling worker until the
+	  group is complete.
+
+	  Threads outside the pool only wait, as any task they ran
+	  would place its children on the shared queue, which is
+	  processed in first-in first-out order and would recurse
+	  without bound.
+       */
+      void waitFor(const TaskGroup& group)
+      {
+	const detail::WorkerID& id = detail::currentWorker();
+	const bool worker = (id.scheduler == this);
+
+	size_t spins(0);
+	while (group._pending.load(std::memory_order_acquire))
+	  {
+	    if (worker)
+	      if (Task* task = findTask(id.index))
+		{
+		  execute(task);
+		  continue;
+		}
+
+	    if (++spins < 4096)
+	      std::this_thread::yield();
+	    else
+	      std::this_thread::sleep_for(std::chrono::microseconds(50));
+	  }
+      }
+
+      void execute(Task* task)
+      {
+	TaskGroup* group = task->_group;
+	try { task->execute(); }
+	catch (...) { group->setException(std::current_exception()); }
+	//The task may be destroyed as soon as the count is decremented
+	group->_pending.fetch_sub(1, std::memory_order_acq_rel);
+      }
+
+      /*! \brief Looks for a task in the workers own deque, then the
+	  shared queue, then the other deques.
+
+	  \param self The index of the calling worker, or
+	  _deques.size() if it is not a worker of this scheduler.
+       */
+      Task* findTask(size_t self)
+      {
+	if (self < _deques.size())
+	  if (Task* task = _deques[self]->pop())
+	    return task;
+
+	if (_injectedCount.load())
+	  {
+	    std::lock_guard<std::mutex> lock(_injectedMutex);
+	    if (!_injected.empty())
+	      {
+		Task* task = _injected.front();
+		_injected.pop_front();
+		--_injectedCount;
+		return task;
+	      }
+	  }
+
+	const size_t count = _deques.size();
+	if (!count) return NULL;
+
+	//Start the search for a victim at a random worker
+	uint32_t& random = detail::currentWorker().random;
+	random ^= random << 13;
+	random ^= random >> 17;
+	random ^= random << 5;
+	const size_t start = random % count;
+	for (size_t i(0); i < count; ++i)
+	  {
+	    const size_t victim = (start + i) % count;
+	    if (victim != self)
+	      if (Task* task = _deques[victim]->steal())
+		return task;
+	  }
+
+	return NULL;
+      }
+
+      void notify()
+      {
+	_epoch.fetch_add(1);
+	if (_sleepers.load())
+	  {
+	    std::lock_guard<std::mutex> lock(_sleepMutex);
+	    _wakeup.notify_one();
+	  }
+      }
+
+      void workerLoop(size_t index, bool pin)
+      {
+	detail::WorkerID& id = detail::currentWorker();
+	id.scheduler = this;
+	id.index = index;
+	id.random = 0x9E3779B9u * uint32_t(index + 1);
+
+#ifdef __linux__
+	if (pin)
+	  {
+	    cpu_set_t cpus;
+	    CPU_ZERO(&cpus);
+	    CPU_SET(index % std::max(std::thread::hardware_concurrency(), 1u), &cpus);
+	    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+	  }
+#endif
+
+	const size_t spinLimit = 64;
+	size_t spins(0);
+	while (!_stop.load())
+	  {
+	    const size_t epoch = _epoch.load();
+	    if (Task* task = findTask(index))
+	      {
+		execute(task);
+		spins = 0;
+		continue;
+	      }
+
+	    if (++spins < spinLimit)
+	      {
+		std::this_thread::yield();
+		continue;
+	      }
+
+	    //Sleep until something is spawned after the search above
+	    std::unique_lock<std::mutex> lock(_sleepMutex);
+	    ++_sleepers;
+	    while ((_epoch.load() == epoch) && !_stop.load())
+	      _wakeup.wait(lock);
+	    --_sleepers;
+	    spins = 0;
+	  }
+
+	id.scheduler = NULL;
+      }
+
+      void stop()
+      {
+	{
+	  std::lock_guard<std::mutex> lock(_sleepMutex);
+	  _stop = true;
+	}
+	_wakeup.notify_all();
+
+	for (std::thread& thread : _threads)
+	  thread.join();
+	_threads.clear();
+      }
+
+      std::vector<std::thread> _threads;
+      std::vector<detail::WorkStealingDequePtr> _deques;
+
+      std::mutex _injectedMutex;
+      std::deque<Task*> _injected;
+      std::atomic<size_t> _injectedCount;
+
+      std::mutex _sleepMutex;
+      std::condition_variable _wakeup;
+      //! \brief Incremented every time a task is spawned.
+      std::atomic<size_t> _epoch;
+      std::atomic<size_t> _sleepers;
+      std::atomic<bool> _stop;
+    };
+
+    inline void
+    TaskGroup::run(Task& task)
+    {
+      task._group = this;
+      _pending.fetch_add(1, std::memory_order_relaxed);
+      _scheduler.spawn(task);
+    }
+
+    inline void
+    TaskGroup::waitPending()
+    { _scheduler.waitFor(*this); }
+  }
+}
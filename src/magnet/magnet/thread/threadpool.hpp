@@ -20,207 +20,124 @@
 
 #pragma once
 
-#include <sstream>
-#include <iostream>
-
-#include <magnet/thread/threadgroup.hpp>
-#include <magnet/thread/taskQueue.hpp>
+#include <magnet/thread/taskscheduler.hpp>
+#include <magnet/exception.hpp>
+#include <functional>
+#include <deque>
+#include <vector>
 #include <mutex>
-#include <condition_variable>
 
 namespace magnet {
   namespace thread {
     /*! \brief A class providing a pool of worker threads that will
       execute "tasks" pushed to it.
+
+      The tasks are std::function objects, which are run on a
+      TaskScheduler. Fine-grained parallel work should use
+      parallel_for (or the TaskScheduler directly) instead, as it does
+      not copy or allocate a functor for each task.
       
       This class will also run in 0 thread mode, where the controlling
-      process will execute the tasks when it enters the
-      ThreadPool::wait() function.
+      process executes each task as it is queued.
      */
-    class ThreadPool : public TaskQueue
+    class ThreadPool
     {	
     private:
-      volatile bool _exception_flag;
-      std::ostringstream _exception_data;
-      
       ThreadPool (const ThreadPool&);
       ThreadPool& operator = (const ThreadPool&);
-  
-      /*! \brief This mutex is to control access to write that an exception has occurred.
-       */
-      std::mutex _exception_mutex;
 
-      /*! \brief Triggered every time a thread becomes available, to
-        notify the mother thread stuck in the wait() function.
-       */
-      std::condition_variable _threadAvailable_condition;
+      typedef FunctorTask<std::function<void()> > QueuedTask;
+
+      TaskScheduler _scheduler;
 
-      /*! \brief Triggered to wake threads when jobs are added to the queue.
+      /*! \brief The queued tasks, a deque is used as it does not move
+        the existing tasks as it grows.
        */
-      std::condition_variable _need_thread_mutex;
+      std::deque<QueuedTask> _queuedTasks;
+      std::mutex _queue_mutex;
 
-      magnet::thread::ThreadGroup _threads;
+      TaskGroup _group;
 
-      volatile size_t _idlingThreads;
-      volatile bool _stop_flag;
+      /*! \brief Copies the functor into the task store.
+
+        The lock is not held while the task runs, as it may be run
+        immediately if there are no threads.
+       */
+      inline Task& storeTask(const std::function<void()>& func)
+      {
+	std::lock_guard<std::mutex> lock(_queue_mutex);
+	_queuedTasks.push_back(QueuedTask(func));
+	return _queuedTasks.back();
+      }
 
     public:  
       /*! \brief Default Constructor
        
         This initialises the pool to 0 threads
        */
-      inline ThreadPool():
-	_exception_flag(false),
-	_idlingThreads(0),
-	_stop_flag(false)
-      {}
+      inline ThreadPool(): _group(_scheduler) {}
       
       /*! \brief Set the number of threads in the pool
        
-        This creates the specified amount of threads to populate the
-        pool. When lowering the number of threads this pool kills ALL
-        threads, but waits for all their current tasks to complete
-        first, then repopulates the pool.
+        The existing threads are stopped and the pool is
+        repopulated. This must not be called while tasks are queued.
+
+        \param pin Pin each thread to its own logical CPU (see
+        TaskScheduler::setThreadCount).
        */
-      inline void setThreadCount(size_t x)
+      inline void setThreadCount(size_t x, bool pin = false)
       { 
-	if (x == _threads.size()) return;
-	
-	if (x < _threads.size())
-	  {
-	    //Stop all threads as we're shrinking our thread pool size
-	    stop();
-	    //All threads are dead, reset the kill switch
-	    _stop_flag = false;
-	  }
-	
-	//Add the required number of threads
-	for (size_t i=_threads.size(); i < x; ++i)
-	  _threads.create_thread(std::function<void()>(std::bind(&ThreadPool::beginThread, this)));
+	if ((x == _scheduler.getThreadCount()) && !pin) return;
+	_scheduler.setThreadCount(x, pin);
       }
 
       /*! \brief The current number of threads in the pool */
-      inline size_t getThreadCount() const { return _threads.size(); }
+      inline size_t getThreadCount() const { return _scheduler.getThreadCount(); }
+
+      /*! \brief The TaskScheduler which runs the tasks of the pool. */
+      inline TaskScheduler& getScheduler() { return _scheduler; }
 
       //Actual queuer
       inline void queueTask(std::function<void()>&& threadfunc)
       {
-	TaskQueue::queueTask(threadfunc);
-	_need_thread_mutex.notify_all();
+	_group.run(storeTask(threadfunc));
       }
 
       //Actual queuer
       inline void queueTasks(std::vector<std::function<void()> >& threadfuncs)
       {
-	TaskQueue::queueTasks(threadfuncs);
-	_need_thread_mutex.notify_all();
+	for (const auto& func : threadfuncs)
+	  _group.run(storeTask(func));
+	threadfuncs.clear();
       }
+
+      /*! \brief Calls func(b, e) on sub-ranges of [begin, end) in
+        parallel (see TaskScheduler::parallel_for).
+       */
+      template<class F>
+      inline void parallel_for(size_t begin, size_t end, const F& func, size_t grain = 0)
+      { _scheduler.parallel_for(begin, end, func, grain); }
   
       /*! \brief Destructor
        
-        Join all threads in the pool and wait until they are
-        terminated.
+        Waits for the queued tasks, then joins all threads in the pool.
        */
-      inline ~ThreadPool() throw() { stop(); }
+      inline ~ThreadPool() throw() {}
 
       /*! \brief Wait for all tasks to complete.
-       
-        If there are no threads in the pool then this function will
-        actually make the waiting/mother process perform the tasks.
        */
       inline void wait()
       {
-	if (_threads.size())
-	  {
-	    //We are in threaded mode! Wait until all tasks are gone
-	    //and all threads are idling
-	    std::unique_lock<std::mutex> lock1(_queue_mutex);      
-	    while (!_waitingFunctors.empty() 
-		   || (_idlingThreads != _threads.size()))
-	      _threadAvailable_condition.wait(lock1);
-	  }
-	else
+	try { _group.wait(); }
+	catch (std::exception& cep)
 	  {
-	    //Non threaded mode
-	    while (!_waitingFunctors.empty())
-	      {
-		_waitingFunctors.front()();
-		_waitingFunctors.pop();
-	      }
+	    _queuedTasks.clear();
+	    M_throw() << "Thread Exception found while waiting for tasks/threads to finish"
+		      << "\nTHREAD: Task threw an exception:-" << cep.what();
 	  }
-	
-	if (_exception_flag) 
-	  M_throw() << "Thread Exception found while waiting for tasks/threads to finish"
-		    << _exception_data.str();
-      }
 
-      inline size_t getIdleThreadCount() { return _idlingThreads; }
-  
-    private:
-      /*! \brief Thread worker loop, called by the threads beginThreadFunc.
-       */
-      inline void beginThread()
-      {
-	try
-	  {
-	    std::unique_lock<std::mutex> lock1(_queue_mutex);
-	    
-	    while (!_stop_flag)
-	      {
-		if (_waitingFunctors.empty())
-		  {
-		    ++_idlingThreads;
-		    //Let whoever is waiting know that the thread is now available
-		    _threadAvailable_condition.notify_all();
-		    //And send it to sleep
-		    _need_thread_mutex.wait(lock1);
-		    --_idlingThreads;
-		    continue;
-		  }
-		
-		std::function<void()> func = _waitingFunctors.front();
-		_waitingFunctors.pop();
-		
-		lock1.unlock();
-		
-		try { func(); }
-		catch(std::exception& cep)
-		  {
-		    //Mark the main process to throw an exception as soon as possible
-		    std::lock_guard<std::mutex> lock2(_exception_mutex);
-		    
-		    _exception_data << "\nTHREAD: Task threw an exception:-"
-				    << cep.what();
-		    
-		    _exception_flag = true;
-		  }
-		lock1.lock();
-	      }
-	  }
-	catch (std::exception& p)
-	  {
-	    std::cout << "\nTHREAD :Catastrophic Failure of thread!!! System will Hang, Aborting!"
-		      << p.what();
-	    throw;
-	  }
-      }
-      
-      /*! \brief Halt the threadpool and terminate all the threads.
-       */
-      inline void stop()
-      {
-	// _stop_flag must be set to true in a critical section.  Otherwise
-	// it is possible for a thread to miss notify_all and never
-	// terminate.
-	{
-	  std::unique_lock<std::mutex> lock1(_queue_mutex);
-	  _stop_flag = true;       
-	}
-	
-	_need_thread_mutex.notify_all();
-	_threads.join_all();
+	_queuedTasks.clear();
       }
-
     };
   }
 }
@@ -0,0 +1,90 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <magnet/containers/append_only_array.hpp>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+int main()
+{
+  //Check the elements land in the right place across the block
+  //boundaries
+  magnet::containers::AppendOnlyArray<std::size_t, 4> array;
+  for (std::size_t i(0); i < 10000; ++i)
+    array.push_back(i);
+
+  if (array.size() != 10000)
+    {
+      std::cerr << "The array has " << array.size() << " elements, expected 10000" << std::endl;
+      return 1;
+    }
+
+  for (std::size_t i(0); i < array.size(); ++i)
+    if (array[i] != i)
+      {
+	std::cerr << "Element " << i << " is " << array[i] << std::endl;
+	return 1;
+      }
+
+  if ((array.front() != 0) || (array.back() != 9999))
+    {
+      std::cerr << "front() or back() are incorrect" << std::endl;
+      return 1;
+    }
+
+  array.clear();
+  if (!array.empty())
+    {
+      std::cerr << "The array is not empty after clear()" << std::endl;
+      return 1;
+    }
+
+  //One thread appends while several others read the elements below
+  //the size they see
+  const std::size_t N = 1000000;
+  std::atomic<bool> failed(false);
+  std::vector<std::thread> readers;
+  for (std::size_t t(0); t < 3; ++t)
+    readers.push_back(std::thread([&]() {
+	  std::size_t seen = 0;
+	  while (seen < N)
+	    {
+	      const std::size_t size = array.size();
+	      for (std::size_t i(seen); i < size; ++i)
+		if (array[i] != i)
+		  failed = true;
+	      seen = size;
+	    }
+	}));
+
+  for (std::size_t i(0); i < N; ++i)
+    array.push_back(i);
+
+  for (std::thread& reader : readers)
+    reader.join();
+
+  if (failed)
+    {
+      std::cerr << "A reader saw an incomplete element" << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
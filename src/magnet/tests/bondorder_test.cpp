@@ -0,0 +1,100 @@
+#include <magnet/math/bondorder.hpp>
+#include <boost/math/special_functions/spherical_harmonic.hpp>
+#include <iostream>
+#include <random>
+#include <cstdlib>
+
+std::mt19937 RNG;
+std::normal_distribution<double> normal_dist(0, 1);
+using namespace magnet::math;
+
+Vector random_unit_vec() {
+  Vector vec(normal_dist(RNG), normal_dist(RNG), normal_dist(RNG));
+  return vec/vec.nrm();
+}
+
+int main(int argc, char *argv[])
+{
+  RNG.seed();
+  const int maxl = 13;
+  const double errlvl = 1e-10;
+  BondOrderParameters bop(maxl);
+  typedef BondOrderParameters::complex complex;
+
+  std::cout << "BondOrderParameters::addBond()" << std::endl;
+  for (size_t i(0); i < 10000; ++i)
+    {
+      const Vector rij = random_unit_vec();
+      std::vector<complex> qlm(bop.size(), complex(0, 0));
+      bop.addBond(rij, &qlm[0]);
+
+      const double theta = std::acos(rij[2]);
+      const double phi = std::atan2(rij[1], rij[0]);
+      for (int l(0); l < maxl; ++l)
+	for (int m(-l); m <= l; ++m)
+	  {
+	    const complex err = qlm[BondOrderParameters::index(l, m)]
+	      - boost::math::spherical_harmonic(l, m, theta, phi);
+	    if (std::abs(err) > errlvl)
+	      {
+		std::cout << "test " << i << ": Y_" << l << "," << m << " error " << err << std::endl;
+		return EXIT_FAILURE;
+	      }
+	  }
+    }
+
+  std::cout << "BondOrderParameters::wigner3j()" << std::endl;
+  for (int l(0); l < maxl; ++l)
+    for (int m1(-l); m1 <= l; ++m1)
+      for (int m2(-l); m2 <= l; ++m2)
+	{
+	  const double expected = (std::abs(m1 + m2) <= l) ? wignerThreej(l, l, l, m1, m2, -(m1 + m2)) : 0;
+	  if (std::abs(bop.wigner3j(l, m1, m2) - expected) > errlvl)
+	    {
+	      std::cout << "l=" << l << " m1=" << m1 << " m2=" << m2 << ": " << bop.wigner3j(l, m1, m2)
+			<< " != " << expected << std::endl;
+	      return EXIT_FAILURE;
+	    }
+	}
+
+  std::cout << "BondOrderParameters::Q() and W() of an FCC crystal" << std::endl;
+  {
+    //The 12 nearest neighbours of an FCC lattice, rotated to check
+    //the parameters are invariant
+    std::vector<complex> qlm(bop.size(), complex(0, 0));
+    const Vector axis = random_unit_vec();
+    const double angle = 0.7;
+    const Vector v1 = axis ^ Vector(1, 0, 0);
+    const Vector u = v1 / v1.nrm();
+    const Vector w = axis ^ u;
+    size_t count(0);
+    for (int i(-1); i <= 1; ++i)
+      for (int j(-1); j <= 1; ++j)
+	for (int k(-1); k <= 1; ++k)
+	  if (std::abs(i) + std::abs(j) + std::abs(k) == 2)
+	    {
+	      Vector r(i, j, k);
+	      r /= r.nrm();
+	      //Rotate r about the axis
+	      const Vector rotated = axis * (axis | r)
+		+ (u * (u | r) + w * (w | r)) * std::cos(angle)
+		+ (axis ^ r) * std::sin(angle);
+	      bop.addBond(rotated, &qlm[0]);
+	      ++count;
+	    }
+
+    const double Q4 = bop.Q(4, &qlm[0], 1.0 / count);
+    const double Q6 = bop.Q(6, &qlm[0], 1.0 / count);
+    const double W4 = bop.W(4, &qlm[0]);
+    const double W6 = bop.W(6, &qlm[0]);
+    std::cout << "Q4=" << Q4 << " Q6=" << Q6 << " W4=" << W4 << " W6=" << W6 << std::endl;
+    if ((std::abs(Q4 - 0.19094) > 1e-4) || (std::abs(Q6 - 0.57452) > 1e-4)
+	|| (std::abs(W4 + 0.159317) > 1e-5) || (std::abs(W6 + 0.013161) > 1e-5))
+      {
+	std::cout << "The FCC order parameters are incorrect" << std::endl;
+	return EXIT_FAILURE;
+      }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+#include <magnet/containers/bvh.hpp>
+#include <magnet/intersection/ray_cube.hpp>
+#include <magnet/intersection/parabola_cube.hpp>
+#include <iostream>
+#include <random>
+#include <cstdlib>
+
+std::mt19937 RNG;
+std::uniform_real_distribution<double> dist01(0, 1);
+std::normal_distribution<double> normal_dist(0, 1);
+using namespace magnet::math;
+
+Vector random_vec(double scale) {
+  return Vector(normal_dist(RNG), normal_dist(RNG), normal_dist(RNG)) * scale;
+}
+
+//! \brief Finds the entry time by stepping along the trajectory.
+double sampled_entry(const Vector& T, const Vector& D, const Vector& G, const Vector& C, double tmax, size_t steps)
+{
+  for (size_t i(0); i <= steps; ++i)
+    {
+      const double t = tmax * i / steps;
+      const Vector pos = T + D * t + G * (0.5 * t * t);
+      if ((std::abs(pos[0]) <= 0.5 * C[0]) && (std::abs(pos[1]) <= 0.5 * C[1]) && (std::abs(pos[2]) <= 0.5 * C[2]))
+	return t;
+    }
+  return HUGE_VAL;
+}
+
+int main(int argc, char *argv[])
+{
+  RNG.seed();
+  const size_t testcount = 10000;
+  const double tmax = 10;
+  const size_t steps = 100000;
+  //The tolerance on the entry time from the stepping
+  const double errlvl = 2 * tmax / steps;
+
+  std::cout << "ray_AAcube_entry() and parabola_AAcube_entry()" << std::endl;
+  for (size_t i(0); i < testcount; ++i)
+    {
+      const Vector T = random_vec(3);
+      const Vector D = random_vec(1);
+      const Vector G = (i % 2) ? random_vec(1) : Vector(0, 0, 0);
+      const Vector C(0.1 + 2 * dist01(RNG), 0.1 + 2 * dist01(RNG), 0.1 + 2 * dist01(RNG));
+
+      const double expected = sampled_entry(T, D, G, C, tmax, steps);
+      const double t = (i % 2) ? magnet::intersection::parabola_AAcube_entry(T, D, G, C)
+	: magnet::intersection::ray_AAcube_entry(T, D, C);
+
+      //The stepping may miss a short visit, so the calculated time
+      //may be earlier than the sampled one but never later
+      if (t > expected + errlvl)
+	{
+	  std::cout << "test " << i << ": entry time " << t << " but sampled " << expected << std::endl;
+	  return EXIT_FAILURE;
+	}
+
+      //The particle must be on or in the cube at the entry time
+      if (t != HUGE_VAL)
+	{
+	  const Vector pos = T + D * t + G * (0.5 * t * t);
+	  for (size_t iDim(0); iDim < 3; ++iDim)
+	    if (std::abs(pos[iDim]) > 0.5 * C[iDim] * (1 + 1e-8))
+	      {
+		std::cout << "test " << i << ": the entry point " << pos.toString() << " is not on the cube" << std::endl;
+		return EXIT_FAILURE;
+	      }
+	}
+    }
+
+  std::cout << "BVH::search()" << std::endl;
+  {
+    //Random small boxes, the first box hit by a ray is found both by
+    //a linear search and the hierarchy
+    const size_t N = 5000;
+    std::vector<std::pair<Vector, Vector> > boxes(N);
+    for (std::pair<Vector, Vector>& box : boxes)
+      {
+	box.first = random_vec(10);
+	box.second = box.first + Vector(dist01(RNG), dist01(RNG), dist01(RNG));
+      }
+
+    magnet::containers::BVH bvh;
+    bvh.build(N, [&](size_t i) { return boxes[i]; });
+
+    for (size_t i(0); i < 1000; ++i)
+      {
+	const Vector T = random_vec(10);
+	const Vector D = random_vec(1);
+	const Vector G = (i % 2) ? random_vec(0.1) : Vector(0, 0, 0);
+
+	auto entry = [&](const Vector& min, const Vector& max)
+	  { return magnet::intersection::parabola_AAcube_entry(T - 0.5 * (min + max), D, G, max - min); };
+
+	std::pair<double, size_t> linear(HUGE_VAL, 0);
+	for (size_t j(0); j < N; ++j)
+	  linear = std::min(linear, std::make_pair(entry(boxes[j].first, boxes[j].second), j));
+
+	std::pair<double, size_t> searched(HUGE_VAL, 0);
+	size_t visited(0);
+	bvh.search(entry, [&](size_t j)
+		   {
+		     ++visited;
+		     searched = std::min(searched, std::make_pair(entry(boxes[j].first, boxes[j].second), j));
+		   }, searched.first);
+
+	if (linear != searched)
+	  {
+	    std::cout << "test " << i << ": the hierarchy found box " << searched.second << " at " << searched.first
+		      << " but the linear search found box " << linear.second << " at " << linear.first << std::endl;
+	    return EXIT_FAILURE;
+	  }
+      }
+  }
+
+  return EXIT_SUCCESS;
+}
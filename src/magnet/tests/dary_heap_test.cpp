@@ -0,0 +1,96 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <magnet/containers/DaryHeap.hpp>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <algorithm>
+
+//Replays the same random sequence of pushes, pops, removals and
+//clears into a d-ary heap and a std::priority_queue and checks their
+//tops agree.
+template<std::size_t Arity>
+bool testArity()
+{
+  std::mt19937 RNG(Arity);
+  std::uniform_real_distribution<double> uniform(0, 1);
+
+  magnet::containers::DaryHeap<double, Arity> heap;
+  std::priority_queue<double, std::vector<double>, std::greater<double> > reference;
+
+  for (std::size_t i(0); i < 100000; ++i)
+    {
+      const double r = uniform(RNG);
+      if (r < 0.55)
+	{
+	  const double val = uniform(RNG);
+	  heap.push(val);
+	  reference.push(val);
+	}
+      else if (r < 0.998)
+	{
+	  if (!reference.empty())
+	    {
+	      heap.pop();
+	      reference.pop();
+	    }
+	}
+      else if (r < 0.999)
+	{
+	  const double cut = uniform(RNG);
+	  heap.remove_if([=](const double& val) { return val < cut; });
+	  std::vector<double> kept;
+	  for (; !reference.empty(); reference.pop())
+	    if (!(reference.top() < cut))
+	      kept.push_back(reference.top());
+	  for (const double& val : kept)
+	    reference.push(val);
+	}
+      else
+	{
+	  heap.clear();
+	  reference = std::priority_queue<double, std::vector<double>, std::greater<double> >();
+	}
+
+      if ((heap.size() != reference.size())
+	  || (!reference.empty() && (heap.top() != reference.top())))
+	{
+	  std::cout << Arity << "-ary heap differs from std::priority_queue at step " << i << std::endl;
+	  return false;
+	}
+
+      //The children of the root start a family of Arity elements,
+      //which should be aligned to its size (or a cache line)
+      const std::size_t alignment = std::min(std::size_t(64), Arity * sizeof(double));
+      if (!heap.empty() && (reinterpret_cast<std::uintptr_t>(&heap.top() + 1) % alignment))
+	{
+	  std::cout << Arity << "-ary heap's first family of children is not cache aligned" << std::endl;
+	  return false;
+	}
+    }
+
+  return true;
+}
+
+int main()
+{
+  return !(testArity<2>() && testArity<4>() && testArity<8>());
+}
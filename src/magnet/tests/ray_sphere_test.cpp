@@ -0,0 +1,79 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <magnet/intersection/ray_sphere.hpp>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+//Checks that each instruction set of the batched ray-sphere test
+//supported by this machine gives the same results as the scalar
+//test, including the remainder handling. A small tolerance is allowed
+//as the compiler may use fused multiply-adds in either.
+int main()
+{
+  using namespace magnet::intersection;
+
+  std::mt19937 RNG;
+  std::uniform_real_distribution<double> uniform(-2, 2);
+
+  const size_t N = 1000 + 7;
+  std::vector<double> Tx(N), Ty(N), Tz(N), Dx(N), Dy(N), Dz(N), r(N), t(N);
+
+  for (size_t i(0); i < N; ++i)
+    {
+      Tx[i] = uniform(RNG); Ty[i] = uniform(RNG); Tz[i] = uniform(RNG);
+      Dx[i] = uniform(RNG); Dy[i] = uniform(RNG); Dz[i] = uniform(RNG);
+      r[i] = 1 + 0.1 * uniform(RNG);
+    }
+
+  //A few special cases: touching/overlapping spheres and zero velocity
+  Tx[0] = 1; Ty[0] = 0; Tz[0] = 0; Dx[0] = -1; Dy[0] = 0; Dz[0] = 0; r[0] = 1;
+  Tx[1] = 0.5; Ty[1] = 0; Tz[1] = 0; Dx[1] = -1; Dy[1] = 0; Dz[1] = 0; r[1] = 1;
+  Dx[2] = 0; Dy[2] = 0; Dz[2] = 0;
+
+  const char* names[] = {"scalar", "AVX", "AVX-512"};
+  for (int level(RAY_SPHERE_SCALAR); level <= ray_sphere_bfc_support(); ++level)
+    {
+      std::cout << "Testing the " << names[level] << " batched ray_sphere_bfc" << std::endl;
+      std::fill(t.begin(), t.end(), 0);
+      ray_sphere_bfc(&Tx[0], &Ty[0], &Tz[0], &Dx[0], &Dy[0], &Dz[0], &r[0], &t[0], N, RaySphereSIMD(level));
+
+      size_t hits = 0;
+      for (size_t i(0); i < N; ++i)
+	{
+	  const double expected 
+	    = ray_sphere_bfc(magnet::math::Vector(Tx[i], Ty[i], Tz[i]),
+			     magnet::math::Vector(Dx[i], Dy[i], Dz[i]), r[i]);
+	  if (expected != HUGE_VAL) ++hits;
+	  if ((t[i] == HUGE_VAL) != (expected == HUGE_VAL)
+	      || ((expected != HUGE_VAL) && (std::abs(t[i] - expected) > 1e-12 * std::max(1.0, expected))))
+	    {
+	      std::cout << "Batched ray_sphere_bfc mismatch for ray " << i 
+			<< ", got " << t[i] << " expected " << expected << std::endl;
+	      return 1;
+	    }
+	}
+
+      if (!hits)
+	{ std::cout << "No intersections were tested" << std::endl; return 1; }
+    }
+
+  return 0;
+}
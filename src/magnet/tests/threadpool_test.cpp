@@ -1,6 +1,8 @@
 #include <iostream>
 #include <vector>
 #include <stdexcept>
+#include <chrono>
+#include <atomic>
 #include <magnet/thread/threadpool.hpp>
 
 std::vector<float> sums;
@@ -23,6 +25,68 @@ void function2(int i)
   sums[i] = sum;
 }
 
+//Recursive fork-join through nested TaskGroups
+size_t fib(magnet::thread::TaskScheduler& scheduler, size_t n)
+{
+  if (n < 2) return n;
+  if (n < 12) return fib(scheduler, n - 1) + fib(scheduler, n - 2);
+
+  size_t x(0);
+  magnet::thread::TaskGroup group(scheduler);
+  auto func = [&]() { x = fib(scheduler, n - 1); };
+  magnet::thread::FunctorTask<decltype(func)> task(func);
+  group.run(task);
+  const size_t y = fib(scheduler, n - 2);
+  group.wait();
+  return x + y;
+}
+
+double seconds(const std::chrono::steady_clock::time_point& start)
+{ return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+
+void testScheduler(magnet::thread::ThreadPool& pool)
+{
+  //parallel_for must cover the range exactly once
+  const size_t N = 1000000;
+  std::vector<int> hits(N, 0);
+  pool.parallel_for(0, N, [&](size_t begin, size_t end) { for (size_t i(begin); i < end; ++i) ++hits[i]; }, 64);
+  for (size_t i(0); i < N; ++i)
+    if (hits[i] != 1) throw std::runtime_error("parallel_for did not visit each index once");
+
+  if (fib(pool.getScheduler(), 25) != 75025)
+    throw std::runtime_error("Nested task groups gave the wrong result");
+
+  //Exceptions must be passed back to the waiting thread
+  bool caught = false;
+  try {
+    pool.parallel_for(0, 1000, [](size_t begin, size_t end) { if ((begin <= 500) && (500 < end)) throw std::runtime_error("Expected"); }, 1);
+  } catch (std::runtime_error&) {
+    caught = true;
+  }
+  if (!caught) throw std::runtime_error("parallel_for lost an exception");
+
+  //Compare the cost of fine-grained tasks through the queue and
+  //through parallel_for
+  const size_t tasks = 200000;
+  std::atomic<size_t> counter(0);
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (size_t i(0); i < tasks; ++i)
+    pool.queueTask([&counter]() { ++counter; });
+  pool.wait();
+  const double queueTime = seconds(start);
+
+  start = std::chrono::steady_clock::now();
+  pool.parallel_for(0, tasks, [&counter](size_t begin, size_t end) { counter += end - begin; }, 1);
+  const double forTime = seconds(start);
+
+  if (counter != 2 * tasks) throw std::runtime_error("Lost tasks in the benchmark");
+
+  std::cerr << pool.getThreadCount() << " threads: "
+	    << queueTime * 1e9 / tasks << " ns/task queued, "
+	    << forTime * 1e9 / tasks << " ns/task with parallel_for\n";
+}
+
 struct A
 {
   void memberFunc() { std::cerr << "Inside memberfunc\n"; }
@@ -94,6 +158,12 @@ int main()
 	}
     }
 
+  for (size_t threads : {0, 1, 2, 4})
+    {
+      pool.setThreadCount(threads);
+      testScheduler(pool);
+    }
+
   std::cerr << "Finished\n";
 
   return 0;
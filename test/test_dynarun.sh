@@ -17,6 +17,7 @@
 
 Dynarun="../bin/dynarun"
 Dynamod="../bin/dynamod"
+Dynatrajectory="../bin/dynatrajectory"
 
 #Next is the name of XML starlet
 Xml="xml"
@@ -29,6 +30,10 @@ if [ ! -x $Dynamod ]; then
     echo "Could not find dynamod, have you built it?"
 fi
 
+if [ ! -x $Dynatrajectory ]; then 
+    echo "Could not find dynatrajectory, have you built it?"
+fi
+
 which $Xml || Xml="xmlstarlet"
 
 which $Xml || `echo "Could not find XMLStarlet"; exit`
@@ -38,6 +43,7 @@ which gawk || `echo "Could not find gawk"; exit`
 #We create a local copy of the executables, so that recompilation won't break running tests
 cp $Dynamod ./dynamod
 cp $Dynarun ./dynarun
+cp $Dynatrajectory ./dynatrajectory
 
 function HS_replex_test {
     for i in $(seq 0 2); do
@@ -316,8 +322,16 @@ function cannon {
     cat tmp2.xml | \
 	$Xml ed -u '//Simulation/Scheduler/Sorter/@Type' -v "$2" \
 	> tmp.xml
+
+    #Optionally set the invalidation mode of the scheduler
+    if [ -n "$3" ]; then
+	cat tmp.xml | \
+	    $Xml ed -i '//Simulation/Scheduler' -t attr -n Invalidation -v "$3" \
+	    > tmp2.xml
+	mv tmp2.xml tmp.xml
+    fi
     
-    rm tmp2.xml
+    rm -f tmp2.xml
     
     ./dynarun -c 1000 tmp.xml &> run.log
     
@@ -342,6 +356,359 @@ function cannon {
 }
 
 
+function BinaryConfigTest {
+    #Converting a configuration to the binary format and back must
+    #not change it, and runs from either must be identical
+    > run.log
+
+    ./dynamod $1 -s 1 -o tmp.xml.bz2 &> run.log
+    ./dynamod tmp.xml.bz2 -o tmp.dynbin >> run.log 2>&1
+    ./dynamod tmp.dynbin -o tmp2.xml.bz2 >> run.log 2>&1
+
+    if ! diff <(bzcat tmp.xml.bz2) <(bzcat tmp2.xml.bz2) > /dev/null; then
+	echo "BinaryConfig $1 -: FAILED, the round trip changed the configuration"
+	exit 1
+    fi
+
+    ./dynarun -c 10000 tmp.xml.bz2 --out-data-file xml.out.xml.bz2 >> run.log 2>&1
+    ./dynarun -c 10000 tmp.dynbin --out-data-file bin.out.xml.bz2 >> run.log 2>&1
+
+    if [ -e xml.out.xml.bz2 ] && [ -e bin.out.xml.bz2 ] && \
+	[ "$(bzcat xml.out.xml.bz2 | $Xml sel -t -v '/OutputData/Misc/Duration/@Time')" == \
+	"$(bzcat bin.out.xml.bz2 | $Xml sel -t -v '/OutputData/Misc/Duration/@Time')" ]; then
+	echo "BinaryConfig $1 -: PASSED"
+    else
+	echo "BinaryConfig $1 -: FAILED, the runs differ"
+	exit 1
+    fi
+
+#Cleanup
+    rm -Rf tmp.xml.bz2 tmp.dynbin tmp2.xml.bz2 xml.out.xml.bz2 bin.out.xml.bz2 \
+	config.out.xml.bz2 run.log
+}
+
+function CheckpointTest {
+    #A run restarted from a checkpoint must continue exactly as the
+    #uninterrupted run would have. $1 are the dynamod options, $2 the
+    #length of the run (default 20000 events) and $3 the event count
+    #of the checkpoint (default 9000).
+    > run.log
+
+    ./dynamod $1 -s 1 -o tmp.xml.bz2 &> run.log
+    ./dynarun -c ${2:-20000} -s 3 tmp.xml.bz2 -o full.xml.bz2 \
+	--out-data-file full.out.xml.bz2 >> run.log 2>&1
+    ./dynarun -c ${3:-9000} -s 3 tmp.xml.bz2 -o half.xml.bz2 \
+	--checkpoint tmp.ckpt >> run.log 2>&1
+    ./dynarun -c ${2:-20000} half.xml.bz2 --restart tmp.ckpt -o restart.xml.bz2 \
+	--out-data-file restart.out.xml.bz2 >> run.log 2>&1
+
+    #The output plugins continue their averages from the checkpoint,
+    #so only the timing and memory usage may differ. The cell storage
+    #is run-time state kept in the checkpoint, so it must not be
+    #written into the configurations.
+    if [ -e full.xml.bz2 ] && [ -e restart.xml.bz2 ] && \
+	diff <(bzcat full.xml.bz2 | grep -v lastMFT) <(bzcat restart.xml.bz2 | grep -v lastMFT) > /dev/null && \
+	diff <(bzcat full.out.xml.bz2 | grep -v "<Timing\|<Memusage") \
+	<(bzcat restart.out.xml.bz2 | grep -v "<Timing\|<Memusage") > /dev/null && \
+	! bzcat half.xml.bz2 full.xml.bz2 | grep -q 'Storage='; then
+	echo "Checkpoint $1 -: PASSED"
+    else
+	echo "Checkpoint $1 -: FAILED, the restarted run differs"
+	exit 1
+    fi
+
+#Cleanup
+    rm -Rf tmp.xml.bz2 tmp.ckpt full.xml.bz2 half.xml.bz2 restart.xml.bz2 \
+	full.out.xml.bz2 restart.out.xml.bz2 config.out.xml.bz2 output.xml.bz2 run.log
+}
+
+function SameRunTest {
+    #Options which only change how the simulation is run (e.g., the
+    #particle order in memory) must give exactly the same result as a
+    #run without them. $1 are the dynamod options and $2 the dynarun
+    #options to test. $3, if given, is a sed script applied to the
+    #configuration dynamod writes.
+    > run.log
+
+    ./dynamod $1 -s 1 -o tmp.xml.bz2 &> run.log
+    if [ -n "$3" ]; then
+	bzcat tmp.xml.bz2 | sed -e "$3" | bzip2 > edited.xml.bz2
+	mv edited.xml.bz2 tmp.xml.bz2
+    fi
+    ./dynarun -c 20000 -s 3 tmp.xml.bz2 -o plain.xml.bz2 \
+	--out-data-file plain.out.xml.bz2 >> run.log 2>&1
+    ./dynarun -c 20000 -s 3 $2 tmp.xml.bz2 -o test.xml.bz2 \
+	--out-data-file test.out.xml.bz2 >> run.log 2>&1
+
+    if [ -e plain.xml.bz2 ] && [ -e test.xml.bz2 ] && \
+	diff <(bzcat plain.xml.bz2) <(bzcat test.xml.bz2) > /dev/null && \
+	[ "$(bzcat plain.out.xml.bz2 | $Xml sel -t -v '/OutputData/Misc/Duration/@Time')" == \
+	"$(bzcat test.out.xml.bz2 | $Xml sel -t -v '/OutputData/Misc/Duration/@Time')" ]; then
+	echo "SameRun $1 $2 -: PASSED"
+    else
+	echo "SameRun $1 $2 -: FAILED, the run differs from the run without $2"
+	exit 1
+    fi
+
+#Cleanup
+    rm -Rf tmp.xml.bz2 plain.xml.bz2 test.xml.bz2 plain.out.xml.bz2 \
+	test.out.xml.bz2 config.out.xml.bz2 output.xml.bz2 run.log
+}
+
+function RDFTest {
+    #The radial distribution function is sampled using the neighbour
+    #list if it reaches far enough, otherwise with a grid of cells
+    #(periodic boundaries) or by testing every pair. The histogram
+    #must not depend on the method or the number of threads. $1 are
+    #the dynamod options.
+    > run.log
+
+    ./dynamod $1 -s 1 -o tmp.xml.bz2 &> run.log
+    for threads in 1 3; do
+	for length in 14 default; do
+	    plugin="RadialDistribution"
+	    if [ $length != "default" ]; then plugin="$plugin:length=$length"; fi
+	    ./dynarun -c 20000 -s 3 -t 0.1 -N $threads -L $plugin tmp.xml.bz2 \
+		--out-data-file rdf.$threads.$length.out.xml.bz2 >> run.log 2>&1
+	    bzcat rdf.$threads.$length.out.xml.bz2 \
+		| sed -n '/<RadialDistribution/,/<\/RadialDistribution>/p' > rdf.$threads.$length
+	done
+    done
+
+    #The short histogram (up to the range of the neighbour list) must
+    #match the start of the full one
+    if [ ! -s rdf.1.14 ] || [ ! -s rdf.1.default ] || \
+	! diff rdf.1.14 rdf.3.14 > /dev/null || \
+	! diff rdf.1.default rdf.3.default > /dev/null || \
+	! diff <(sed -n 3,15p rdf.1.14) <(sed -n 3,15p rdf.1.default) > /dev/null; then
+	echo "RDF $1 -: FAILED, the histograms differ"
+	exit 1
+    fi
+    echo "RDF $1 -: PASSED"
+
+#Cleanup
+    rm -Rf tmp.xml.bz2 rdf.* config.out.xml.bz2 output.xml.bz2 run.log
+}
+
+function TrajectoryTest {
+    #The Trajectory plugin writes an event log, which dynatrajectory
+    #converts to text. The log must not depend on the compression of
+    #its chunks, and must hold a record of every event the Misc
+    #plugin counts. $1 are the dynamod options.
+    > run.log
+
+    ./dynamod $1 -s 1 -o tmp.xml.bz2 &> run.log
+    for compression in None Zlib BZip2; do
+	./dynarun -c 5000 -s 3 -L Trajectory:Compression=$compression,ChunkSize=300 \
+	    tmp.xml.bz2 --out-data-file output.xml.bz2 >> run.log 2>&1
+	./dynatrajectory trajectory.dyntraj > traj.$compression 2>> run.log
+    done
+
+    if [ "$(head -n 1 traj.None)" != "# event time source sourceID type p1 p2 deltaPx deltaPy deltaPz deltaKE deltaU" ] || \
+	! diff traj.None traj.Zlib > /dev/null || \
+	! diff traj.None traj.BZip2 > /dev/null; then
+	echo "Trajectory $1 -: FAILED, the event logs differ or could not be read"
+	exit 1
+    fi
+
+    #Misc counts each particle of an event, the log has one record
+    #per event and particle (or pair of particles)
+    for type in Interaction Local; do
+	counted=$(bzcat output.xml.bz2 \
+	    | $Xml sel -t -v "/OutputData/Misc/EventCounters/Entry[@Type=\"$type\"]/@Count" \
+	    | gawk '{sum += $1} END {print sum + 0}')
+	logged=$(gawk -v type=$(echo $type | tr 'a-z' 'A-Z') \
+	    'NR > 1 && $3 == type {sum += ($7 == "-") ? 1 : 2} END {print sum + 0}' traj.None)
+	if [ $counted != $logged ]; then
+	    echo "Trajectory $1 -: FAILED, Misc counted $counted $type events, the log has $logged"
+	    exit 1
+	fi
+    done
+    echo "Trajectory $1 -: PASSED"
+
+#Cleanup
+    rm -Rf tmp.xml.bz2 traj.* trajectory.dyntraj config.out.xml.bz2 output.xml.bz2 run.log
+}
+
+function OutputBufferTest {
+    #The output plugins which process their events in batches must
+    #give the same output whether the events are buffered, passed on
+    #as they occur, or processed on their own thread. $1 are the
+    #dynamod options.
+    > run.log
+
+    ./dynamod $1 -s 1 -o tmp.xml.bz2 &> run.log
+    for mode in "--output-buffer 0" "--output-buffer 7" "--output-thread"; do
+	name=$(echo $mode | tr -dc 'a-z0-9')
+	./dynarun -c 20000 -s 3 $mode -L CollisionMatrix -L CollDistCheck \
+	    tmp.xml.bz2 -o $name.xml.bz2 --out-data-file $name.out.xml.bz2 >> run.log 2>&1
+    done
+
+    for name in outputbuffer7 outputthread; do
+	if [ ! -e outputbuffer0.out.xml.bz2 ] || [ ! -e $name.out.xml.bz2 ] || \
+	    ! diff <(bzcat outputbuffer0.out.xml.bz2 | grep -v "Timing\|Memusage") \
+	    <(bzcat $name.out.xml.bz2 | grep -v "Timing\|Memusage") > /dev/null; then
+	    echo "OutputBuffer $1 -: FAILED, the output of $name differs from the unbuffered run"
+	    exit 1
+	fi
+    done
+    echo "OutputBuffer $1 -: PASSED"
+
+#Cleanup
+    rm -Rf tmp.xml.bz2 outputbuffer0.* outputbuffer7.* outputthread.* \
+	config.out.xml.bz2 output.xml.bz2 run.log
+}
+
+function ProfileTest {
+    #A run with the event loop profiler must finish and write out the
+    #profile of its passes. $1 are the dynamod options.
+    > run.log
+
+    ./dynamod $1 -s 1 -o tmp.xml.bz2 &> run.log
+    ./dynarun -c 20000 -s 3 -L Profile tmp.xml.bz2 \
+	--out-data-file profile.out.xml.bz2 >> run.log 2>&1
+
+    if [ -e profile.out.xml.bz2 ] && \
+	[ "$(bzcat profile.out.xml.bz2 | $Xml sel -t -v '/OutputData/Profile/@Passes')" -gt 0 ]; then
+	echo "Profile $1 -: PASSED"
+    else
+	echo "Profile $1 -: FAILED, no profile was written"
+	exit 1
+    fi
+
+#Cleanup
+    rm -Rf tmp.xml.bz2 profile.out.xml.bz2 config.out.xml.bz2 output.xml.bz2 run.log
+}
+
+function TriangleMeshTest {
+    #A square of two triangles, which wraps around the periodic
+    #boundary, is added to hard spheres. The triangles are found
+    #using the bounding volume hierarchy, and a mesh loaded from an
+    #STL file (wrappedsquare.stl) must give exactly the same run as
+    #the same mesh written in the configuration.
+    > run.log
+
+    ./dynamod -m 0 -C 4 -d 0.3 -s 1 -o tmp.xml.bz2 &> run.log
+    mesh='<Local Type="TriangleMesh" Name="Mesh" Elasticity="1" Diameter="1"'
+    bzcat tmp.xml.bz2 | sed -e "s|<Locals/>|<Locals>$mesh><IDRange Type=\"All\"/><Vertices>2 -2 0 6 -2 0 6 2 0 2 2 0</Vertices><Elements>0 1 2 0 2 3</Elements></Local></Locals>|" \
+	| bzip2 > xmlmesh.xml.bz2
+    bzcat tmp.xml.bz2 | sed -e "s|<Locals/>|<Locals>$mesh STLFile=\"wrappedsquare.stl\"><IDRange Type=\"All\"/></Local></Locals>|" \
+	| bzip2 > stlmesh.xml.bz2
+
+    for name in xmlmesh stlmesh; do
+	./dynarun -c 20000 -s 3 $name.xml.bz2 -o $name.end.xml.bz2 \
+	    --out-data-file $name.out.xml.bz2 >> run.log 2>&1
+    done
+
+    if [ -e xmlmesh.end.xml.bz2 ] && [ -e stlmesh.end.xml.bz2 ] && \
+	[ -n "$(bzcat xmlmesh.out.xml.bz2 | grep 'Name="Mesh" Event="WALL"')" ] && \
+	diff <(bzcat xmlmesh.end.xml.bz2 | sed -n '/<ParticleData/,$p') \
+	<(bzcat stlmesh.end.xml.bz2 | sed -n '/<ParticleData/,$p') > /dev/null; then
+	echo "TriangleMesh -: PASSED"
+    else
+	echo "TriangleMesh -: FAILED, the STL mesh run differs or the mesh had no events"
+	exit 1
+    fi
+
+#Cleanup
+    rm -Rf tmp.xml.bz2 xmlmesh.* stlmesh.* config.out.xml.bz2 output.xml.bz2 run.log
+}
+
+function LocalSortTest {
+    #The cells sort the Locals so a particle only tests the Locals
+    #it can reach. Turning the sorting off (SortLocals="0") must give
+    #the same run. The Local events may then be predicted at other
+    #times, so the positions are only compared to within rounding
+    #errors, before they are amplified by the chaotic dynamics. $1
+    #are the dynamod options, $2 is a sed script applied to the
+    #configuration (e.g., to add Locals) and $3 is the number of
+    #events to run (default 1500).
+    > run.log
+
+    ./dynamod $1 -s 1 -o tmp.xml.bz2 &> run.log
+    bzcat tmp.xml.bz2 | sed -e "$2" | bzip2 > sorted.xml.bz2
+    bzcat sorted.xml.bz2 \
+	| sed -e 's|<Global Type="Cells" Name="SchedulerNBList"|& SortLocals="0"|' \
+	| bzip2 > unsorted.xml.bz2
+
+    for name in sorted unsorted; do
+	./dynarun -c ${3:-1500} -s 3 $name.xml.bz2 -o $name.end.xml.bz2 \
+	    --out-data-file $name.out.xml.bz2 >> run.log 2>&1
+	bzcat $name.end.xml.bz2 | grep -o '<P [^/]*' | tr -d 'Pxyz="<' > $name.pos
+	bzcat $name.out.xml.bz2 | grep 'Type="Local"' > $name.events
+    done
+
+    if [ -s sorted.pos ] && [ -s sorted.events ] && \
+	diff sorted.events unsorted.events > /dev/null && \
+	[ $(paste -d ' ' sorted.pos unsorted.pos \
+	| gawk '{for (i = 1; i <= 3; ++i) { d = $i - $(i+3); if ((d > 1e-9) || (d < -1e-9)) bad = 1 } } END { print bad + 0 }') == "0" ]; then
+	echo "LocalSort $1 -: PASSED"
+    else
+	echo "LocalSort $1 -: FAILED, the run differs when the Locals are not sorted into the cells"
+	exit 1
+    fi
+
+#Cleanup
+    rm -Rf tmp.xml.bz2 sorted.* unsorted.* config.out.xml.bz2 output.xml.bz2 run.log
+}
+
+function OscillatingPlateTest {
+    #A collision with a finite mass plate changes the plate events of
+    #every particle. The old events must be removed from the sorter,
+    #so every sorter which keeps all events must give exactly the same
+    #run. $1 are the dynamod options.
+    > run.log
+
+    ./dynamod $1 -s 1 -o tmp.xml.bz2 &> run.log
+    for sorter in BoundedPQ CBT CalendarQueue; do
+	bzcat tmp.xml.bz2 | sed -e "s|<Sorter Type=\"[A-Za-z0-9]*\"/>|<Sorter Type=\"$sorter\"/>|" \
+	    | bzip2 > $sorter.xml.bz2
+	./dynarun -c 400 -s 3 $sorter.xml.bz2 -o $sorter.end.xml.bz2 \
+	    --out-data-file $sorter.out.xml.bz2 >> run.log 2>&1
+    done
+
+    for sorter in CBT CalendarQueue; do
+	if [ ! -e BoundedPQ.end.xml.bz2 ] || [ ! -e $sorter.end.xml.bz2 ] || \
+	    ! diff <(bzcat BoundedPQ.end.xml.bz2 | grep -v "<Sorter") \
+	    <(bzcat $sorter.end.xml.bz2 | grep -v "<Sorter") > /dev/null; then
+	    echo "OscillatingPlate $1 -: FAILED, the $sorter run differs from the BoundedPQ run"
+	    exit 1
+	fi
+    done
+    echo "OscillatingPlate $1 -: PASSED"
+
+#Cleanup
+    rm -Rf tmp.xml.bz2 BoundedPQ.* CBT.* CalendarQueue.* config.out.xml.bz2 \
+	output.xml.bz2 run.log
+}
+
+function RescaleTest {
+    #Inelastic hard spheres cool down, and are periodically rescaled
+    #back to kT=1 by the velocity rescaler. The events are rescaled
+    #in the sorter, not recalculated.
+    > run.log
+
+    ./dynamod -m 0 --f1 0.9 --i2 2000 -s 1 -o tmp.xml.bz2 &> run.log
+    ./dynarun -c 30000 tmp.xml.bz2 >> run.log 2>&1
+
+    if [ -e output.xml.bz2 ]; then
+	if [ $(bzcat output.xml.bz2 \
+	    | $Xml sel -t -v '/OutputData/Misc/Temperature/@Max' \
+	    | gawk '{printf "%.3f",$1}') != "1.000" ]; then
+	    echo "Rescale -: FAILED"
+	    exit 1
+	else
+	    echo "Rescale -: PASSED"
+	fi
+    else
+	echo "Error, no output.xml.bz2 in Rescale test"
+	exit 1
+    fi
+
+#Cleanup
+    rm -Rf config.out.xml.bz2 output.xml.bz2 tmp.xml.bz2 run.log
+}
+
 function ThermostatTest {
     #Testing the Andersen thermostat holds the right temperature
     > run.log
@@ -723,6 +1090,35 @@ echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neigh
 cannon "NeighbourList" "CBT"
 echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neighbour lists + scheduler, globals, boundedPQ"
 cannon "NeighbourList" "BoundedPQ"
+echo "Testing basic system, zero + infinite time events, hard spheres, PBC, Dumb Scheduler, calendar queue"
+cannon "Dumb" "CalendarQueue"
+echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neighbour lists + scheduler, globals, calendar queue"
+cannon "NeighbourList" "CalendarQueue"
+echo "Testing basic system, zero + infinite time events, hard spheres, PBC, Dumb Scheduler, CBT, eager invalidation"
+cannon "Dumb" "CBT" "Eager"
+echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neighbour lists + scheduler, globals, boundedPQ, eager invalidation"
+cannon "NeighbourList" "BoundedPQ" "Eager"
+echo "Testing the parallel event prediction (--parallel-prediction) of stepped potentials against the serial prediction"
+SameRunTest "-m 16" "-N 3 --parallel-prediction"
+#dynamod cannot generate Lennard-Jones fluids, so the stepped
+#potential is swapped for one. Its steps are then calculated as the
+#particles reach them, possibly by several threads at once.
+LJ_from_stepped='s|<Potential Type="Stepped" Direction="Left">|<Potential Type="LennardJones" Sigma="1" Epsilon="1" CutOff="2.3" AttractiveSteps="2" UMode="Midpoint" RMode="DeltaU">|;/<Step /d;/<CaptureMap/,/<\/CaptureMap>/d'
+echo "Testing the parallel event prediction of a Lennard-Jones fluid"
+SameRunTest "-m 16" "-N 3 --parallel-prediction" "$LJ_from_stepped"
+SameRunTest "-m 16" "-N 3" "$LJ_from_stepped"
+echo "Testing the buffered and threaded output plugin updates of square wells"
+OutputBufferTest "-m 1 -C 7 -d 0.5"
+echo "Testing the event loop profiler on square wells"
+ProfileTest "-m 1 -C 7 -d 0.5"
+SameRunTest "-m 1 -C 7 -d 0.5" "-L Profile"
+echo "Testing the radial distribution function of square wells (neighbour list and grid sampling)"
+RDFTest "-m 1 -C 7 -d 0.5"
+echo "Testing the radial distribution function of a sheared system (sampling every pair)"
+RDFTest "-m 4 -C 7 -d 0.5"
+echo "Testing the event log of the Trajectory plugin, and its conversion to text by dynatrajectory"
+TrajectoryTest "-m 0 -C 4 -d 0.3"
+TrajectoryTest "-m 6"
 
 echo ""
 echo "INTERACTIONS+Dynamod Systems"
@@ -758,6 +1154,8 @@ echo ""
 echo "SYSTEM EVENTS"
 echo "Testing the Andersen Thermostat, NeighbourLists and BoundedPQ's"
 ThermostatTest
+echo "Testing the velocity rescaler, which rescales the event times in the sorter"
+RescaleTest
 #echo "Testing the square umbrella potential, NeighbourLists and BoundedPQ's"
 #umbrella "NeighbourList"
 
@@ -767,6 +1165,41 @@ echo "Testing local events (walls) and square wells"
 wallsw "NeighbourList"
 echo "Testing thermalised and normal walls in gravity with binary granulate implemented using properties"
 BinaryThermalisedGranulate
+echo "Testing a triangle mesh under periodic boundaries, loaded from the configuration and an STL file"
+TriangleMeshTest
+#Locals added to hard spheres in a box of width 9.48 (-m 0 -C 4 -d 0.3)
+add_cylinder='s|<Locals/>|<Locals><Local Type="Cylinder" Name="Cylinder" Elasticity="1" ParticleDiameter="1" CylinderRadius="1.35"><IDRange Type="All"/><Axis x="0" y="0" z="1"/><Origin x="0" y="0" z="0"/></Local></Locals>|'
+add_mesh='s|<Locals/>|<Locals><Local Type="TriangleMesh" Name="Mesh" Elasticity="1" Diameter="1"><IDRange Type="All"/><Vertices>2 -2 0 6 -2 0 6 2 0 2 2 0</Vertices><Elements>0 1 2 0 2 3</Elements></Local></Locals>|'
+echo "Testing the sorting of Locals into the cells with walls, a cylinder and a triangle mesh"
+LocalSortTest "-m 6" ""
+LocalSortTest "-m 0 -C 4 -d 0.3" "$add_cylinder"
+LocalSortTest "-m 0 -C 4 -d 0.3" "$add_mesh"
+echo "Testing the sorting of Locals into the cells, for particles which escape more than a box width along the non-periodic x axis"
+LocalSortTest "-m 6" '/<Local Type="Wall" Name="HighWall"/,/<\/Local>/d' 20000
+echo "Testing an oscillating plate, whose collisions update the plate events of every particle"
+OscillatingPlateTest "-m 19 -C 1"
+
+echo ""
+echo "CONFIGURATION FILES"
+echo "Testing binary configurations of polymers"
+BinaryConfigTest "-m 2 --i1 50"
+echo "Testing binary configurations of polydisperse spheres with per-particle properties"
+BinaryConfigTest "-m 26"
+echo "Testing binary configurations with orientation data"
+BinaryConfigTest "-m 9"
+echo "Testing a restart from a checkpoint of square wells"
+CheckpointTest "-m 1 -C 7 -d 0.5"
+echo "Testing a restart from a checkpoint of a sheared system (Lees-Edwards BC's)"
+CheckpointTest "-m 4 -C 7 -d 0.5"
+echo "Testing a restart from a checkpoint of spheres piling onto a plate (dense cells overflow into the sparse store)"
+#A cell overflows after around 32000 events
+CheckpointTest "-m 22" 50000 40000
+echo "Testing a restart from a checkpoint of sleeping particles in a funnel"
+CheckpointTest "-m 25 --f3 0.2"
+echo "Testing a restart from a checkpoint of inelastic spheres with a velocity rescaler"
+CheckpointTest "-m 0 --f1 0.9 --i2 2000"
+echo "Testing the Morton-order renumbering of square wells"
+SameRunTest "-m 1 -C 7 -d 0.5" "--renumber"
 
 echo ""
 echo "ENGINE TESTING"
@@ -788,3 +1221,5 @@ echo "Testing replica exchange of hard spheres"
 HS_replex_test "NeighbourList"
 echo "Testing replica exchange of hard spheres with 3 threads"
 HS_replex_test "NeighbourList" "-N3"
+echo "Testing asynchronous replica exchange of hard spheres with 3 threads"
+HS_replex_test "NeighbourList" "-N3 --replex-async"